@@ -169,6 +169,8 @@ static ulong opt_compatible_mode= 0;
 static uint opt_mysql_port= 0, opt_master_data;
 static uint opt_slave_data;
 static uint opt_use_gtid;
+static uint opt_parallel= 0;
+static ulonglong opt_chunk_rows= 0;
 static uint my_end_arg;
 static char * opt_mysql_unix_port=0;
 static int   first_error=0;
@@ -184,6 +186,27 @@ static MYSQL_RES *get_table_name_result= NULL;
 static MEM_ROOT glob_root;
 static MYSQL_RES *routine_res, *routine_list_res;
 
+/*
+  A SELECT ... INTO OUTFILE of --tab that is waiting for a dump worker.
+  The strings are allocated together with the job.
+*/
+typedef struct st_dump_job
+{
+  struct st_dump_job *next;
+  char *db, *table, *query;
+} DUMP_JOB;
+
+/* Dump workers of --parallel, each with its own connection */
+static uint dump_worker_count= 0;
+static MYSQL *dump_worker_connections;
+static pthread_t *dump_worker_threads;
+static pthread_mutex_t dump_job_lock;
+static pthread_cond_t dump_job_cond, dump_job_done;
+static DUMP_JOB *dump_job_first, **dump_job_last= &dump_job_first;
+static uint dump_jobs_running;
+static int dump_worker_error;
+static my_bool dump_workers_exit;
+
 
 #include <sslopt-vars.h>
 FILE *md_result_file= 0;
@@ -286,6 +309,13 @@ static struct my_option my_long_options[] =
   {"character-sets-dir", OPT_CHARSETS_DIR,
    "Directory for character set files.", (char **)&charsets_dir,
    (char **)&charsets_dir, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"chunk-rows", 0,
+   "With --tab, split tables that have a single column integer primary key "
+   "into parts of this many rows, in primary key order. Each part is "
+   "written to its own file table@N.txt. Load them with mysqlimport "
+   "--chunked-files. 0 means no splitting.",
+   &opt_chunk_rows, &opt_chunk_rows, 0, GET_ULL, REQUIRED_ARG, 0, 0,
+   ULONGLONG_MAX, 0, 0, 0},
   {"comments", 'i', "Write additional information.",
    &opt_comments, &opt_comments, 0, GET_BOOL, NO_ARG,
    1, 0, 0, 0, 0, 0},
@@ -510,6 +540,13 @@ static struct my_option my_long_options[] =
    "Dump tables in the order of their size, smaller first. Useful when using --single-transaction on tables which get truncated often. "
    "Dumping smaller tables first reduces chances of often truncated tables to get altered before being dumped.",
     &opt_order_by_size, &opt_order_by_size, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"parallel", OPT_USE_THREADS,
+   "With --tab, dump the data of this many tables (or table ranges of "
+   "--chunk-rows) at the same time, each over its own connection. With "
+   "--single-transaction all connections start their transaction under "
+   "FLUSH TABLES WITH READ LOCK, so they see the same data.",
+   &opt_parallel, &opt_parallel, 0, GET_UINT, REQUIRED_ARG, 0, 0, 256, 0, 0,
+   0},
   {"password", 'p',
    "Password to use when connecting to server. If password is not given it's solicited on the tty.",
    0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
@@ -636,6 +673,11 @@ static int dump_all_timezones();
 static char *quote_name(const char *name, char *buff, my_bool force);
 char check_if_ignore_table(const char *table_name, char *table_type);
 static char *primary_key_fields(const char *table_name);
+static void end_dump_workers();
+static char *chunk_key_field(const char *table_name, char *buff);
+static void add_dump_job(const char *db, const char *table,
+                         DYNAMIC_STRING *query);
+static void wait_for_dump_jobs();
 static my_bool get_view_structure(char *table, char* db);
 static my_bool dump_all_views_in_db(char *database);
 static int dump_all_tablespaces();
@@ -1291,6 +1333,13 @@ static int get_options(int *argc, char ***argv)
             "%s: You must use option --tab with --fields-...\n", my_progname_short);
     return(EX_USAGE);
   }
+  if (!path && (opt_parallel > 1 || opt_chunk_rows))
+  {
+    fprintf(stderr,
+            "%s: You must use option --tab with --parallel or --chunk-rows\n",
+            my_progname_short);
+    return(EX_USAGE);
+  }
 
   /* We don't delete master logs if slave data option */
   if (opt_slave_data)
@@ -1927,6 +1976,7 @@ static void free_resources()
     mysql_free_result(routine_res);
   if (routine_list_res)
     mysql_free_result(routine_list_res);
+  end_dump_workers();
   if (mysql)
   {
     mysql_close(mysql);
@@ -1968,70 +2018,60 @@ static void maybe_exit(int error)
 
 
 /*
-  db_connect -- connects to the host and selects DB.
+  Open a connection with the options of the command line, as used by
+  the main connection and the dump workers of --parallel.
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+static int connect_to_server(MYSQL *con, char *host, char *user,
+                             char *passwd)
 {
   char buff[20+FN_REFLEN];
   my_bool reconnect;
-  DBUG_ENTER("connect_to_db");
 
-  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
-    mysql_options(&mysql_connection, MARIADB_OPT_TLS_VERSION, opt_tls_version);
+    mysql_options(con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(con, MARIADB_OPT_TLS_VERSION, opt_tls_version);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+    mysql_options(con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+  mysql_options(con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
-  if (!mysql_real_connect(&mysql_connection,host,user,passwd,
+  if (!mysql_real_connect(con,host,user,passwd,
                           NULL,opt_mysql_port,opt_mysql_unix_port, 0))
   {
-    DB_error(&mysql_connection, "when trying to connect");
-    DBUG_RETURN(1);
+    DB_error(con, "when trying to connect");
+    return 1;
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
-      (opt_compatible_mode & 3))
-  {
-    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
-    opt_set_charset= 0;
-
-    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
-    server_supports_switching_charsets= FALSE;
-  } 
   /*
     As we're going to set SQL_MODE, it would be lost on reconnect, so we
     cannot reconnect.
   */
   reconnect= 0;
-  mysql_options(&mysql_connection, MYSQL_OPT_RECONNECT, &reconnect);
+  mysql_options(con, MYSQL_OPT_RECONNECT, &reconnect);
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
-    DBUG_RETURN(1);
+  if (mysql_query_with_error_report(con, 0, buff))
+    return 1;
   /*
     set time_zone to UTC to allow dumping date types between servers with
     different time zone settings
@@ -2039,9 +2079,34 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      return 1;
   }
+  return 0;
+}
+
+
+/*
+  db_connect -- connects to the host and selects DB.
+*/
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  DBUG_ENTER("connect_to_db");
+
+  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
+  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
+  if (connect_to_server(&mysql_connection, host, user, passwd))
+    DBUG_RETURN(1);
+  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
+      (opt_compatible_mode & 3))
+  {
+    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
+    opt_set_charset= 0;
+
+    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
+    server_supports_switching_charsets= FALSE;
+  } 
   DBUG_RETURN(0);
 } /* connect_to_db */
 
@@ -4043,6 +4108,203 @@ static void vers_append_system_time(DYNAMIC_STRING* query_string)
 }
 
 
+/*
+  Write the rows of a table to <file_name>.txt in the --tab directory
+  "dir" with SELECT ... INTO OUTFILE. "range" is an optional condition
+  on the rows to write, added to the one of --where. The query is run
+  by a dump worker if --parallel is used.
+*/
+
+static void dump_table_to_file(const char *db, const char *table,
+                               const char *file_name, const char *dir,
+                               const char *result_table, my_bool versioned,
+                               const char *range)
+{
+  char filename[FN_REFLEN];
+  DYNAMIC_STRING query_string;
+
+  fn_format(filename, file_name, dir, ".txt", MYF(MY_UNPACK_FILENAME));
+
+  /* Must delete the file that 'INTO OUTFILE' will write to */
+  my_delete(filename, MYF(0));
+
+  /* convert to a unix path name to stick into the query */
+  to_unix_path(filename);
+
+  /* now build the query string */
+  init_dynamic_string_checked(&query_string, "", 1024, 1024);
+
+  dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
+  dynstr_append_checked(&query_string, select_field_names.str);
+  dynstr_append_checked(&query_string, " INTO OUTFILE '");
+  dynstr_append_checked(&query_string, filename);
+  dynstr_append_checked(&query_string, "'");
+
+  dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
+  dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
+                                       my_charset_bin.coll_name.str : /* backward compatibility */
+                                       default_charset);
+  dynstr_append_checked(&query_string, " */");
+
+  if (fields_terminated || enclosed || opt_enclosed || escaped)
+    dynstr_append_checked(&query_string, " FIELDS");
+
+  add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
+  add_load_option(&query_string, " ENCLOSED BY ", enclosed);
+  add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+  add_load_option(&query_string, " ESCAPED BY ", escaped);
+  add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
+
+  dynstr_append_checked(&query_string, " FROM ");
+  dynstr_append_checked(&query_string, result_table);
+  if (versioned)
+    vers_append_system_time(&query_string);
+
+  if (where && range)
+  {
+    dynstr_append_checked(&query_string, " WHERE (");
+    dynstr_append_checked(&query_string, where);
+    dynstr_append_checked(&query_string, ") AND ");
+    dynstr_append_checked(&query_string, range);
+  }
+  else if (where || range)
+  {
+    dynstr_append_checked(&query_string, " WHERE ");
+    dynstr_append_checked(&query_string, where ? where : range);
+  }
+
+  if (order_by)
+  {
+    dynstr_append_checked(&query_string, " ORDER BY ");
+    dynstr_append_checked(&query_string, order_by);
+  }
+
+  add_dump_job(db, result_table, &query_string);
+  dynstr_free(&query_string);
+}
+
+
+/*
+  Dump a table for --tab --chunk-rows: the rows are split by their
+  primary key into parts of opt_chunk_rows rows, and each part is
+  written to its own file <table>@<n>.txt.
+
+  The last key value of a part is found by skipping opt_chunk_rows rows
+  of the primary key after the end of the previous part. This is done on
+  the main connection, so with --single-transaction the parts are
+  computed on the same snapshot as the one that is dumped.
+
+  RETURN
+    0  the table was dumped
+    1  the table can't be split (no single column integer primary key,
+       or not more rows than opt_chunk_rows). Nothing was written.
+*/
+
+static my_bool dump_table_chunks(const char *db, const char *table,
+                                 const char *result_table, const char *dir,
+                                 my_bool versioned)
+{
+  char key_buff[NAME_LEN*2+3], buff[FN_REFLEN+100];
+  char range[NAME_LEN*4+6+100], last[22], *key;
+  DYNAMIC_STRING query_string;
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  ulonglong chunk;
+  my_bool more_rows;
+  DBUG_ENTER("dump_table_chunks");
+
+  if (!(key= chunk_key_field(result_table, key_buff)))
+    DBUG_RETURN(1);
+
+  last[0]= 0;
+  for (chunk= 0;; chunk++)
+  {
+    /*
+      Fetch the last key of this part and the one after it. If there is
+      no next key, this part ends the table.
+    */
+    init_dynamic_string_checked(&query_string, "SELECT ", 256, 256);
+    dynstr_append_checked(&query_string, key);
+    dynstr_append_checked(&query_string, " FROM ");
+    dynstr_append_checked(&query_string, result_table);
+    if (versioned)
+      vers_append_system_time(&query_string);
+    if (where || last[0])
+    {
+      dynstr_append_checked(&query_string, " WHERE ");
+      if (where)
+      {
+        dynstr_append_checked(&query_string, "(");
+        dynstr_append_checked(&query_string, where);
+        dynstr_append_checked(&query_string, ")");
+      }
+      if (where && last[0])
+        dynstr_append_checked(&query_string, " AND ");
+      if (last[0])
+      {
+        dynstr_append_checked(&query_string, key);
+        dynstr_append_checked(&query_string, " > ");
+        dynstr_append_checked(&query_string, last);
+      }
+    }
+    dynstr_append_checked(&query_string, " ORDER BY ");
+    dynstr_append_checked(&query_string, key);
+    my_snprintf(buff, sizeof(buff), " LIMIT %llu, 2", opt_chunk_rows - 1);
+    dynstr_append_checked(&query_string, buff);
+    if (mysql_query_with_error_report(mysql, &res, query_string.str))
+    {
+      dynstr_free(&query_string);
+      DBUG_RETURN(1);
+    }
+    dynstr_free(&query_string);
+
+    field= mysql_fetch_field(res);
+    switch (field->type) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      break;
+    default:
+      mysql_free_result(res);
+      DBUG_RETURN(1);
+    }
+    row= mysql_fetch_row(res);
+    more_rows= row && mysql_fetch_row(res) != NULL;
+    if (chunk == 0)
+    {
+      if (!more_rows)
+      {
+        /* Not more rows than opt_chunk_rows */
+        mysql_free_result(res);
+        DBUG_RETURN(1);
+      }
+      /* A restore must not load an old unsplit dump of the table as well */
+      fn_format(buff, table, dir, ".txt", MYF(MY_UNPACK_FILENAME));
+      my_delete(buff, MYF(0));
+      my_snprintf(range, sizeof(range), "%s <= %s", key, row[0]);
+    }
+    else if (more_rows)
+      my_snprintf(range, sizeof(range), "%s > %s AND %s <= %s", key, last,
+                  key, row[0]);
+    else
+      my_snprintf(range, sizeof(range), "%s > %s", key, last);
+    if (more_rows)
+      strmake(last, row[0], sizeof(last) - 1);
+    mysql_free_result(res);
+
+    my_snprintf(buff, sizeof(buff), "%s@%llu", table, chunk);
+    dump_table_to_file(db, table, buff, dir, result_table, versioned, range);
+    if (!more_rows)
+      break;
+  }
+  verbose_msg("-- Dumped table %s in %llu parts\n", result_table, chunk + 1);
+  DBUG_RETURN(0);
+}
+
+
 /*
 
  SYNOPSIS
@@ -4147,7 +4409,7 @@ static void dump_table(const char *table, const char *db, const uchar *hash_key,
 
   if (path)
   {
-    char filename[FN_REFLEN], tmp_path[FN_REFLEN];
+    char tmp_path[FN_REFLEN];
 
     /*
       Convert the path to native os format
@@ -4155,62 +4417,13 @@ static void dump_table(const char *table, const char *db, const uchar *hash_key,
     */
     convert_dirname(tmp_path,path,NullS);    
     my_load_path(tmp_path, tmp_path, NULL);
-    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
 
-    /* Must delete the file that 'INTO OUTFILE' will write to */
-    my_delete(filename, MYF(0));
-
-    /* convert to a unix path name to stick into the query */
-    to_unix_path(filename);
-
-    /* now build the query string */
-
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
-    dynstr_append_checked(&query_string, select_field_names.str);
-    dynstr_append_checked(&query_string, " INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
-
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.coll_name.str : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
-
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
-    
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
-
-    dynstr_append_checked(&query_string, " FROM ");
-    dynstr_append_checked(&query_string, result_table);
-    if (versioned)
-      vers_append_system_time(&query_string);
-
-    if (where)
-    {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
-    }
-
-    if (order_by)
-    {
-      dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-      my_free(order_by);
-      order_by= 0;
-    }
-
-    if (mysql_real_query(mysql, query_string.str, (ulong)query_string.length))
-    {
-      dynstr_free(&query_string);
-      DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
-      DBUG_VOID_RETURN;
-    }
+    if (!opt_chunk_rows ||
+        dump_table_chunks(db, table, result_table, tmp_path, versioned))
+      dump_table_to_file(db, table, table, tmp_path, result_table, versioned,
+                         NULL);
+    my_free(order_by);
+    order_by= 0;
   }
   else
   {
@@ -5712,6 +5925,8 @@ static int dump_all_tables_in_db(char *database)
         transaction_registry_table_exists= 1;
     }
   }
+  /* The tables must be dumped before they are unlocked */
+  wait_for_dump_jobs();
 
   if (opt_single_transaction && mysql_get_server_version(mysql) >= 50500)
   {
@@ -6091,6 +6306,8 @@ static int dump_selected_tables(char *db, char **table_names, int tables)
       }
     }
   }
+  /* The tables must be dumped before they are unlocked */
+  wait_for_dump_jobs();
 
   if (opt_single_transaction && mysql_get_server_version(mysql) >= 50500)
   {
@@ -6490,6 +6707,233 @@ static int start_transaction(MYSQL *mysql_con)
 }
 
 
+/*
+  Dump worker of --parallel: runs the SELECT ... INTO OUTFILE queries of
+  --tab that the main thread queues with add_dump_job().
+*/
+
+pthread_handler_t dump_worker(void *arg)
+{
+  MYSQL *con= (MYSQL*) arg;
+  char current_db[NAME_LEN+1];
+  current_db[0]= 0;
+
+  if (mysql_thread_init())
+    return 0;
+
+  pthread_mutex_lock(&dump_job_lock);
+  for (;;)
+  {
+    DUMP_JOB *job;
+    uint err_no= 0;
+    char err_msg[MYSQL_ERRMSG_SIZE];
+
+    while (!(job= dump_job_first) && !dump_workers_exit)
+      pthread_cond_wait(&dump_job_cond, &dump_job_lock);
+    if (dump_workers_exit)
+      break;
+    if (!(dump_job_first= job->next))
+      dump_job_last= &dump_job_first;
+    dump_jobs_running++;
+    pthread_mutex_unlock(&dump_job_lock);
+
+    if ((strcmp(current_db, job->db) && mysql_select_db(con, job->db)) ||
+        mysql_real_query(con, job->query, (ulong) strlen(job->query)))
+    {
+      err_no= mysql_errno(con);
+      strmake(err_msg, mysql_error(con), sizeof(err_msg) - 1);
+    }
+    else
+    {
+      strmake(current_db, job->db, NAME_LEN);
+      /* Release the metadata lock, as the main connection does */
+      if (opt_single_transaction &&
+          mysql_get_server_version(con) >= 50500 &&
+          mysql_query(con, "ROLLBACK TO SAVEPOINT sp"))
+      {
+        err_no= mysql_errno(con);
+        strmake(err_msg, mysql_error(con), sizeof(err_msg) - 1);
+      }
+    }
+
+    pthread_mutex_lock(&dump_job_lock);
+    if (err_no)
+    {
+      fprintf(stderr, "%s: Got error: %u: \"%s\" when executing "
+              "'SELECT INTO OUTFILE' for table %s\n",
+              my_progname_short, err_no, err_msg, job->table);
+      fflush(stderr);
+      if (!dump_worker_error)
+        dump_worker_error= EX_MYSQLERR;
+    }
+    dump_jobs_running--;
+    pthread_cond_signal(&dump_job_done);
+    my_free(job);
+  }
+  pthread_mutex_unlock(&dump_job_lock);
+  mysql_thread_end();
+  return 0;
+}
+
+
+/*
+  Open the connections of the dump workers and start the threads.
+
+  With --single-transaction this must be called while the main
+  connection holds FLUSH TABLES WITH READ LOCK, so that the transactions
+  of all connections see the same data.
+*/
+
+static int start_dump_workers()
+{
+  uint i;
+  verbose_msg("-- Starting %u dump workers...\n", opt_parallel);
+
+  pthread_mutex_init(&dump_job_lock, NULL);
+  pthread_cond_init(&dump_job_cond, NULL);
+  pthread_cond_init(&dump_job_done, NULL);
+  dump_workers_exit= 0;
+  if (!(dump_worker_connections= (MYSQL*)
+        my_malloc(PSI_NOT_INSTRUMENTED, opt_parallel * sizeof(MYSQL),
+                  MYF(MY_WME | MY_ZEROFILL))) ||
+      !(dump_worker_threads= (pthread_t*)
+        my_malloc(PSI_NOT_INSTRUMENTED, opt_parallel * sizeof(pthread_t),
+                  MYF(MY_WME))))
+    die(EX_EOM, "Couldn't allocate memory");
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    MYSQL *con= &dump_worker_connections[dump_worker_count];
+    if (connect_to_server(con, current_host, current_user, opt_password) ||
+        (opt_single_transaction &&
+         (start_transaction(con) ||
+          (mysql_get_server_version(con) >= 50500 &&
+           mysql_query_with_error_report(con, 0, "SAVEPOINT sp")))))
+    {
+      mysql_close(con);
+      return 1;
+    }
+    if (pthread_create(&dump_worker_threads[dump_worker_count], NULL,
+                       dump_worker, con))
+    {
+      mysql_close(con);
+      die(EX_MYSQLERR, "Couldn't create a dump worker thread");
+    }
+    dump_worker_count++;
+  }
+  return 0;
+}
+
+
+/*
+  Queue a SELECT ... INTO OUTFILE for the dump workers, or run it on
+  the main connection if there are none.
+*/
+
+static void add_dump_job(const char *db, const char *table,
+                         DYNAMIC_STRING *query)
+{
+  DUMP_JOB *job;
+  size_t db_length= strlen(db) + 1, table_length= strlen(table) + 1;
+
+  if (!dump_worker_count)
+  {
+    if (mysql_real_query(mysql, query->str, (ulong)query->length))
+      DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
+    return;
+  }
+
+  pthread_mutex_lock(&dump_job_lock);
+  if (dump_worker_error && !ignore_errors)
+  {
+    /* Don't queue more work, report the error and exit */
+    pthread_mutex_unlock(&dump_job_lock);
+    wait_for_dump_jobs();
+    return;
+  }
+  pthread_mutex_unlock(&dump_job_lock);
+
+  if (!(job= (DUMP_JOB*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                   sizeof(DUMP_JOB) + db_length +
+                                   table_length + query->length + 1,
+                                   MYF(MY_WME))))
+    die(EX_EOM, "Couldn't allocate memory");
+  job->next= 0;
+  job->db= (char*) (job + 1);
+  job->table= strmov(job->db, db) + 1;
+  job->query= strmov(job->table, table) + 1;
+  memcpy(job->query, query->str, query->length + 1);
+
+  pthread_mutex_lock(&dump_job_lock);
+  *dump_job_last= job;
+  dump_job_last= &job->next;
+  pthread_cond_signal(&dump_job_cond);
+  pthread_mutex_unlock(&dump_job_lock);
+}
+
+
+/*
+  Wait until the dump workers have run all queued jobs and report the
+  first error that any of them got.
+*/
+
+static void wait_for_dump_jobs()
+{
+  int error;
+  if (!dump_worker_count)
+    return;
+
+  pthread_mutex_lock(&dump_job_lock);
+  while (dump_job_first || dump_jobs_running)
+    pthread_cond_wait(&dump_job_done, &dump_job_lock);
+  error= dump_worker_error;
+  dump_worker_error= 0;
+  pthread_mutex_unlock(&dump_job_lock);
+  if (error)
+    maybe_exit(error);
+}
+
+
+/*
+  Stop the dump workers. Jobs that were not started yet are dropped.
+*/
+
+static void end_dump_workers()
+{
+  uint i;
+  if (!dump_worker_connections)
+    return;
+
+  if (dump_worker_count)
+  {
+    pthread_mutex_lock(&dump_job_lock);
+    dump_workers_exit= 1;
+    pthread_cond_broadcast(&dump_job_cond);
+    pthread_mutex_unlock(&dump_job_lock);
+  }
+  for (i= 0; i < dump_worker_count; i++)
+  {
+    pthread_join(dump_worker_threads[i], NULL);
+    mysql_close(&dump_worker_connections[i]);
+  }
+  while (dump_job_first)
+  {
+    DUMP_JOB *job= dump_job_first;
+    dump_job_first= job->next;
+    my_free(job);
+  }
+  dump_job_last= &dump_job_first;
+  dump_worker_count= 0;
+  pthread_mutex_destroy(&dump_job_lock);
+  pthread_cond_destroy(&dump_job_cond);
+  pthread_cond_destroy(&dump_job_done);
+  my_free(dump_worker_threads);
+  my_free(dump_worker_connections);
+  dump_worker_threads= 0;
+  dump_worker_connections= 0;
+}
+
+
 static ulong find_set(TYPELIB *lib, const char *x, size_t length,
                       char **err_pos, uint *err_len)
 {
@@ -6743,6 +7187,45 @@ static char *primary_key_fields(const char *table_name)
 }
 
 
+/*
+  Get the column of the primary key of a table for --chunk-rows.
+
+  RETURN
+    The quoted column name, stored in buff, or NULL if the table has no
+    primary key or it has more than one column.
+*/
+
+static char *chunk_key_field(const char *table_name, char *buff)
+{
+  MYSQL_RES  *res;
+  MYSQL_ROW  row;
+  /* SHOW KEYS FROM + table name * 2 (escaped) + 2 quotes + \0 */
+  char show_keys_buff[15 + NAME_LEN * 2 + 3];
+  char *result= 0;
+
+  my_snprintf(show_keys_buff, sizeof(show_keys_buff),
+              "SHOW KEYS FROM %s", table_name);
+  if (mysql_query(mysql, show_keys_buff) ||
+      !(res= mysql_store_result(mysql)))
+  {
+    fprintf(stderr, "Warning: Couldn't read keys from table %s;"
+            " the table is NOT split into chunks (%s)\n",
+            table_name, mysql_error(mysql));
+    return 0;
+  }
+
+  /* A PRIMARY key is always the first row of SHOW KEYS */
+  if ((row= mysql_fetch_row(res)) && !strcmp(row[2], "PRIMARY"))
+  {
+    const char *field= row[4];
+    if (!(row= mysql_fetch_row(res)) || strcmp(row[2], "PRIMARY"))
+      result= quote_name(field, buff, 1);
+  }
+  mysql_free_result(res);
+  return result;
+}
+
+
 /*
   Replace a substring
 
@@ -7089,8 +7572,12 @@ int main(int argc, char **argv)
     consistent_binlog_pos= check_consistent_binlog_pos(NULL, NULL);
   }
 
+  /*
+    The transactions of the dump workers must start while no table can be
+    changed, to see the same data as the main connection.
+  */
   if ((opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && (flush_logs || opt_parallel > 1))) &&
       do_flush_tables_read_lock(mysql))
     goto err;
 
@@ -7122,6 +7609,9 @@ int main(int argc, char **argv)
   if (opt_single_transaction && start_transaction(mysql))
     goto err;
 
+  if (opt_parallel > 1 && start_dump_workers())
+    goto err;
+
   /* Add 'STOP SLAVE to beginning of dump */
   if (opt_slave_apply && add_stop_slave())
     goto err;
@@ -7178,6 +7668,7 @@ int main(int argc, char **argv)
       dump_databases(argv);
     }
   }
+  end_dump_workers();
 
   if (opt_system & OPT_SYSTEM_PLUGINS)
     dump_all_plugins();
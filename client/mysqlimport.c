@@ -50,7 +50,7 @@ static char *add_load_option(char *ptr,const char *object,
 			     const char *statement);
 
 static my_bool	verbose=0,lock_tables=0,ignore_errors=0,opt_delete=0,
-                replace, silent, ignore, ignore_foreign_keys,
+                replace, silent, ignore, ignore_foreign_keys, opt_chunked_files,
                 opt_compress, opt_low_priority, tty_password;
 static my_bool debug_info_flag= 0, debug_check_flag= 0;
 static uint opt_use_threads=0, opt_local_file=0, my_end_arg= 0;
@@ -78,6 +78,12 @@ static struct my_option my_long_options[] =
   {"default-character-set", OPT_DEFAULT_CHARSET,
    "Set the default character set.", &default_charset,
    &default_charset, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"chunked-files", 0,
+   "Files named table@N.txt are parts of one table, as written by mysqldump "
+   "--chunk-rows, and are loaded into table, unless a table named table@N "
+   "exists. Use --use-threads to load them in parallel.",
+   &opt_chunked_files, &opt_chunked_files, 0, GET_BOOL, NO_ARG, 0, 0, 0,
+   0, 0, 0},
   {"columns", 'c',
    "Use only these columns to import the data to. Give the column names in a comma separated list. This is same as giving columns to LOAD DATA INFILE.",
    &opt_columns, &opt_columns, 0, GET_STR, REQUIRED_ARG, 0, 0, 0,
@@ -350,6 +356,11 @@ static int get_options(int *argc, char ***argv)
     fprintf(stderr, "You can't use --ignore (-i) and --replace (-r) at the same time.\n");
     return(1);
   }
+  if (opt_chunked_files && (opt_delete || lock_tables))
+  {
+    fprintf(stderr, "You can't use --chunked-files with --delete or --lock-tables.\n");
+    return(1);
+  }
   if (*argc < 2)
   {
     usage();
@@ -364,6 +375,61 @@ static int get_options(int *argc, char ***argv)
 
 
 
+/*
+  Check if a table exists in the current database. Errors are taken as
+  the table not existing.
+*/
+
+static my_bool table_exists(MYSQL *mysql, const char *table)
+{
+  char escaped_name[FN_REFLEN * 2 + 1], query[FN_REFLEN * 2 + 128];
+  MYSQL_RES *res;
+  my_bool found;
+
+  mysql_real_escape_string(mysql, escaped_name, table,
+                           (unsigned long) strlen(table));
+  sprintf(query, "SELECT 1 FROM information_schema.tables "
+          "WHERE table_schema=DATABASE() AND table_name='%s'", escaped_name);
+  if (mysql_query(mysql, query) || !(res= mysql_store_result(mysql)))
+    return 0;
+  found= mysql_num_rows(res) != 0;
+  mysql_free_result(res);
+  return found;
+}
+
+
+/*
+  Get the table name from the name of a data file: the path and the
+  extension are removed. With --chunked-files a "@<number>" suffix of a
+  .txt file is removed as well, as mysqldump --chunk-rows writes the
+  parts of a table to such files. Table names can contain "@", so the
+  suffix is kept if a table with the full name exists, or if there is no
+  table without the suffix.
+*/
+
+static void table_name_from_file(MYSQL *mysql, char *tablename,
+                                 const char *filename)
+{
+  fn_format(tablename, filename, "", "", 1 | 2); /* removes path & ext. */
+  if (opt_chunked_files && !strcmp(fn_ext(filename), ".txt"))
+  {
+    char *pos= strrchr(tablename, '@');
+    if (pos && pos[1] && pos > tablename)
+    {
+      char *end= pos + 1;
+      while (my_isdigit(&my_charset_latin1, *end))
+        end++;
+      if (!*end && !table_exists(mysql, tablename))
+      {
+        *pos= 0;
+        if (!table_exists(mysql, tablename))
+          *pos= '@';
+      }
+    }
+  }
+}
+
+
 static int write_to_table(char *filename, MYSQL *mysql)
 {
   char tablename[FN_REFLEN], hard_path[FN_REFLEN],
@@ -372,7 +438,7 @@ static int write_to_table(char *filename, MYSQL *mysql)
   DBUG_ENTER("write_to_table");
   DBUG_PRINT("enter",("filename: %s",filename));
 
-  fn_format(tablename, filename, "", "", 1 | 2); /* removes path & ext. */
+  table_name_from_file(mysql, tablename, filename);
   if (!opt_local_file)
     strmov(hard_path,filename);
   else
@@ -3,6 +3,7 @@
 #
 # ZSTD_INCLUDE_DIRS - where to find zstd.h, etc.
 # ZSTD_LIBRARIES - List of libraries when using zstd.
+# ZSTD_VERSION_STRING - version from zstd.h.
 # ZSTD_FOUND - True if zstd found.
 
 find_path(ZSTD_INCLUDE_DIRS
@@ -13,8 +14,18 @@ find_library(ZSTD_LIBRARIES
   NAMES zstd
   HINTS ${ZSTD_ROOT_DIR}/lib)
 
+if(ZSTD_INCLUDE_DIRS AND EXISTS "${ZSTD_INCLUDE_DIRS}/zstd.h")
+  file(STRINGS "${ZSTD_INCLUDE_DIRS}/zstd.h" ZSTD_H
+    REGEX "^#define ZSTD_VERSION_(MAJOR|MINOR|RELEASE) ")
+  string(REGEX REPLACE "ZSTD_VERSION" "" ZSTD_H "${ZSTD_H}")
+  string(REGEX MATCHALL "[0-9]+" ZSTD_H "${ZSTD_H}")
+  string(REGEX REPLACE ";" "." ZSTD_VERSION_STRING "${ZSTD_H}")
+endif()
+
 include(FindPackageHandleStandardArgs)
-find_package_handle_standard_args(ZSTD DEFAULT_MSG ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
+find_package_handle_standard_args(ZSTD
+  REQUIRED_VARS ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS
+  VERSION_VAR ZSTD_VERSION_STRING)
 
 mark_as_advanced(
   ZSTD_LIBRARIES
@@ -806,7 +806,7 @@ bool
 datafile_copy_backup(const char *filepath, uint thread_n)
 {
 	const char *ext_list[] = {"frm", "isl", "MYD", "MYI", "MAD", "MAI",
-		"MRG", "TRG", "TRN", "ARM", "ARZ", "CSM", "CSV", "opt", "par",
+		"MRG", "TRG", "TRN", "ARM", "ARZ", "ARG", "CSM", "CSV", "opt", "par",
 		NULL};
 
 	/* Get the name and the path for the tablespace. node->name always
@@ -839,7 +839,7 @@ bool
 datafile_rsync_backup(const char *filepath, bool save_to_list, FILE *f)
 {
 	const char *ext_list[] = {"frm", "isl", "MYD", "MYI", "MAD", "MAI",
-		"MRG", "TRG", "TRN", "ARM", "ARZ", "CSM", "CSV", "opt", "par",
+		"MRG", "TRG", "TRN", "ARM", "ARZ", "ARG", "CSM", "CSV", "opt", "par",
 		NULL};
 
 	/* Get the name and the path for the tablespace. node->name always
@@ -1587,7 +1587,7 @@ bool
 ibx_copy_incremental_over_full()
 {
 	const char *ext_list[] = {"frm", "isl", "MYD", "MYI", "MAD", "MAI",
-		"MRG", "TRG", "TRN", "ARM", "ARZ", "CSM", "CSV", "opt", "par",
+		"MRG", "TRG", "TRN", "ARM", "ARZ", "ARG", "CSM", "CSV", "opt", "par",
 		NULL};
 	const char *sup_files[] = {"xtrabackup_binlog_info",
 				   "xtrabackup_galera_info",
@@ -1746,6 +1746,38 @@ apply_log_finish()
 }
 
 
+/** Extensions of compressed files, and the commands that decompress
+them from the standard input to the standard output */
+static const char *const decompress_commands[][2] = {
+	{".qp", " | qpress -dio "},
+	{".lz4", " | lz4 -dc "},
+	{".zst", " | zstd -dc "}
+};
+
+/** @return the decompress_commands entry for a file, or NULL */
+static const char *const *decompress_command(const char *filepath)
+{
+	for (const auto &c : decompress_commands) {
+		if (ends_with(filepath, c[0])) {
+			return c;
+		}
+	}
+	return NULL;
+}
+
+/** @return whether a .lz4 or .zst file is the compressed copy of a
+file that --decompress wrote next to it */
+static bool is_compressed_copy(const char *filepath)
+{
+	const char *const *decompress = decompress_command(filepath);
+	if (!decompress || !strcmp(decompress[0], ".qp")) {
+		return false;
+	}
+	std::string path(filepath,
+			 strlen(filepath) - strlen(decompress[0]));
+	return file_exists(path.c_str());
+}
+
 bool
 copy_back()
 {
@@ -1932,8 +1964,10 @@ copy_back()
 
 		filename = base_name(node.filepath);
 
-		/* skip .qp files */
-		if (filename_matches(filename, ext_list)) {
+		/* skip .qp files, and .lz4 and .zst files that
+		were decompressed */
+		if (filename_matches(filename, ext_list)
+		    || is_compressed_copy(node.filepath)) {
 			continue;
 		}
 
@@ -2009,13 +2043,13 @@ decrypt_decompress_file(const char *filepath, uint thread_n)
 	std::stringstream cmd, message;
 	char *dest_filepath = strdup(filepath);
 	bool needs_action = false;
+	const char *const *decompress = decompress_command(filepath);
 
 	cmd << IF_WIN("type ","cat ") << filepath;
 
- 	if (opt_decompress
- 	    && ends_with(filepath, ".qp")) {
- 		cmd << " | qpress -dio ";
- 		dest_filepath[strlen(dest_filepath) - 3] = 0;
+ 	if (opt_decompress && decompress) {
+ 		cmd << decompress[1];
+ 		dest_filepath[strlen(dest_filepath) - strlen(decompress[0])] = 0;
  		if (needs_action) {
  			message << " and ";
  		}
@@ -2061,7 +2095,7 @@ static void decrypt_decompress_thread_func(datadir_thread_ctxt_t *ctxt)
 			continue;
 		}
 
-		if (!ends_with(node.filepath, ".qp")) {
+		if (!decompress_command(node.filepath)) {
 			continue;
 		}
 
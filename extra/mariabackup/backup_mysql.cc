@@ -551,8 +551,9 @@ bool
 detect_mysql_capabilities_for_backup()
 {
 	const char *query = "SELECT 'INNODB_CHANGED_PAGES', COUNT(*) FROM "
-				"INFORMATION_SCHEMA.PLUGINS "
-			    "WHERE PLUGIN_NAME LIKE 'INNODB_CHANGED_PAGES'";
+			    "INFORMATION_SCHEMA.GLOBAL_VARIABLES "
+			    "WHERE VARIABLE_NAME='INNODB_TRACK_CHANGED_PAGES' "
+			    "AND VARIABLE_VALUE='ON'";
 	char *innodb_changed_pages = NULL;
 	mysql_variable vars[] = {
 		{"INNODB_CHANGED_PAGES", &innodb_changed_pages}, {NULL, NULL}};
@@ -565,16 +566,6 @@ detect_mysql_capabilities_for_backup()
 
 		have_changed_page_bitmaps = (atoi(innodb_changed_pages) == 1);
 
-		/* INNODB_CHANGED_PAGES are listed in
-		INFORMATION_SCHEMA.PLUGINS in MariaDB, but
-		FLUSH NO_WRITE_TO_BINLOG CHANGED_PAGE_BITMAPS
-		is not supported for versions below 10.1.6
-		(see MDEV-7472) */
-		if (server_flavor == FLAVOR_MARIADB &&
-		    mysql_server_version < 100106) {
-			have_changed_page_bitmaps = false;
-		}
-
 		free_mysql_variables(vars);
 	}
 
@@ -2067,7 +2058,8 @@ flush_changed_page_bitmaps()
 	if (xtrabackup_incremental && have_changed_page_bitmaps &&
 	    !xtrabackup_incremental_force_scan) {
 		xb_mysql_query(mysql_connection,
-			"FLUSH NO_WRITE_TO_BINLOG CHANGED_PAGE_BITMAPS", false);
+			"SET GLOBAL innodb_flush_changed_page_bitmaps=ON",
+			false);
 	}
 	return(true);
 }
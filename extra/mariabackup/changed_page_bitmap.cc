@@ -27,11 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 #include "common.h"
 #include "xtrabackup.h"
 #include "srv0srv.h"
-
-/* TODO: copy-pasted shared definitions from the XtraDB bitmap write code.
-Remove these on the first opportunity, i.e. single-binary XtraBackup.  */
-
-/* log0online.h */
+#include "log0online.h"
 
 /** Single bitmap file information */
 struct log_online_bitmap_file_t {
@@ -55,58 +51,6 @@ struct log_online_bitmap_file_range_t {
 	}	*files;
 };
 
-/* log0online.c */
-
-/** File name stem for bitmap files. */
-static const char* bmp_file_name_stem = "ib_modified_log_";
-
-/** The bitmap file block size in bytes.  All writes will be multiples of this.
- */
-enum {
-	MODIFIED_PAGE_BLOCK_SIZE = 4096
-};
-
-/** Offsets in a file bitmap block */
-enum {
-	MODIFIED_PAGE_IS_LAST_BLOCK = 0,/* 1 if last block in the current
-					write, 0 otherwise. */
-	MODIFIED_PAGE_START_LSN = 4,	/* The starting tracked LSN of this and
-					other blocks in the same write */
-	MODIFIED_PAGE_END_LSN = 12,	/* The ending tracked LSN of this and
-					other blocks in the same write */
-	MODIFIED_PAGE_SPACE_ID = 20,	/* The space ID of tracked pages in
-					this block */
-	MODIFIED_PAGE_1ST_PAGE_ID = 24,	/* The page ID of the first tracked
-					page in this block */
-	MODIFIED_PAGE_BLOCK_UNUSED_1 = 28,/* Unused in order to align the start
-					  of bitmap at 8 byte boundary */
-	MODIFIED_PAGE_BLOCK_BITMAP = 32,/* Start of the bitmap itself */
-	MODIFIED_PAGE_BLOCK_UNUSED_2 = MODIFIED_PAGE_BLOCK_SIZE - 8,
-					/* Unused in order to align the end of
-					bitmap at 8 byte boundary */
-	MODIFIED_PAGE_BLOCK_CHECKSUM = MODIFIED_PAGE_BLOCK_SIZE - 4
-					/* The checksum of the current block */
-};
-
-/** Length of the bitmap data in a block */
-enum { MODIFIED_PAGE_BLOCK_BITMAP_LEN
-       = MODIFIED_PAGE_BLOCK_UNUSED_2 - MODIFIED_PAGE_BLOCK_BITMAP };
-
-/** Length of the bitmap data in a block in page ids */
-enum { MODIFIED_PAGE_BLOCK_ID_COUNT = MODIFIED_PAGE_BLOCK_BITMAP_LEN * 8 };
-
-typedef ib_uint64_t	bitmap_word_t;
-
-/****************************************************************//**
-Calculate a bitmap block checksum.  Algorithm borrowed from
-log_block_calc_checksum.
-@return checksum */
-UNIV_INLINE
-ulint
-log_online_calc_checksum(
-/*=====================*/
-	const byte*	block);	/*!<in: bitmap block */
-
 /****************************************************************//**
 Provide a comparisson function for the RB-tree tree (space,
 block_start_page) pairs.  Actual implementation does not matter as
@@ -137,39 +81,6 @@ log_online_compare_bmp_keys(
 	return k1_space < k2_space ? -1 : 1;
 }
 
-/****************************************************************//**
-Calculate a bitmap block checksum.  Algorithm borrowed from
-log_block_calc_checksum.
-@return checksum */
-UNIV_INLINE
-ulint
-log_online_calc_checksum(
-/*=====================*/
-	const byte*	block)	/*!<in: bitmap block */
-{
-	ulint	sum;
-	ulint	sh;
-	ulint	i;
-
-	sum = 1;
-	sh = 0;
-
-	for (i = 0; i < MODIFIED_PAGE_BLOCK_CHECKSUM; i++) {
-
-		ulint	b = block[i];
-		sum &= 0x7FFFFFFFUL;
-		sum += b;
-		sum += b << sh;
-		sh++;
-		if (sh > 24) {
-
-			sh = 0;
-		}
-	}
-
-	return sum;
-}
-
 /****************************************************************//**
 Read one bitmap data page and check it for corruption.
 
@@ -510,8 +421,6 @@ log_online_diagnose_bitmap_eof(
 	return TRUE;
 }
 
-/* End of copy-pasted definitions */
-
 /** Iterator structure over changed page bitmap */
 struct xb_page_bitmap_range_struct {
 	const xb_page_bitmap	*bitmap;	/* Bitmap with data */
@@ -602,6 +511,7 @@ xb_page_bitmap_init(void)
 	const lsn_t bmp_end_lsn{log_sys.next_checkpoint_lsn};
 	byte				page[MODIFIED_PAGE_BLOCK_SIZE];
 	lsn_t				current_page_end_lsn;
+	lsn_t				current_page_start_lsn;
 	xb_page_bitmap			*result;
 	ibool				last_page_in_run= FALSE;
 	log_online_bitmap_file_range_t	bitmap_files;
@@ -616,8 +526,10 @@ xb_page_bitmap_init(void)
 		return NULL;
 	}
 
+	/* The run that covers bmp_end_lsn may be in a file that was
+	started after bmp_end_lsn, so do not limit the range of files. */
 	if (!log_online_setup_bitmap_file_range(&bitmap_files, bmp_start_lsn,
-						bmp_end_lsn)) {
+						LSN_MAX)) {
 
 		return NULL;
 	}
@@ -703,6 +615,8 @@ xb_page_bitmap_init(void)
 		return NULL;
 	}
 
+	current_page_start_lsn
+		= mach_read_from_8(page + MODIFIED_PAGE_START_LSN);
 	last_page_in_run
 		= mach_read_from_4(page + MODIFIED_PAGE_IS_LAST_BLOCK);
 
@@ -727,11 +641,12 @@ xb_page_bitmap_init(void)
 	/* 1st bitmap page found, add it to the tree.  */
 	rbt_insert(result, page, page);
 
-	/* Read next pages/files until all required data is read */
+	/* Read next pages/files until all required data is read, that is,
+	until the end of a run that was written after a checkpoint at or
+	after bmp_end_lsn (see log0online.h) */
 	while (last_page_ok
-	       && (current_page_end_lsn < bmp_end_lsn
-		   || (current_page_end_lsn == bmp_end_lsn
-		       && !last_page_in_run))) {
+	       && (current_page_start_lsn < bmp_end_lsn
+		   || !last_page_in_run)) {
 
 		ib_rbt_bound_t	tree_search_pos;
 
@@ -777,6 +692,19 @@ xb_page_bitmap_init(void)
 				return NULL;
 			}
 
+			/* Was the tracking interrupted, for example by
+			a server crash or a write error? */
+			if (UNIV_UNLIKELY(bitmap_files.files[bmp_i].start_lsn
+					  > current_page_end_lsn)) {
+
+				xb_msg_missing_lsn_data(
+					current_page_end_lsn,
+					bitmap_files.files[bmp_i].start_lsn);
+				rbt_free(result);
+				free(bitmap_files.files);
+				return NULL;
+			}
+
 			if (UNIV_UNLIKELY(
 				    !log_online_open_bitmap_file_read_only(
 					    bitmap_files.files[bmp_i].name,
@@ -833,6 +761,8 @@ xb_page_bitmap_init(void)
 			rbt_add_node(result, &tree_search_pos, page);
 		}
 
+		current_page_start_lsn
+			= mach_read_from_8(page + MODIFIED_PAGE_START_LSN);
 		current_page_end_lsn
 			= mach_read_from_8(page + MODIFIED_PAGE_END_LSN);
 		last_page_in_run
@@ -104,6 +104,20 @@ ds_write(ds_file_t *file, const void *buf, size_t len)
 	return file->datasink->write(file, (const uchar *)buf, len);
 }
 
+/************************************************************************
+Write to a datasink file at the specified offset. Several threads may
+write to different parts of the same file.
+@return 0 on success, 1 on error. */
+int
+ds_pwrite(ds_file_t *file, const void *buf, size_t len, my_off_t offset)
+{
+	if (len == 0) {
+		return 0;
+	}
+	xb_ad(file->datasink->pwrite != NULL);
+	return file->datasink->pwrite(file, (const uchar *)buf, len, offset);
+}
+
 /************************************************************************
 Close a datasink file.
 @return 0 on success, 1, on error. */
@@ -52,6 +52,10 @@ struct datasink_struct {
 	int (*close)(ds_file_t *file);
 	int (*remove)(const char *path);
 	void (*deinit)(ds_ctxt_t *ctxt);
+	/* Write at a file offset, concurrently with other pwrite() calls
+	on the same file; NULL if the datasink can only append. */
+	int (*pwrite)(ds_file_t *file, const unsigned char *buf, size_t len,
+		      my_off_t offset);
 };
 
 
@@ -84,6 +88,18 @@ Write to a datasink file.
 @return 0 on success, 1 on error. */
 int ds_write(ds_file_t *file, const void *buf, size_t len);
 
+/************************************************************************
+Write to a datasink file at the specified offset. Several threads may
+write to different parts of the same file.
+@return 0 on success, 1 on error. */
+int ds_pwrite(ds_file_t *file, const void *buf, size_t len, my_off_t offset);
+
+/************************************************************************
+@return whether ds_pwrite() is supported by a datasink */
+static inline my_bool ds_supports_pwrite(const ds_ctxt_t *ctxt) {
+	return ctxt->datasink->pwrite != NULL;
+}
+
 /************************************************************************
 Close a datasink file.
 @return 0 on success, 1, on error. */
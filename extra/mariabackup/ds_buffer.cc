@@ -55,7 +55,8 @@ datasink_t datasink_buffer = {
 	&buffer_write,
 	&buffer_close,
 	&dummy_remove,
-	&buffer_deinit
+	&buffer_deinit,
+	NULL
 };
 
 /* Change the default buffer size */
@@ -23,12 +23,29 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 #include <my_base.h>
 #include <quicklz.h>
 #include <zlib.h>
+#ifdef HAVE_LZ4
+#include <lz4frame.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "common.h"
 #include "datasink.h"
+#include "ds_compress.h"
 
 #define COMPRESS_CHUNK_SIZE ((size_t) (xtrabackup_compress_chunk_size))
 #define MY_QLZ_COMPRESS_OVERHEAD 400
 
+/* Compression level of --compress=zstd */
+#define XB_ZSTD_LEVEL 1
+
+/* Compression algorithms */
+typedef enum {
+	COMPRESS_QUICKLZ,
+	COMPRESS_LZ4,
+	COMPRESS_ZSTD
+} compress_alg_t;
+
 typedef struct {
 	pthread_t		id;
 	uint			num;
@@ -45,11 +62,16 @@ typedef struct {
 	size_t			to_len;
 	qlz_state_compress	state;
 	ulong			adler;
+	compress_alg_t		alg;
+#ifdef HAVE_ZSTD
+	ZSTD_CCtx		*zstd;
+#endif
 } comp_thread_ctxt_t;
 
 typedef struct {
 	comp_thread_ctxt_t	*threads;
 	uint			nthreads;
+	compress_alg_t		alg;
 } ds_compress_ctxt_t;
 
 typedef struct {
@@ -76,16 +98,111 @@ datasink_t datasink_compress = {
 	&compress_write,
 	&compress_close,
 	&dummy_remove,
-	&compress_deinit
+	&compress_deinit,
+	NULL
 };
 
 static inline int write_uint32_le(ds_file_t *file, ulong n);
 static inline int write_uint64_le(ds_file_t *file, ulonglong n);
 
-static comp_thread_ctxt_t *create_worker_threads(uint n);
+static comp_thread_ctxt_t *create_worker_threads(uint n, compress_alg_t alg);
 static void destroy_worker_threads(comp_thread_ctxt_t *threads, uint n);
 static void *compress_worker_thread_func(void *arg);
 
+/************************************************************************
+Look up a --compress algorithm.
+@return whether the algorithm was found */
+static
+my_bool
+compress_alg_lookup(const char *name, compress_alg_t *alg)
+{
+	if (!strcasecmp(name, "quicklz")) {
+		*alg = COMPRESS_QUICKLZ;
+		return TRUE;
+	}
+#ifdef HAVE_LZ4
+	if (!strcasecmp(name, "lz4")) {
+		*alg = COMPRESS_LZ4;
+		return TRUE;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (!strcasecmp(name, "zstd")) {
+		*alg = COMPRESS_ZSTD;
+		return TRUE;
+	}
+#endif
+	return FALSE;
+}
+
+/************************************************************************
+Check whether a --compress algorithm is supported by this build. */
+my_bool
+ds_compress_alg_supported(const char *name)
+{
+	compress_alg_t	alg;
+
+	return compress_alg_lookup(name, &alg);
+}
+
+/************************************************************************
+@return the file name extension of the compressed files */
+const char *
+ds_compress_extension(const char *name)
+{
+	compress_alg_t	alg;
+
+	if (!name || !compress_alg_lookup(name, &alg)) {
+		return ".qp";
+	}
+
+	switch (alg) {
+	case COMPRESS_LZ4:
+		return ".lz4";
+	case COMPRESS_ZSTD:
+		return ".zst";
+	default:
+		return ".qp";
+	}
+}
+
+#ifdef HAVE_LZ4
+/************************************************************************
+Initialize the lz4 frame preferences: default compression level, with
+a checksum of the chunk. */
+static
+void
+lz4_prefs_init(LZ4F_preferences_t *prefs)
+{
+	memset(prefs, 0, sizeof *prefs);
+	prefs->frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+}
+#endif
+
+/************************************************************************
+@return the maximum size of a compressed chunk */
+static
+size_t
+compress_bound(compress_alg_t alg)
+{
+	switch (alg) {
+#ifdef HAVE_LZ4
+	case COMPRESS_LZ4:
+	{
+		LZ4F_preferences_t prefs;
+		lz4_prefs_init(&prefs);
+		return LZ4F_compressFrameBound(COMPRESS_CHUNK_SIZE, &prefs);
+	}
+#endif
+#ifdef HAVE_ZSTD
+	case COMPRESS_ZSTD:
+		return ZSTD_compressBound(COMPRESS_CHUNK_SIZE);
+#endif
+	default:
+		return COMPRESS_CHUNK_SIZE + MY_QLZ_COMPRESS_OVERHEAD;
+	}
+}
+
 static
 ds_ctxt_t *
 compress_init(const char *root)
@@ -93,9 +210,16 @@ compress_init(const char *root)
 	ds_ctxt_t		*ctxt;
 	ds_compress_ctxt_t	*compress_ctxt;
 	comp_thread_ctxt_t	*threads;
+	compress_alg_t		alg;
+
+	if (!compress_alg_lookup(xtrabackup_compress_alg, &alg)) {
+		msg("compress: unsupported algorithm %s.",
+		    xtrabackup_compress_alg);
+		return NULL;
+	}
 
 	/* Create and initialize the worker threads */
-	threads = create_worker_threads(xtrabackup_compress_threads);
+	threads = create_worker_threads(xtrabackup_compress_threads, alg);
 	if (threads == NULL) {
 		msg("compress: failed to create worker threads.");
 		return NULL;
@@ -107,6 +231,7 @@ compress_init(const char *root)
 	compress_ctxt = (ds_compress_ctxt_t *) (ctxt + 1);
 	compress_ctxt->threads = threads;
 	compress_ctxt->nthreads = xtrabackup_compress_threads;
+	compress_ctxt->alg = alg;
 
 	ctxt->ptr = compress_ctxt;
 	ctxt->root = my_strdup(PSI_NOT_INSTRUMENTED, root, MYF(MY_FAE));
@@ -131,14 +256,23 @@ compress_open(ds_ctxt_t *ctxt, const char *path, MY_STAT *mystat)
 
 	comp_ctxt = (ds_compress_ctxt_t *) ctxt->ptr;
 
-	/* Append the .qp extension to the filename */
-	fn_format(new_name, path, "", ".qp", MYF(MY_APPEND_EXT));
+	/* Append the .qp, .lz4 or .zst extension to the filename */
+	fn_format(new_name, path, "",
+		  ds_compress_extension(xtrabackup_compress_alg),
+		  MYF(MY_APPEND_EXT));
 
 	dest_file = ds_open(dest_ctxt, new_name, mystat);
 	if (dest_file == NULL) {
 		return NULL;
 	}
 
+	/* Each lz4 or zstd chunk is a self-contained frame, and a
+	concatenation of frames can be decompressed with lz4 -d or
+	zstd -d, so there are no archive or file headers. */
+	if (comp_ctxt->alg != COMPRESS_QUICKLZ) {
+		goto open_done;
+	}
+
 	/* Write the qpress archive header */
 	if (ds_write(dest_file, "qpress10", 8) ||
 	    write_uint64_le(dest_file, COMPRESS_CHUNK_SIZE)) {
@@ -159,6 +293,7 @@ compress_open(ds_ctxt_t *ctxt, const char *path, MY_STAT *mystat)
 		goto err;
 	}
 
+open_done:
 	file = (ds_file_t *) my_malloc(PSI_NOT_INSTRUMENTED,
                   sizeof(ds_file_t) + sizeof(ds_compress_file_t), MYF(MY_FAE));
 	comp_file = (ds_compress_file_t *) (file + 1);
@@ -237,7 +372,28 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 						  &thd->data_mutex);
 			}
 
-			xb_a(threads[i].to_len > 0);
+			if (threads[i].to_len == 0) {
+				msg("compress: compression failed.");
+				pthread_mutex_unlock(&threads[i].data_mutex);
+				pthread_mutex_unlock(&threads[i].ctrl_mutex);
+				return 1;
+			}
+
+			if (comp_ctxt->alg != COMPRESS_QUICKLZ) {
+				if (ds_write(dest_file, threads[i].to,
+					     threads[i].to_len)) {
+					msg("compress: write to the destination "
+					    "stream failed.");
+					pthread_mutex_unlock(
+						&threads[i].data_mutex);
+					pthread_mutex_unlock(
+						&threads[i].ctrl_mutex);
+					return 1;
+				}
+				comp_file->bytes_processed +=
+					threads[i].from_len;
+				goto reaped;
+			}
 
 			if (ds_write(dest_file, "NEWBNEWB", 8) ||
 			    write_uint64_le(dest_file,
@@ -256,7 +412,7 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 				    "failed.");
 				return 1;
 			}
-
+reaped:
 			pthread_mutex_unlock(&threads[i].data_mutex);
 			pthread_mutex_unlock(&threads[i].ctrl_mutex);
 		}
@@ -265,27 +421,80 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 	return 0;
 }
 
+/************************************************************************
+Write a frame without data, as the compressed copy of an empty file.
+zstd -d fails on an empty input file.
+@return 0 on success, 1 on error */
+static
+int
+write_empty_frame(ds_file_t *dest_file, compress_alg_t alg)
+{
+	size_t	bound = compress_bound(alg);
+	char	*buf;
+	size_t	len = 0;
+	int	rc;
+
+	buf = (char *) my_malloc(PSI_NOT_INSTRUMENTED, bound, MYF(MY_FAE));
+
+	switch (alg) {
+#ifdef HAVE_LZ4
+	case COMPRESS_LZ4:
+	{
+		LZ4F_preferences_t prefs;
+		lz4_prefs_init(&prefs);
+		len = LZ4F_compressFrame(buf, bound, "", 0, &prefs);
+		if (LZ4F_isError(len)) {
+			len = 0;
+		}
+		break;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	case COMPRESS_ZSTD:
+		len = ZSTD_compress(buf, bound, "", 0, XB_ZSTD_LEVEL);
+		if (ZSTD_isError(len)) {
+			len = 0;
+		}
+		break;
+#endif
+	default:
+		break;
+	}
+
+	rc = !len || ds_write(dest_file, buf, len);
+	my_free(buf);
+	return rc;
+}
+
 static
 int
 compress_close(ds_file_t *file)
 {
 	ds_compress_file_t	*comp_file;
 	ds_file_t		*dest_file;
-	int			rc;
+	int			rc = 0;
 
 	comp_file = (ds_compress_file_t *) file->ptr;
 	dest_file = comp_file->dest_file;
 
-	/* Write the qpress file trailer */
-	ds_write(dest_file, "ENDSENDS", 8);
-
-	/* Supposedly the number of written bytes should be written as a
-	"recovery information" in the file trailer, but in reality qpress
-	always writes 8 zeros here. Let's do the same */
-
-	write_uint64_le(dest_file, 0);
+	if (comp_file->comp_ctxt->alg == COMPRESS_QUICKLZ) {
+		/* Write the qpress file trailer */
+		ds_write(dest_file, "ENDSENDS", 8);
+
+		/* Supposedly the number of written bytes should be
+		written as a "recovery information" in the file trailer,
+		but in reality qpress always writes 8 zeros here.
+		Let's do the same */
+
+		write_uint64_le(dest_file, 0);
+	} else if (comp_file->bytes_processed == 0
+		   && write_empty_frame(dest_file,
+					comp_file->comp_ctxt->alg)) {
+		msg("compress: write to the destination stream failed.");
+		rc = 1;
+	}
 
-	rc = ds_close(dest_file);
+	rc |= ds_close(dest_file);
 
 	my_free(file);
 
@@ -330,7 +539,7 @@ write_uint64_le(ds_file_t *file, ulonglong n)
 
 static
 comp_thread_ctxt_t *
-create_worker_threads(uint n)
+create_worker_threads(uint n, compress_alg_t alg)
 {
 	comp_thread_ctxt_t	*threads;
 	uint 			i;
@@ -345,9 +554,25 @@ create_worker_threads(uint n)
 		thd->started = FALSE;
 		thd->cancelled = FALSE;
 		thd->data_avail = FALSE;
+		thd->alg = alg;
 
 		thd->to = (char *) my_malloc(PSI_NOT_INSTRUMENTED,
-                  COMPRESS_CHUNK_SIZE + MY_QLZ_COMPRESS_OVERHEAD, MYF(MY_FAE));
+                  compress_bound(alg), MYF(MY_FAE));
+#ifdef HAVE_ZSTD
+		thd->zstd = NULL;
+		if (alg == COMPRESS_ZSTD) {
+			thd->zstd = ZSTD_createCCtx();
+			if (thd->zstd == NULL
+			    || ZSTD_isError(ZSTD_CCtx_setParameter(
+				    thd->zstd, ZSTD_c_compressionLevel,
+				    XB_ZSTD_LEVEL))
+			    || ZSTD_isError(ZSTD_CCtx_setParameter(
+				    thd->zstd, ZSTD_c_checksumFlag, 1))) {
+				msg("compress: ZSTD_createCCtx() failed.");
+				goto err;
+			}
+		}
+#endif
 
 		/* Initialize the control mutex and condition var */
 		if (pthread_mutex_init(&thd->ctrl_mutex, NULL) ||
@@ -417,6 +642,9 @@ destroy_worker_threads(comp_thread_ctxt_t *threads, uint n)
 		pthread_mutex_destroy(&thd->ctrl_mutex);
 
 		my_free(thd->to);
+#ifdef HAVE_ZSTD
+		ZSTD_freeCCtx(thd->zstd);
+#endif
 	}
 
 	my_free(threads);
@@ -448,6 +676,34 @@ compress_worker_thread_func(void *arg)
 		if (thd->cancelled)
 			break;
 
+		switch (thd->alg) {
+#ifdef HAVE_LZ4
+		case COMPRESS_LZ4:
+		{
+			LZ4F_preferences_t prefs;
+			lz4_prefs_init(&prefs);
+			size_t len = LZ4F_compressFrame(
+				thd->to, compress_bound(COMPRESS_LZ4),
+				thd->from, thd->from_len, &prefs);
+			thd->to_len = LZ4F_isError(len) ? 0 : len;
+			continue;
+		}
+#endif
+#ifdef HAVE_ZSTD
+		case COMPRESS_ZSTD:
+		{
+			size_t len = ZSTD_compress2(
+				thd->zstd, thd->to,
+				compress_bound(COMPRESS_ZSTD),
+				thd->from, thd->from_len);
+			thd->to_len = ZSTD_isError(len) ? 0 : len;
+			continue;
+		}
+#endif
+		default:
+			break;
+		}
+
 		thd->to_len = qlz_compress(thd->from, thd->to, thd->from_len,
 					   &thd->state);
 
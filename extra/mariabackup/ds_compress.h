@@ -25,4 +25,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 
 extern datasink_t datasink_compress;
 
+/************************************************************************
+Check whether a --compress algorithm is supported by this build. */
+my_bool ds_compress_alg_supported(const char *name);
+
+/************************************************************************
+@return the file name extension of the files compressed with
+an algorithm: .qp, .lz4 or .zst */
+const char *ds_compress_extension(const char *name);
+
 #endif
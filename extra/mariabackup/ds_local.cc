@@ -40,6 +40,8 @@ static ds_ctxt_t *local_init(const char *root);
 static ds_file_t *local_open(ds_ctxt_t *ctxt, const char *path,
 			     MY_STAT *mystat);
 static int local_write(ds_file_t *file, const uchar *buf, size_t len);
+static int local_pwrite(ds_file_t *file, const uchar *buf, size_t len,
+			my_off_t offset);
 static int local_close(ds_file_t *file);
 static void local_deinit(ds_ctxt_t *ctxt);
 
@@ -55,7 +57,8 @@ datasink_t datasink_local = {
 	&local_write,
 	&local_close,
 	&local_remove,
-	&local_deinit
+	&local_deinit,
+	&local_pwrite
 };
 }
 
@@ -226,9 +229,64 @@ local_write(ds_file_t *file, const uchar *buf, size_t len)
 	return 1;
 }
 
-/* Set EOF at file's current position.*/
+/* Write data at a file offset, and punch "holes" if needed. Unlike
+write_compressed(), the last page is always written in full, so that
+the file size will be right no matter in which order the ranges of
+a file are written. */
+static int pwrite_compressed(File fd, const uchar *data, size_t len,
+			     my_off_t offset, size_t pagesize)
+{
+	for (size_t written= 0; written < len;)
+	{
+		size_t n_bytes = MY_MIN(pagesize, len - written);
+		size_t datasize = written + n_bytes == len
+			? n_bytes
+			: trim_binary_zeros(const_cast<uchar*>(data), n_bytes);
+		if (datasize > 0
+		    && my_pwrite(fd, data, datasize, offset + written,
+				 MYF(MY_WME | MY_NABP))) {
+			return 1;
+		}
+		written += n_bytes;
+		data += n_bytes;
+	}
+	return 0;
+}
+
+static
+int
+local_pwrite(ds_file_t *file, const uchar *buf, size_t len, my_off_t offset)
+{
+	ds_local_file_t *local_file= (ds_local_file_t *)file->ptr;
+	File fd = local_file->fd;
+
+	/* Pages are written in full until the first page was seen.
+	mariabackup writes the range that starts at page 0 first. */
+	if (local_file->is_ibd && !local_file->init_ibd_done && !offset) {
+		init_ibd_data(local_file, buf, len);
+		local_file->init_ibd_done= 1;
+	}
+
+	if (local_file->compressed) {
+		return pwrite_compressed(fd, buf, len, offset,
+					 local_file->pagesize);
+	}
+
+	if (my_pwrite(fd, buf, len, offset, MYF(MY_WME | MY_NABP))) {
+		return 1;
+	}
+	posix_fadvise(fd, offset, len, POSIX_FADV_DONTNEED);
+	return 0;
+}
+
+/* Set EOF at file's current position, unless local_pwrite() already
+extended the file beyond it. */
 static int set_eof(File fd)
 {
+	my_off_t pos = my_tell(fd, MYF(MY_WME));
+	MY_STAT stat;
+	if (!my_fstat(fd, &stat, MYF(MY_WME)) && my_off_t(stat.st_size) >= pos)
+		return 0;
 #ifdef _WIN32
 	return !SetEndOfFile(my_get_osfhandle(fd));
 #elif defined(HAVE_FTRUNCATE)
@@ -41,7 +41,8 @@ datasink_t datasink_stdout = {
 	&stdout_write,
 	&stdout_close,
 	&dummy_remove,
-	&stdout_deinit
+	&stdout_deinit,
+	NULL
 };
 
 static
@@ -52,7 +52,8 @@ datasink_t datasink_tmpfile = {
 	&tmpfile_write,
 	&tmpfile_close,
 	&dummy_remove,
-	&tmpfile_deinit
+	&tmpfile_deinit,
+	NULL
 };
 
 
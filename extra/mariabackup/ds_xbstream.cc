@@ -42,6 +42,8 @@ static ds_ctxt_t *xbstream_init(const char *root);
 static ds_file_t *xbstream_open(ds_ctxt_t *ctxt, const char *path,
 			      MY_STAT *mystat);
 static int xbstream_write(ds_file_t *file, const uchar *buf, size_t len);
+static int xbstream_pwrite(ds_file_t *file, const uchar *buf, size_t len,
+			   my_off_t offset);
 static int xbstream_close(ds_file_t *file);
 static void xbstream_deinit(ds_ctxt_t *ctxt);
 
@@ -51,7 +53,8 @@ datasink_t datasink_xbstream = {
 	&xbstream_write,
 	&xbstream_close,
 	&dummy_remove,
-	&xbstream_deinit
+	&xbstream_deinit,
+	&xbstream_pwrite
 };
 
 static
@@ -190,6 +193,24 @@ xbstream_write(ds_file_t *file, const uchar *buf, size_t len)
 	return 0;
 }
 
+static
+int
+xbstream_pwrite(ds_file_t *file, const uchar *buf, size_t len,
+		my_off_t offset)
+{
+	ds_stream_file_t	*stream_file;
+
+	stream_file = (ds_stream_file_t *) file->ptr;
+
+	if (xb_stream_write_data_at(stream_file->xbstream_file, buf, len,
+				    offset)) {
+		msg("xb_stream_write_data_at() failed.");
+		return 1;
+	}
+
+	return 0;
+}
+
 static
 int
 xbstream_close(ds_file_t *file)
@@ -129,6 +129,7 @@ xb_fil_cur_open(
 	in case of error */
 	cursor->buf = NULL;
 	cursor->node = NULL;
+	cursor->is_range = false;
 
 	cursor->space_id = node->space->id;
 
@@ -242,6 +243,45 @@ xb_fil_cur_open(
 	return(XB_FIL_CUR_SUCCESS);
 }
 
+/** Open a cursor for reading a range of pages of a file that is
+already open in another cursor, so that several threads can copy
+parts of a large file.
+@param[out] cursor	cursor on the page range
+@param[in]  base	cursor that was opened with xb_fil_cur_open()
+			on the pass-through read filter
+@param[in]  first_page	first page of the range
+@param[in]  n_pages	number of pages in the range
+@param[in]  thread_n	thread number for diagnostics */
+void xb_fil_cur_open_range(xb_fil_cur_t *cursor, const xb_fil_cur_t &base,
+                           uint32_t first_page, uint32_t n_pages,
+                           uint thread_n)
+{
+	ut_ad(!base.is_range);
+	ut_ad(base.read_filter == &rf_pass_through);
+
+	*cursor = base;
+	cursor->is_range = true;
+	cursor->thread_n = thread_n;
+	cursor->buf = static_cast<byte*>(aligned_malloc(cursor->buf_size,
+							srv_page_size));
+	cursor->buf_read = 0;
+	cursor->buf_npages = 0;
+	cursor->buf_offset = 0;
+	cursor->buf_page_no = 0;
+
+	/* The last range includes any junk at the end of the file,
+	which xb_fil_cur_read() will warn about. */
+	const ib_int64_t end = ib_int64_t(first_page + n_pages)
+		* ib_int64_t(cursor->page_size);
+	cursor->read_filter->init(&cursor->read_filter_ctxt, cursor,
+				  cursor->space_id);
+	cursor->read_filter_ctxt.offset = ib_int64_t(first_page)
+		* ib_int64_t(cursor->page_size);
+	if (end < cursor->read_filter_ctxt.data_file_size) {
+		cursor->read_filter_ctxt.data_file_size = end;
+	}
+}
+
 static bool page_is_corrupted(const byte *page, ulint page_no,
 			      const xb_fil_cur_t *cursor,
 			      const fil_space_t *space)
@@ -494,7 +534,10 @@ xb_fil_cur_close(
 	aligned_free(cursor->buf);
 	cursor->buf = NULL;
 
-	if (cursor->node != NULL) {
+	if (cursor->is_range) {
+		/* The file is owned by the base cursor. */
+		cursor->node = NULL;
+	} else if (cursor->node != NULL) {
 		xb_fil_node_close_file(cursor->node);
 		cursor->file = OS_FILE_CLOSED;
 	}
@@ -58,6 +58,8 @@ struct xb_fil_cur_t {
 	uint		thread_n;	/*!< thread number for diagnostics */
 	uint32_t	space_id;	/*!< ID of tablespace */
 	uint32_t	space_size;	/*!< space size in pages */
+	bool		is_range;	/*!< whether the cursor was opened
+					by xb_fil_cur_open_range() */
 
 	/** @return whether this is not a file-per-table tablespace */
 	bool is_system() const
@@ -89,6 +91,19 @@ xb_fil_cur_open(
 	uint		thread_n,	/*!< thread number for diagnostics */
 	ulonglong max_file_size = ULLONG_MAX);
 
+/** Open a cursor for reading a range of pages of a file that is
+already open in another cursor, so that several threads can copy
+parts of a large file.
+@param[out] cursor	cursor on the page range
+@param[in]  base	cursor that was opened with xb_fil_cur_open()
+			on the pass-through read filter
+@param[in]  first_page	first page of the range
+@param[in]  n_pages	number of pages in the range
+@param[in]  thread_n	thread number for diagnostics */
+void xb_fil_cur_open_range(xb_fil_cur_t *cursor, const xb_fil_cur_t &base,
+                           uint32_t first_page, uint32_t n_pages,
+                           uint thread_n);
+
 /** Reads and verifies the next block of pages from the source
 file. Positions the cursor after the last read non-corrupted page.
 @param[in,out] cursor source file cursor
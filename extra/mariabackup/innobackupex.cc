@@ -61,6 +61,7 @@ Street, Fifth Floor, Boston, MA 02110-1335 USA
 #include "fil_cur.h"
 #include "write_filt.h"
 #include "backup_copy.h"
+#include "ds_compress.h"
 
 using std::min;
 using std::max;
@@ -339,8 +340,8 @@ static struct my_option ibx_long_options[] =
 	 (uchar *) &opt_ibx_no_backup_locks,
 	 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
 
-	{"decompress", OPT_DECOMPRESS, "Decompresses all files with the .qp "
-	 "extension in a backup previously made with the --compress option.",
+	{"decompress", OPT_DECOMPRESS, "Decompresses all files with the .qp, "
+	 ".lz4 or .zst extension in a backup previously made with the --compress option.",
 	 (uchar *) &opt_ibx_decompress,
 	 (uchar *) &opt_ibx_decompress,
 	 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
@@ -686,8 +687,8 @@ the backup in the given directory (which must not exist).  This\n\
 command makes a complete backup of all MyISAM and InnoDB tables and\n\
 indexes in all databases or in all of the databases specified with the\n\
 --databases option.  The created backup contains .frm, .MRG, .MYD,\n\
-.MYI, .MAD, .MAI, .TRG, .TRN, .ARM, .ARZ, .CSM, CSV, .opt, .par, and\n\
-InnoDB data and log files.  The MY.CNF options file defines the\n\
+.MYI, .MAD, .MAI, .TRG, .TRN, .ARM, .ARZ, .ARG, .CSM, CSV, .opt, .par,\n\
+and InnoDB data and log files.  The MY.CNF options file defines the\n\
 location of the database.\n\
 \n\
 The --apply-log command prepares a backup for starting a MySQL\n\
@@ -756,7 +757,7 @@ ibx_get_one_option(const struct my_option *opt,
 	case OPT_COMPRESS:
 		if (argument == NULL)
 			xtrabackup_compress_alg = "quicklz";
-		else if (strcasecmp(argument, "quicklz"))
+		else if (!ds_compress_alg_supported(argument))
 		{
 			ibx_msg("Invalid --compress argument: %s\n", argument);
 			return 1;
@@ -448,24 +448,26 @@ extract_worker_thread_func(void *arg)
 			continue;
 		}
 
+		/* mariabackup --parallel may copy page ranges of a
+		file in several threads, so the chunks of a file
+		are not necessarily in order. */
 		if (entry->offset != chunk.offset) {
-			msg("%s: out-of-order chunk: real offset = 0x%llx, "
-			    "expected offset = 0x%llx", my_progname,
-			    chunk.offset, entry->offset);
-			pthread_mutex_unlock(&entry->mutex);
-			res = XB_STREAM_READ_ERROR;
-			break;
-		}
-
-		if (ds_write(entry->file, chunk.data, chunk.length)) {
+			if (ds_pwrite(entry->file, chunk.data, chunk.length,
+				      chunk.offset)) {
+				msg("%s: my_pwrite() failed.", my_progname);
+				pthread_mutex_unlock(&entry->mutex);
+				res = XB_STREAM_READ_ERROR;
+				break;
+			}
+		} else if (ds_write(entry->file, chunk.data, chunk.length)) {
 			msg("%s: my_write() failed.", my_progname);
 			pthread_mutex_unlock(&entry->mutex);
 			res = XB_STREAM_READ_ERROR;
 			break;
+		} else {
+			entry->offset += chunk.length;
 		}
 
-		entry->offset += chunk.length;
-
 		pthread_mutex_unlock(&entry->mutex);
 	}
 
@@ -60,6 +60,9 @@ xb_wstream_file_t *xb_stream_write_open(xb_wstream_t *stream, const char *path,
 
 int xb_stream_write_data(xb_wstream_file_t *file, const void *buf, size_t len);
 
+int xb_stream_write_data_at(xb_wstream_file_t *file, const void *buf,
+			    size_t len, my_off_t offset);
+
 int xb_stream_write_close(xb_wstream_file_t *file);
 
 int xb_stream_write_done(xb_wstream_t *stream);
@@ -45,7 +45,8 @@ struct xb_wstream_file_struct {
 
 static int xb_stream_flush(xb_wstream_file_t *file);
 static int xb_stream_write_chunk(xb_wstream_file_t *file,
-				 const void *buf, size_t len);
+				 const void *buf, size_t len,
+				 my_off_t offset);
 static int xb_stream_write_eof(xb_wstream_file_t *file);
 
 static
@@ -137,7 +138,23 @@ xb_stream_write_data(xb_wstream_file_t *file, const void *buf, size_t len)
 	if (xb_stream_flush(file))
 		return 1;
 
-	return xb_stream_write_chunk(file, buf, len);
+	if (xb_stream_write_chunk(file, buf, len, file->offset))
+		return 1;
+
+	file->offset+= len;
+
+	return 0;
+}
+
+/************************************************************************
+Write a chunk of data at the specified file offset. Can be invoked by
+several threads on the same file, but not concurrently with
+xb_stream_write_data(). */
+int
+xb_stream_write_data_at(xb_wstream_file_t *file, const void *buf, size_t len,
+			my_off_t offset)
+{
+	return xb_stream_write_chunk(file, buf, len, offset);
 }
 
 int
@@ -173,10 +190,13 @@ xb_stream_flush(xb_wstream_file_t *file)
 	}
 
 	if (xb_stream_write_chunk(file, file->chunk,
-				  file->chunk_ptr - file->chunk)) {
+				  file->chunk_ptr - file->chunk,
+				  file->offset)) {
 		return 1;
 	}
 
+	file->offset+= file->chunk_ptr - file->chunk;
+
 	file->chunk_ptr = file->chunk;
 	file->chunk_free = XB_STREAM_MIN_CHUNK_SIZE;
 
@@ -185,7 +205,8 @@ xb_stream_flush(xb_wstream_file_t *file)
 
 static
 int
-xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
+xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len,
+		      my_off_t offset)
 {
 	/* Chunk magic + flags + chunk type + path_len + path + len + offset +
 	checksum */
@@ -219,7 +240,7 @@ xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
 
 	pthread_mutex_lock(&stream->mutex);
 
-	int8store(ptr, file->offset);            /* Payload offset */
+	int8store(ptr, offset);                  /* Payload offset */
 	ptr += 8;
 
 	int4store(ptr, checksum);
@@ -234,8 +255,6 @@ xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
 	if (file->write(file, file->userdata, buf, len) == -1) /* Payload */
 		goto err;
 
-	file->offset+= len;
-
 	pthread_mutex_unlock(&stream->mutex);
 
 	return 0;
@@ -83,6 +83,7 @@ Street, Fifth Floor, Boston, MA 02110-1335 USA
 #include "ha_innodb.h"
 
 #include <list>
+#include <condition_variable>
 #include <sstream>
 #include <set>
 #include <fstream>
@@ -98,6 +99,7 @@ Street, Fifth Floor, Boston, MA 02110-1335 USA
 #include "write_filt.h"
 #include "xtrabackup.h"
 #include "ds_buffer.h"
+#include "ds_compress.h"
 #include "ds_tmpfile.h"
 #include "xbstream.h"
 #include "changed_page_bitmap.h"
@@ -190,6 +192,9 @@ struct xb_filter_entry_t{
 static bool log_copying_running;
 
 int xtrabackup_parallel;
+/** Size of the page ranges that larger data files are split into, so that
+several --parallel threads can copy one file (0=disable) */
+ulonglong xtrabackup_parallel_split_size;
 
 char *xtrabackup_stream_str = NULL;
 xb_stream_fmt_t xtrabackup_stream_fmt = XB_STREAM_FMT_NONE;
@@ -988,6 +993,7 @@ enum options_xtrabackup
   OPT_XTRA_DATABASES,
   OPT_XTRA_DATABASES_FILE,
   OPT_XTRA_PARALLEL,
+  OPT_XTRA_PARALLEL_SPLIT_SIZE,
   OPT_XTRA_EXTENDED_VALIDATION,
   OPT_XTRA_ENCRYPTED_BACKUP,
   OPT_XTRA_STREAM,
@@ -1067,6 +1073,7 @@ enum options_xtrabackup
   OPT_XTRA_MYSQLD_ARGS,
   OPT_XB_IGNORE_INNODB_PAGE_CORRUPTION,
   OPT_INNODB_FORCE_RECOVERY,
+  OPT_INNODB_RECOVERY_PARALLEL_INIT,
   OPT_MAX_BINLOGS
 };
 
@@ -1178,9 +1185,10 @@ struct my_option xb_client_options[]= {
 
     {"compress", OPT_XTRA_COMPRESS,
      "Compress individual backup files using the "
-     "specified compression algorithm. Currently the only supported algorithm "
-     "is 'quicklz'. It is also the default algorithm, i.e. the one used when "
-     "--compress is used without an argument.",
+     "specified compression algorithm. Supported algorithms are 'quicklz' "
+     "and, depending on the build, 'lz4' and 'zstd'. 'quicklz' is the default "
+     "algorithm, i.e. the one used when --compress is used without an "
+     "argument.",
      (G_PTR *) &xtrabackup_compress_alg, (G_PTR *) &xtrabackup_compress_alg, 0,
      GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
 
@@ -1313,7 +1321,7 @@ struct my_option xb_client_options[]= {
      GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
 
     {"decompress", OPT_DECOMPRESS,
-     "Decompresses all files with the .qp "
+     "Decompresses all files with the .qp, .lz4 or .zst "
      "extension in a backup previously made with the --compress option.",
      (uchar *) &opt_decompress, (uchar *) &opt_decompress, 0, GET_BOOL, NO_ARG,
      0, 0, 0, 0, 0, 0},
@@ -1382,8 +1390,9 @@ struct my_option xb_client_options[]= {
      0, 0, 0, 0},
 
     {"remove-original", OPT_REMOVE_ORIGINAL,
-     "Remove .qp files after decompression.", (uchar *) &opt_remove_original,
-     (uchar *) &opt_remove_original, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+     "Remove .qp, .lz4 or .zst files after decompression.",
+     (uchar *) &opt_remove_original, (uchar *) &opt_remove_original, 0,
+     GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
 
     {"ftwrl-wait-query-type", OPT_LOCK_WAIT_QUERY_TYPE,
      "This option specifies which types of queries are allowed to complete "
@@ -1508,10 +1517,21 @@ struct my_option xb_server_options[] =
    (G_PTR*) &opt_mysql_tmpdir, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"parallel", OPT_XTRA_PARALLEL,
    "Number of threads to use for parallel datafiles transfer. "
+   "With --prepare, the number of threads that apply the log to "
+   "data pages (at least 4, at most 64). "
    "The default value is 1.",
    (G_PTR*) &xtrabackup_parallel, (G_PTR*) &xtrabackup_parallel, 0, GET_INT,
    REQUIRED_ARG, 1, 1, INT_MAX, 0, 0, 0},
 
+  {"parallel-split-size", OPT_XTRA_PARALLEL_SPLIT_SIZE,
+   "Data files larger than this are split into page ranges of this size, "
+   "which the --parallel threads copy concurrently. Only used for full "
+   "backups that are not compressed. 0 disables the splitting. "
+   "The default value is 1G.",
+   (G_PTR*) &xtrabackup_parallel_split_size,
+   (G_PTR*) &xtrabackup_parallel_split_size, 0, GET_ULL, REQUIRED_ARG,
+   1ULL << 30, 0, ULONGLONG_MAX, 0, 1ULL << 20, 0},
+
   {"extended_validation", OPT_XTRA_EXTENDED_VALIDATION,
    "Enable extended validation for Innodb data pages during backup phase. "
    "Will slow down backup considerably, in case encryption is used. "
@@ -1695,6 +1715,14 @@ struct my_option xb_server_options[] =
    (G_PTR*)&srv_force_recovery,
    0, GET_ULONG, OPT_ARG, 0, 0, SRV_FORCE_IGNORE_CORRUPT, 0, 0, 0},
 
+  {"innodb_recovery_parallel_init", OPT_INNODB_RECOVERY_PARALLEL_INIT,
+   "(for --prepare): Initialize the pages that are not read from the "
+   "data files in multiple threads. Use --skip-innodb-recovery-parallel-init "
+   "to initialize them in one thread.",
+   (G_PTR*)&srv_recovery_parallel_init,
+   (G_PTR*)&srv_recovery_parallel_init,
+   0, GET_BOOL, NO_ARG, 1, 0, 0, 0, 0, 0},
+
     {"mysqld-args", OPT_XTRA_MYSQLD_ARGS,
      "All arguments that follow this argument are considered as server "
      "options, and if some of them are not supported by mariabackup, they "
@@ -1976,7 +2004,7 @@ xb_get_one_option(const struct my_option *opt,
   case OPT_XTRA_COMPRESS:
     if (argument == NULL)
       xtrabackup_compress_alg = "quicklz";
-    else if (strcasecmp(argument, "quicklz"))
+    else if (!ds_compress_alg_supported(argument))
     {
       msg("Invalid --compress argument: %s", argument);
       return 1;
@@ -2833,6 +2861,149 @@ xb_get_copy_action(const char *dflt)
 }
 
 
+/** A data file whose page ranges are being copied by several threads */
+struct xb_split_copy_t
+{
+	/** cursor of the thread that opened the file */
+	const xb_fil_cur_t	*cursor;
+	/** destination file */
+	ds_file_t		*dstfile;
+	/** corrupted pages of the backup */
+	CorruptedPages		*corrupted_pages;
+	/** number of pages in a range */
+	uint32_t		range_pages;
+	/** number of ranges */
+	uint32_t		n_ranges;
+	/** the next range to copy; protected by split_copy_mutex */
+	uint32_t		next_range;
+	/** number of other threads that are copying a range;
+	protected by split_copy_mutex */
+	uint32_t		n_helpers;
+	/** whether copying a range failed; protected by split_copy_mutex */
+	bool			failed;
+};
+
+/** Protects split_copies and the state of the xb_split_copy_t */
+static std::mutex split_copy_mutex;
+/** Signalled when xb_split_copy_t::n_helpers reaches 0 */
+static std::condition_variable split_copy_cond;
+/** The files that other data copying threads can help to copy */
+static std::list<xb_split_copy_t*> split_copies;
+
+/** Copy a page range of a data file that is being split.
+@param split	the file being copied
+@param range	the range to copy
+@param thread_n	thread id, used in the text of diagnostic messages
+@return whether the range was copied successfully */
+static bool xb_split_copy_range(const xb_split_copy_t &split, uint32_t range,
+				uint thread_n)
+{
+	xb_fil_cur_t		cursor;
+	xb_fil_cur_result_t	res;
+
+	xb_fil_cur_open_range(&cursor, *split.cursor,
+			      range * split.range_pages, split.range_pages,
+			      thread_n);
+
+	while ((res = xb_fil_cur_read(&cursor, *split.corrupted_pages))
+	       == XB_FIL_CUR_SUCCESS) {
+		if (ds_pwrite(split.dstfile, cursor.buf, cursor.buf_read,
+			      cursor.buf_offset)) {
+			res = XB_FIL_CUR_ERROR;
+			break;
+		}
+	}
+
+	xb_fil_cur_close(&cursor);
+	return res == XB_FIL_CUR_EOF;
+}
+
+/** Help other threads to copy the page ranges of large data files
+before starting to copy another file.
+@param thread_n	thread id, used in the text of diagnostic messages */
+static void xb_split_copy_help(uint thread_n)
+{
+	std::unique_lock<std::mutex> lk(split_copy_mutex);
+
+	while (!split_copies.empty()) {
+		xb_split_copy_t *split = split_copies.front();
+		if (split->failed || split->next_range == split->n_ranges) {
+			split_copies.pop_front();
+			continue;
+		}
+
+		const uint32_t range = split->next_range++;
+		split->n_helpers++;
+		lk.unlock();
+		const bool ok = xb_split_copy_range(*split, range, thread_n);
+		lk.lock();
+		if (!ok) {
+			split->failed = true;
+		}
+		if (!--split->n_helpers) {
+			split_copy_cond.notify_all();
+		}
+	}
+}
+
+/** Copy a large data file in page ranges, with the help of the other
+data copying threads. Ranges may be written to the destination in
+any order.
+@param cursor	cursor on the file, on the pass-through read filter
+@param dstfile	destination file, supporting ds_pwrite()
+@param thread_n	thread id, used in the text of diagnostic messages
+@param corrupted_pages	corrupted pages of the backup
+@return whether the file was copied successfully */
+static bool xb_split_copy(const xb_fil_cur_t &cursor, ds_file_t *dstfile,
+			  uint thread_n, CorruptedPages &corrupted_pages)
+{
+	const uint64_t n_pages = (uint64_t(cursor.statinfo.st_size)
+				  + cursor.page_size - 1) / cursor.page_size;
+
+	xb_split_copy_t split;
+	split.cursor = &cursor;
+	split.dstfile = dstfile;
+	split.corrupted_pages = &corrupted_pages;
+	split.range_pages = uint32_t(std::max<ulonglong>(
+		xtrabackup_parallel_split_size / cursor.page_size, 1));
+	split.n_ranges = uint32_t((n_pages + split.range_pages - 1)
+				  / split.range_pages);
+	split.next_range = 1;
+	split.n_helpers = 0;
+	split.failed = false;
+
+	msg(thread_n, "Splitting %s into %u ranges", cursor.abs_path,
+	    split.n_ranges);
+
+	/* Copy the first page range before anything else, so that the
+	destination sees the tablespace flags first. */
+	bool ok = xb_split_copy_range(split, 0, thread_n);
+
+	std::unique_lock<std::mutex> lk(split_copy_mutex);
+
+	if (ok) {
+		split_copies.push_back(&split);
+
+		while (!split.failed && split.next_range < split.n_ranges) {
+			const uint32_t range = split.next_range++;
+			lk.unlock();
+			ok = xb_split_copy_range(split, range, thread_n);
+			lk.lock();
+			if (!ok) {
+				split.failed = true;
+			}
+		}
+
+		split_copies.remove(&split);
+	}
+
+	while (split.n_helpers) {
+		split_copy_cond.wait(lk);
+	}
+
+	return ok && !split.failed;
+}
+
 /** Copy innodb data file to the specified destination.
 
 @param[in] node	file node of a tablespace
@@ -2921,16 +3092,29 @@ static my_bool xtrabackup_copy_datafile(fil_node_t *node, uint thread_n,
 		    dstfile->path);
 	}
 
-	/* The main copy loop */
-	while ((res = xb_fil_cur_read(&cursor, corrupted_pages)) ==
-		XB_FIL_CUR_SUCCESS) {
-		if (!write_filter.process(&write_filt_ctxt, dstfile)) {
+	if (!dest_name && xtrabackup_parallel > 1
+	    && xtrabackup_parallel_split_size
+	    && read_filter == &rf_pass_through
+	    && &write_filter == &wf_write_through
+	    && ds_supports_pwrite(ds_data)
+	    && ulonglong(cursor.statinfo.st_size)
+	    > xtrabackup_parallel_split_size) {
+		if (!xb_split_copy(cursor, dstfile, thread_n,
+				   corrupted_pages)) {
 			goto error;
 		}
-	}
+	} else {
+		/* The main copy loop */
+		while ((res = xb_fil_cur_read(&cursor, corrupted_pages)) ==
+			XB_FIL_CUR_SUCCESS) {
+			if (!write_filter.process(&write_filt_ctxt, dstfile)) {
+				goto error;
+			}
+		}
 
-	if (res == XB_FIL_CUR_ERROR) {
-		goto error;
+		if (res == XB_FIL_CUR_ERROR) {
+			goto error;
+		}
 	}
 
 	if (write_filter.finalize
@@ -3308,7 +3492,11 @@ static void data_copy_thread_func(data_thread_ctxt_t *ctxt) /* thread context */
 	*/
 	my_thread_init();
 
-	while ((node = datafiles_iter_next(ctxt->it)) != NULL) {
+	for (;;) {
+		xb_split_copy_help(num);
+		if (!(node = datafiles_iter_next(ctxt->it))) {
+			break;
+		}
 		DBUG_MARIABACKUP_EVENT("before_copy", node->space->name());
 		DBUG_EXECUTE_FOR_KEY("wait_innodb_redo_before_copy",
 				     node->space->name(),
@@ -4791,6 +4979,17 @@ static bool xtrabackup_backup_func()
 		goto fail;
 	}
 
+	if (xtrabackup_incremental && have_changed_page_bitmaps
+	    && !xtrabackup_incremental_force_scan) {
+		changed_page_bitmap = xb_page_bitmap_init();
+		if (changed_page_bitmap) {
+			msg("mariabackup: using the changed page bitmap");
+		} else {
+			msg("mariabackup: changed page bitmap not available,"
+			    " scanning all pages");
+		}
+	}
+
 	ut_a(xtrabackup_parallel > 0);
 
 	if (xtrabackup_parallel > 1) {
@@ -6087,6 +6286,16 @@ static bool xtrabackup_prepare_func(char** argv)
 		srv_n_write_io_threads = 4;
 	}
 
+	/* The log is applied to the pages in the read completion
+	callbacks and in recv_sys_t::init_pages(), both of which are
+	limited by srv_n_read_io_threads. */
+	if (xtrabackup_parallel > int(srv_n_read_io_threads)) {
+		srv_n_read_io_threads = srv_n_write_io_threads =
+			uint(std::min(xtrabackup_parallel, 64));
+		msg("Using %u threads for applying the log.",
+		    srv_n_read_io_threads);
+	}
+
 	msg("Starting InnoDB instance for recovery.");
 
 	msg("mariabackup: Using %lld bytes for buffer pool "
@@ -50,6 +50,8 @@ int decimal2ulonglong(const decimal_t *from, ulonglong *to);
 int ulonglong2decimal(ulonglong from, decimal_t *to);
 int decimal2longlong(const decimal_t *from, longlong *to);
 int longlong2decimal(longlong from, decimal_t *to);
+int decimal2scaled_longlong(const decimal_t *from, int scale, longlong *to);
+int scaled_longlong2decimal(longlong from, int scale, decimal_t *to);
 int decimal2double(const decimal_t *from, double *to);
 int double2decimal(double from, decimal_t *to);
 decimal_digits_t decimal_actual_fraction(const decimal_t *from);
@@ -90,6 +90,8 @@ extern char *strmov_overlapp(char *dest, const char *src);
 extern	void bmove_upp(uchar *dst,const uchar *src,size_t len);
 extern	void bchange(uchar *dst,size_t old_len,const uchar *src,
 		     size_t new_len,size_t tot_len);
+extern	const uchar *bfind(const uchar *str, size_t str_length,
+			   const uchar *find, size_t find_length);
 extern	void strappend(char *s,size_t len,pchar fill);
 extern	char *strend(const char *s);
 extern  char *strcend(const char *, pchar);
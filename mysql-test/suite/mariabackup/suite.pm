@@ -11,10 +11,23 @@ return "No mariabackup" unless $ENV{XTRABACKUP};
 
 my $have_qpress = index(`qpress 2>&1`,"Compression") > 0;
 
+# --compress=<alg> needs mariabackup built with the library and the
+# command line tool that --decompress runs
+sub have_compress_alg {
+  my ($alg, $tool) = @_;
+  return 0 if system("$tool -V >/dev/null 2>&1");
+  return index(`$ENV{XTRABACKUP} --compress=$alg --version 2>&1`,
+               "Invalid --compress") < 0;
+}
+my $have_lz4 = have_compress_alg('lz4', 'lz4');
+my $have_zstd = have_compress_alg('zstd', 'zstd');
+
 sub skip_combinations {
   my %skip;
   $skip{'include/have_file_key_management.inc'} = 'needs file_key_management plugin'  unless $ENV{FILE_KEY_MANAGEMENT_SO};
   $skip{'compress_qpress.test'}= 'needs qpress executable in PATH' unless $have_qpress;
+  $skip{'compress_lz4.test'}= 'needs lz4 support and the lz4 executable in PATH' unless $have_lz4;
+  $skip{'compress_zstd.test'}= 'needs zstd support and the zstd executable in PATH' unless $have_zstd;
   %skip;
 }
 
@@ -0,0 +1,141 @@
+#!/usr/bin/env perl
+# Copyright (c) 2022, MariaDB Corporation.
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Library General Public
+# License as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Library General Public License for more details.
+#
+# You should have received a copy of the GNU Library General Public
+# License along with this library; if not, write to the Free
+# Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston,
+# MA 02110-1335  USA
+#
+# Test of converting TIMESTAMP values to a named time zone and of
+# formatting them with DATE_FORMAT()
+#
+##################### Standard benchmark inits ##############################
+
+use Cwd;
+use DBI;
+use Getopt::Long;
+use Benchmark;
+
+$opt_loop_count=100000;
+$opt_medium_loop_count=20;
+$opt_time_zone="Europe/Berlin";
+
+$pwd = cwd(); $pwd = "." if ($pwd eq '');
+require "$pwd/bench-init.pl" || die "Can't read Configuration file: $!\n";
+
+if ($opt_small_test)
+{
+  $opt_loop_count/=10;
+  $opt_medium_loop_count/=10;
+}
+
+print "Testing the speed of TIMESTAMP conversions and DATE_FORMAT()\n";
+print "The test-table has $opt_loop_count rows\n\n";
+
+####
+####  Connect and start timeing
+####
+
+$dbh = $server->connect();
+$start_time=new Benchmark;
+
+####
+#### Create needed tables
+####
+
+goto select_test if ($opt_skip_create);
+
+print "Creating table\n";
+$dbh->do("drop table bench1" . $server->{'drop_attr'});
+
+do_many($dbh,$server->create("bench1",
+			     ["id integer NOT NULL",
+			      "ts timestamp NOT NULL"],
+			     ["primary key (id)"]));
+
+####
+#### Insert $opt_loop_count rows, one every 17 minutes, so that the
+#### values span several daylight saving time transitions
+####
+
+print "Inserting $opt_loop_count rows\n";
+
+$loop_time=new Benchmark;
+do_query($dbh,"set time_zone='+00:00'");
+for ($id=0 ; $id < $opt_loop_count ; )
+{
+  $query="insert into bench1 values ";
+  for ($i=0 ; $i < 100 && $id < $opt_loop_count ; $i++, $id++)
+  {
+    $query.="," if ($i);
+    $query.="($id,from_unixtime(1262304000+$id*1020))";
+  }
+  do_query($dbh,$query);
+}
+
+$end_time=new Benchmark;
+print "Time to insert ($opt_loop_count): " .
+    timestr(timediff($end_time, $loop_time),"all") . "\n\n";
+
+####
+#### Read the values back in different ways
+####
+
+select_test:
+
+if (!$dbh->do("set time_zone='$opt_time_zone'"))
+{
+  print "Time zone $opt_time_zone is not loaded, using SYSTEM\n";
+  do_query($dbh,"set time_zone=SYSTEM");
+}
+
+@queries=
+  (["select_timestamp",
+    "select ts from bench1"],
+   ["select_timestamp_random_order",
+    "select ts from bench1 order by (id * 7919) % $opt_loop_count"],
+   ["date_format_constant",
+    "select date_format(ts,'%Y-%m-%d %H:%i:%s') from bench1"],
+   ["date_format_constant_long",
+    "select date_format(ts,'%W, %D of %M %Y, %r (week %v)') from bench1"]);
+
+foreach $test (@queries)
+{
+  ($name,$query)=@$test;
+  $loop_time=new Benchmark;
+  $rows=$estimated=$count=0;
+  for ($i=0 ; $i < $opt_medium_loop_count ; $i++)
+  {
+    $count++;
+    $rows+=fetch_all_rows($dbh,$query);
+    $end_time=new Benchmark;
+    last if ($estimated=predict_query_time($loop_time,$end_time,\$count,$i+1,
+					   $opt_medium_loop_count));
+  }
+  print_time($estimated);
+  print " for $name ($count:$rows): " .
+    timestr(timediff($end_time, $loop_time),"all") . "\n";
+}
+
+####
+#### End of benchmark
+####
+
+if (!$opt_skip_delete)
+{
+  do_query($dbh,"drop table bench1" . $server->{'drop_attr'});
+}
+
+$dbh->disconnect;				# close connection
+
+end_benchmark($start_time);
@@ -613,6 +613,16 @@ bool Arg_comparator::set_cmp_func_int(THD *thd)
   }
   a= cache_converted_constant(thd, a, &a_cache, compare_type_handler());
   b= cache_converted_constant(thd, b, &b_cache, compare_type_handler());
+  if (func == &Arg_comparator::compare_int_signed &&
+      (*a)->type() == Item::FIELD_ITEM)
+  {
+    /*
+      The most common shape, e.g. "int_column < 10":
+      read the column value directly from the Field.
+    */
+    a_field= (Item_field *) *a;
+    func= &Arg_comparator::compare_int_signed_field;
+  }
   return false;
 }
 
@@ -940,6 +950,32 @@ int Arg_comparator::compare_int_signed()
 }
 
 
+/**
+  Compare a field to a value as signed BIGINT.
+
+  The same as compare_int_signed(), but the field value is read without
+  a virtual call to Item_field::val_int(), unless the argument has been
+  replaced by something else after set_cmp_func_int().
+*/
+
+int Arg_comparator::compare_int_signed_field()
+{
+  if (unlikely(*a != a_field))
+    return compare_int_signed();
+  Field *field= a_field->field;
+  if (!(a_field->null_value= field->is_null()))
+  {
+    longlong val1= field->val_int();
+    longlong val2= (*b)->val_int();
+    if (!(*b)->null_value)
+      return compare_not_null_values(val1, val2);
+  }
+  if (set_null)
+    owner->null_value= 1;
+  return -1;
+}
+
+
 /**
   Compare values as BIGINT UNSIGNED.
 */
@@ -3562,6 +3598,34 @@ static inline int cmp_ulongs (ulonglong a_val, ulonglong b_val)
 }
 
 
+/*
+  Compare two integers in IN value list format (packed_longlong),
+  see cmp_longlong().
+*/
+inline int in_longlong::cmp_packed(const packed_longlong *a,
+                                   const packed_longlong *b)
+{
+  if (a->unsigned_flag != b->unsigned_flag)
+  { 
+    /* 
+      One of the args is unsigned and is too big to fit into the 
+      positive signed range. Report no match.
+    */  
+    if ((a->unsigned_flag && ((ulonglong) a->val) > (ulonglong) LONGLONG_MAX)
+        ||
+        (b->unsigned_flag && ((ulonglong) b->val) > (ulonglong) LONGLONG_MAX))
+      return a->unsigned_flag ? 1 : -1;
+    /*
+      Although the signedness differs both args can fit into the signed 
+      positive range. Make them signed and compare as usual.
+    */  
+    return cmp_longs(a->val, b->val);
+  }
+  if (a->unsigned_flag)
+    return cmp_ulongs((ulonglong) a->val, (ulonglong) b->val);
+  return cmp_longs(a->val, b->val);
+}
+
 /*
   Compare two integers in IN value list format (packed_longlong) 
 
@@ -3589,25 +3653,7 @@ int cmp_longlong(void *cmp_arg,
                  in_longlong::packed_longlong *a,
                  in_longlong::packed_longlong *b)
 {
-  if (a->unsigned_flag != b->unsigned_flag)
-  { 
-    /* 
-      One of the args is unsigned and is too big to fit into the 
-      positive signed range. Report no match.
-    */  
-    if ((a->unsigned_flag && ((ulonglong) a->val) > (ulonglong) LONGLONG_MAX)
-        ||
-        (b->unsigned_flag && ((ulonglong) b->val) > (ulonglong) LONGLONG_MAX))
-      return a->unsigned_flag ? 1 : -1;
-    /*
-      Although the signedness differs both args can fit into the signed 
-      positive range. Make them signed and compare as usual.
-    */  
-    return cmp_longs(a->val, b->val);
-  }
-  if (a->unsigned_flag)
-    return cmp_ulongs((ulonglong) a->val, (ulonglong) b->val);
-  return cmp_longs(a->val, b->val);
+  return in_longlong::cmp_packed(a, b);
 }
 
 static int cmp_double(void *cmp_arg, double *a,double *b)
@@ -3762,6 +3808,45 @@ uchar *in_longlong::get_value(Item *item)
   return (uchar*) &tmp;
 }
 
+/*
+  The same as in_vector::find(), but with the comparison inlined,
+  rather than called through in_vector::compare for every step of
+  the bisection. Short lists are scanned linearly.
+*/
+
+bool in_longlong::find(Item *item)
+{
+  const packed_longlong *result= (const packed_longlong *) get_value(item);
+  const packed_longlong *values= (const packed_longlong *) base;
+  if (!result || !used_count)
+    return false;				// Null value
+
+  if (used_count <= 8)
+  {
+    for (uint i= 0; i < used_count; i++)
+    {
+      if (!cmp_packed(values + i, result))
+        return true;
+    }
+    return false;
+  }
+
+  uint start= 0, end= used_count - 1;
+  while (start != end)
+  {
+    uint mid= (start + end + 1) / 2;
+    int res;
+    if ((res= cmp_packed(values + mid, result)) == 0)
+      return true;
+    if (res < 0)
+      start= mid;
+    else
+      end= mid - 1;
+  }
+  return cmp_packed(values + start, result) == 0;
+}
+
+
 Item *in_longlong::create_item(THD *thd)
 { 
   /* 
@@ -5865,8 +5950,11 @@ int Regexp_processor_pcre::default_regex_flags()
 
 void Regexp_processor_pcre::cleanup()
 {
-  pcre2_match_data_free(m_pcre_match_data);
-  pcre2_code_free(m_pcre);
+  for (uint i= 0; i < m_cached_count; i++)
+  {
+    pcre2_match_data_free(m_cached_match_data[i]);
+    pcre2_code_free(m_cached_pcre[i]);
+  }
   reset();
 }
 
@@ -5920,14 +6008,27 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
 {
   int pcreErrorNumber;
   PCRE2_SIZE pcreErrorOffset;
+  String *orig_pattern= pattern;
+  pcre2_code *code;
+  pcre2_match_data *match_data;
+  uint slot;
+
+  if (is_compiled() && !stringcmp(pattern, &m_prev_pattern))
+    return false;
 
-  if (is_compiled())
+  for (slot= 0; slot < m_cached_count; slot++)
   {
-    if (!stringcmp(pattern, &m_prev_pattern))
+    if (!stringcmp(pattern, &m_cached_pattern[slot]))
+    {
+      m_pcre= m_cached_pcre[slot];
+      m_pcre_match_data= m_cached_match_data[slot];
+      m_prev_pattern.copy(*pattern);
+      current_thd->status_var.regexp_cache_hits++;
       return false;
-    cleanup();
-    m_prev_pattern.copy(*pattern);
+    }
   }
+  m_pcre= NULL;
+  m_pcre_match_data= NULL;
 
   if (!(pattern= convert_if_needed(pattern, &pattern_converter)))
     return true;
@@ -5940,12 +6041,13 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
     { return available_stack_size(&cur, end) < STACK_MIN_SIZE; },
     current_thd->mysys_var->stack_ends_here);
 #endif
-  m_pcre= pcre2_compile((PCRE2_SPTR8) pattern->ptr(), pattern->length(),
-                        m_library_flags,
-                        &pcreErrorNumber, &pcreErrorOffset, cctx);
+  current_thd->status_var.regexp_compilations++;
+  code= pcre2_compile((PCRE2_SPTR8) pattern->ptr(), pattern->length(),
+                       m_library_flags,
+                       &pcreErrorNumber, &pcreErrorOffset, cctx);
   pcre2_compile_context_free(cctx); // NULL is ok here
 
-  if (unlikely(m_pcre == NULL))
+  if (unlikely(code == NULL))
   {
     if (send_error)
     {
@@ -5959,12 +6061,28 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
     }
     return true;
   }
-  m_pcre_match_data= pcre2_match_data_create_from_pattern(m_pcre, NULL);
-  if (m_pcre_match_data == NULL)
+  match_data= pcre2_match_data_create_from_pattern(code, NULL);
+  if (match_data == NULL)
   {
+    pcre2_code_free(code);
     my_error(ER_OUT_OF_RESOURCES, MYF(0));
     return true;
   }
+
+  /* Remember the new pattern, replacing the oldest one if needed */
+  slot= m_cached_next;
+  m_cached_next= (m_cached_next + 1) % PATTERN_CACHE_SIZE;
+  if (m_cached_count < PATTERN_CACHE_SIZE)
+    m_cached_count++;
+  else
+  {
+    pcre2_match_data_free(m_cached_match_data[slot]);
+    pcre2_code_free(m_cached_pcre[slot]);
+  }
+  m_cached_pattern[slot].copy(*orig_pattern);
+  m_cached_pcre[slot]= m_pcre= code;
+  m_cached_match_data[slot]= m_pcre_match_data= match_data;
+  m_prev_pattern.copy(*orig_pattern);
   return false;
 }
 
@@ -6301,34 +6419,12 @@ bool Item_func_like::turboBM_matches(const char* text, int text_len) const
   /* Searching */
   if (!cs->sort_order)
   {
-    while (j <= tlmpl)
-    {
-      int i= plm1;
-      while (i >= 0 && pattern[i] == text[i + j])
-      {
-	i--;
-	if (i == plm1 - shift)
-	  i-= u;
-      }
-      if (i < 0)
-	return 1;
-
-      const int v= plm1 - i;
-      turboShift = u - v;
-      bcShift    = bmBc[(uint) (uchar) text[i + j]] - plm1 + i;
-      shift      = MY_MAX(turboShift, bcShift);
-      shift      = MY_MAX(shift, bmGs[i]);
-      if (shift == bmGs[i])
-	u = MY_MIN(pattern_len - shift, v);
-      else
-      {
-	if (turboShift < bcShift)
-	  shift = MY_MAX(shift, u + 1);
-	u = 0;
-      }
-      j+= shift;
-    }
-    return 0;
+    /*
+      A binary collation: a plain byte search filtering the candidate
+      positions on their first and last bytes is faster than the shifts.
+    */
+    return bfind((const uchar *) text, (size_t) text_len,
+                 (const uchar *) pattern, (size_t) pattern_len) != NULL;
   }
   else
   {
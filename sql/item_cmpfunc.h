@@ -55,6 +55,8 @@ class Arg_comparator: public Sql_alloc
   /* Fields used in DATE/DATETIME comparison. */
   Item *a_cache, *b_cache;         // Cached values of a and b items
                                    //   when one of arguments is NULL.
+  Item_field *a_field;             // *a, if it is a field and the values
+                                   //   are compared as signed integers
 
   int set_cmp_func(THD *thd, Item_func_or_sum *owner_arg,
                    Item **a1, Item **a2);
@@ -76,12 +78,12 @@ class Arg_comparator: public Sql_alloc
     m_compare_handler(&type_handler_null),
     m_compare_collation(&my_charset_bin),
     set_null(TRUE), comparators(0),
-    a_cache(0), b_cache(0) {};
+    a_cache(0), b_cache(0), a_field(0) {};
   Arg_comparator(Item **a1, Item **a2): a(a1), b(a2),
     m_compare_handler(&type_handler_null),
     m_compare_collation(&my_charset_bin),
     set_null(TRUE), comparators(0),
-    a_cache(0), b_cache(0) {};
+    a_cache(0), b_cache(0), a_field(0) {};
 
 public:
   bool set_cmp_func_for_row_arguments(THD *thd);
@@ -106,6 +108,7 @@ class Arg_comparator: public Sql_alloc
   int compare_real();            // compare args[0] & args[1]
   int compare_decimal();         // compare args[0] & args[1]
   int compare_int_signed();      // compare args[0] & args[1]
+  int compare_int_signed_field();
   int compare_int_signed_unsigned();
   int compare_int_unsigned_signed();
   int compare_int_unsigned();
@@ -1461,7 +1464,7 @@ class in_vector :public Sql_alloc
   {
     my_qsort2(base,used_count,size,compare,(void*)collation);
   }
-  bool find(Item *item);
+  virtual bool find(Item *item);
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -1536,10 +1539,12 @@ class in_longlong :public in_vector
     longlong val;
     longlong unsigned_flag;  // Use longlong, not bool, to preserve alignment
   } tmp;
+  static int cmp_packed(const packed_longlong *a, const packed_longlong *b);
 public:
   in_longlong(THD *thd, uint elements);
   void set(uint pos,Item *item) override;
   uchar *get_value(Item *item) override;
+  bool find(Item *item) override;
   Item* create_item(THD *thd) override;
   void value_to_item(uint pos, Item *item) override
   {
@@ -2983,6 +2988,17 @@ class Regexp_processor_pcre
   int m_library_flags;
   CHARSET_INFO *m_library_charset;
   String m_prev_pattern;
+  /*
+    Patterns compiled earlier in the statement. m_pcre and
+    m_pcre_match_data point to one of them, so a non-constant pattern
+    with a few distinct values is not recompiled for every row.
+  */
+  static const uint PATTERN_CACHE_SIZE= 8;
+  String m_cached_pattern[PATTERN_CACHE_SIZE];
+  pcre2_code *m_cached_pcre[PATTERN_CACHE_SIZE];
+  pcre2_match_data *m_cached_match_data[PATTERN_CACHE_SIZE];
+  uint m_cached_count;
+  uint m_cached_next;
   int m_pcre_exec_rc;
   PCRE2_SIZE *m_SubStrVec;
   void pcre_exec_warn(int rc) const;
@@ -2999,7 +3015,8 @@ class Regexp_processor_pcre
     m_pcre(NULL), m_pcre_match_data(NULL),
     m_conversion_is_needed(true), m_is_const(0),
     m_library_flags(0),
-    m_library_charset(&my_charset_utf8mb3_general_ci)
+    m_library_charset(&my_charset_utf8mb3_general_ci),
+    m_cached_count(0), m_cached_next(0)
   {}
   int default_regex_flags();
   void init(CHARSET_INFO *data_charset, int extra_flags);
@@ -3032,6 +3049,7 @@ class Regexp_processor_pcre
     m_pcre= NULL;
     m_pcre_match_data= NULL;
     m_prev_pattern.length(0);
+    m_cached_count= m_cached_next= 0;
   }
   void cleanup();
   bool is_compiled() const { return m_pcre != NULL; }
@@ -857,17 +857,18 @@ String *Item_func_json_extract::read_json(String *str,
          goto return_null;
        }
        c_path->parsed= c_path->constant;
-       has_negative_path|= c_path->p.types_used & JSON_PATH_NEGATIVE_INDEX;
+       c_path->types_used= c_path->p.types_used;
       }
     }
 
     if (args[n_arg]->null_value)
       goto return_null;
+    has_negative_path|= c_path->types_used & JSON_PATH_NEGATIVE_INDEX;
   }
 
   possible_multiple_values= arg_count > 2 ||
-    (paths[0].p.types_used & (JSON_PATH_WILD | JSON_PATH_DOUBLE_WILD |
-                              JSON_PATH_ARRAY_RANGE));
+    (paths[0].types_used & (JSON_PATH_WILD | JSON_PATH_DOUBLE_WILD |
+                            JSON_PATH_ARRAY_RANGE));
 
   *type= possible_multiple_values ? JSON_VALUE_ARRAY : JSON_VALUE_NULL;
 
@@ -880,6 +881,51 @@ String *Item_func_json_extract::read_json(String *str,
       goto error;
   }
 
+  if (!possible_multiple_values && !has_negative_path)
+  {
+    /*
+      The single path has no wildcards, so it matches one value at most.
+      json_find_path() only compares the keys that lie on that path and
+      skips the rest of the document, while the loop below has to build
+      and compare the path of every value in the JSON.
+    */
+    json_path_with_flags *c_path= paths;
+    int array_counters[JSON_DEPTH_LIMIT];
+
+    json_scan_start(&je, js->charset(),(const uchar *) js->ptr(),
+                    (const uchar *) js->ptr() + js->length());
+    c_path->cur_step= c_path->p.steps;
+    if (json_find_path(&je, &c_path->p, &c_path->cur_step, array_counters))
+      goto search_done;
+
+    if (json_read_value(&je))
+      goto error;
+
+    value= je.value_begin;
+    *type= je.value_type;
+    *out_val= (char *) je.value;
+    *value_len= je.value_len;
+    if (!str)
+      goto return_ok;
+
+    if (json_value_scalar(&je))
+      v_len= je.value_end - value;
+    else
+    {
+      if (json_skip_level(&je))
+        goto error;
+      v_len= je.s.c_str - value;
+    }
+
+    if (str->append((const char *) value, v_len))
+      goto error; /* Out of memory. */
+    not_first_value= 1;
+
+    /* Loop to the end of the JSON just to make sure it's valid. */
+    while (json_scan_next(&je) == 0) {}
+    goto search_done;
+  }
+
   json_get_path_start(&je, js->charset(),(const uchar *) js->ptr(),
                       (const uchar *) js->ptr() + js->length(), &p);
 
@@ -934,6 +980,7 @@ String *Item_func_json_extract::read_json(String *str,
     }
   }
 
+search_done:
   if (unlikely(je.s.error))
     goto error;
 
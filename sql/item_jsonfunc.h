@@ -32,11 +32,14 @@ class json_path_with_flags
   json_path_t p;
   bool constant;
   bool parsed;
+  /* p.types_used as it was set when the path was parsed */
+  uint types_used;
   json_path_step_t *cur_step;
   void set_constant_flag(bool s_constant)
   {
     constant= s_constant;
     parsed= FALSE;
+    types_used= JSON_PATH_KEY_NULL;
   }
 };
 
@@ -1502,6 +1502,8 @@ Item_sum_sum::Item_sum_sum(THD *thd, Item_sum_sum *item)
    Type_handler_hybrid_field_type(item),
    direct_added(FALSE), direct_reseted_field(FALSE),
    curr_dec_buff(item->curr_dec_buff),
+   pending_sum(item->pending_sum),
+   has_pending_sum(item->has_pending_sum),
    count(item->count)
 {
   /* TODO: check if the following assignments are really needed */
@@ -1537,6 +1539,8 @@ void Item_sum_sum::clear()
   if (result_type() == DECIMAL_RESULT)
   {
     curr_dec_buff= 0;
+    pending_sum= 0;
+    has_pending_sum= FALSE;
     my_decimal_set_zero(dec_buffs);
   }
   else
@@ -1565,6 +1569,8 @@ void Item_sum_sum::fix_length_and_dec_decimal()
                                                            decimals,
                                                            unsigned_flag);
   curr_dec_buff= 0;
+  pending_sum= 0;
+  has_pending_sum= FALSE;
   my_decimal_set_zero(dec_buffs);
 }
 
@@ -1622,6 +1628,57 @@ bool Item_sum_sum::add()
   DBUG_RETURN(0);
 }
 
+
+/**
+  Add a DECIMAL value to pending_sum using native integer arithmetic.
+
+  Most values summed up have the scale of the result and few digits,
+  e.g. the values of a DECIMAL(10,2) column. They are accumulated as
+  integers scaled by 10^decimals, and the total is added to dec_buffs
+  by flush_pending_sum() only when it is about to overflow or when the
+  result is needed.
+
+  Only values with exactly "decimals" fractional digits are taken,
+  so the scale of the result is the same as with my_decimal_add().
+
+  @retval true   The value was added
+  @retval false  The value does not fit, it must be added to dec_buffs
+*/
+
+bool Item_sum_sum::add_to_pending_sum(const my_decimal *val)
+{
+  longlong nr;
+  if (val->frac != (int) decimals ||
+      decimal2scaled_longlong(val, decimals, &nr) != E_DEC_OK)
+    return false;
+  /*
+    Both |nr| and |pending_sum| are less than 10^18 here,
+    so the addition can't overflow.
+  */
+  pending_sum+= nr;
+  has_pending_sum= TRUE;
+  if (pending_sum >= 1000000000000000000LL ||
+      pending_sum <= -1000000000000000000LL)
+    flush_pending_sum();
+  return true;
+}
+
+
+void Item_sum_sum::flush_pending_sum()
+{
+  if (has_pending_sum)
+  {
+    my_decimal tmp;
+    scaled_longlong2decimal(pending_sum, decimals, &tmp);
+    my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
+                   &tmp, dec_buffs + curr_dec_buff);
+    curr_dec_buff^= 1;
+    pending_sum= 0;
+    has_pending_sum= FALSE;
+  }
+}
+
+
 void Item_sum_sum::add_helper(bool perform_removal)
 {
   DBUG_ENTER("Item_sum_sum::add_helper");
@@ -1663,6 +1720,11 @@ void Item_sum_sum::add_helper(bool perform_removal)
         else
         {
           count++;
+          if (add_to_pending_sum(val))
+          {
+            null_value= 0;
+            DBUG_VOID_RETURN;
+          }
           my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
             val, dec_buffs + curr_dec_buff);
         }
@@ -1718,7 +1780,10 @@ longlong Item_sum_sum::val_int()
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_pending_sum();
     return dec_buffs[curr_dec_buff].to_longlong(unsigned_flag);
+  }
   return val_int_from_real();
 }
 
@@ -1729,7 +1794,10 @@ double Item_sum_sum::val_real()
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_pending_sum();
     sum= dec_buffs[curr_dec_buff].to_double();
+  }
   return sum;
 }
 
@@ -1749,7 +1817,10 @@ my_decimal *Item_sum_sum::val_decimal(my_decimal *val)
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_pending_sum();
     return null_value ? NULL : (dec_buffs + curr_dec_buff);
+  }
   return val_decimal_from_real(val);
 }
 
@@ -2094,6 +2165,7 @@ my_decimal *Item_sum_avg::val_decimal(my_decimal *val)
   if (result_type() != DECIMAL_RESULT)
     return val_decimal_from_real(val);
 
+  flush_pending_sum();
   sum_dec= dec_buffs + curr_dec_buff;
   int2my_decimal(E_DEC_FATAL_ERROR, count, 0, &cnt);
   my_decimal_div(E_DEC_FATAL_ERROR, val, sum_dec, &cnt, prec_increment);
@@ -805,12 +805,20 @@ class Item_sum_sum :public Item_sum_num,
   my_decimal direct_sum_decimal;
   my_decimal dec_buffs[2];
   uint curr_dec_buff;
+  /*
+    Sum of the DECIMAL values not yet added to dec_buffs, as an integer
+    scaled by 10^decimals. See add_to_pending_sum().
+  */
+  longlong pending_sum;
+  bool has_pending_sum;
   bool fix_length_and_dec(THD *thd) override;
+  bool add_to_pending_sum(const my_decimal *val);
+  void flush_pending_sum();
 
 public:
   Item_sum_sum(THD *thd, Item *item_par, bool distinct):
     Item_sum_num(thd, item_par), direct_added(FALSE),
-    direct_reseted_field(FALSE)
+    direct_reseted_field(FALSE), pending_sum(0), has_pending_sum(FALSE)
   {
     set_distinct(distinct);
   }
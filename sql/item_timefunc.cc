@@ -470,17 +470,239 @@ static bool extract_date_time(THD *thd, DATE_TIME_FORMAT *format,
 
 
 /**
-  Create a formatted date/time value in a string.
+  Append the value of one DATE_FORMAT() conversion specifier
+  (the character following '%') to a string.
 */
 
-static bool make_date_time(const String *format, const MYSQL_TIME *l_time,
-                           timestamp_type type, const MY_LOCALE *locale,
-                           String *str)
+static bool append_date_time_spec(char spec, const MYSQL_TIME *l_time,
+                                  timestamp_type type,
+                                  const MY_LOCALE *locale, String *str)
 {
   char intbuff[15];
   uint hours_i;
   uint weekday;
   ulong length;
+
+  switch (spec) {
+  case 'M':
+    if (type == MYSQL_TIMESTAMP_TIME || !l_time->month)
+      return 1;
+    str->append(locale->month_names->type_names[l_time->month-1],
+                (uint) strlen(locale->month_names->type_names[l_time->month-1]),
+                system_charset_info);
+    break;
+  case 'b':
+    if (type == MYSQL_TIMESTAMP_TIME || !l_time->month)
+      return 1;
+    str->append(locale->ab_month_names->type_names[l_time->month-1],
+                (uint) strlen(locale->ab_month_names->type_names[l_time->month-1]),
+                system_charset_info);
+    break;
+  case 'W':
+    if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
+      return 1;
+    weekday= calc_weekday(calc_daynr(l_time->year,l_time->month,
+                          l_time->day),0);
+    str->append(locale->day_names->type_names[weekday],
+                (uint) strlen(locale->day_names->type_names[weekday]),
+                system_charset_info);
+    break;
+  case 'a':
+    if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
+      return 1;
+    weekday=calc_weekday(calc_daynr(l_time->year,l_time->month,
+                         l_time->day),0);
+    str->append(locale->ab_day_names->type_names[weekday],
+                (uint) strlen(locale->ab_day_names->type_names[weekday]),
+                system_charset_info);
+    break;
+  case 'D':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    if (l_time->day >= 10 &&  l_time->day <= 19)
+      str->append(STRING_WITH_LEN("th"));
+    else
+    {
+      switch (l_time->day %10) {
+      case 1:
+	str->append(STRING_WITH_LEN("st"));
+	break;
+      case 2:
+	str->append(STRING_WITH_LEN("nd"));
+	break;
+      case 3:
+	str->append(STRING_WITH_LEN("rd"));
+	break;
+      default:
+	str->append(STRING_WITH_LEN("th"));
+	break;
+      }
+    }
+    break;
+  case 'Y':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->year, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 4, '0');
+    break;
+  case 'y':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->year%100, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'm':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->month, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'c':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->month, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    break;
+  case 'd':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'e':
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    break;
+  case 'f':
+    length= (uint) (int10_to_str(l_time->second_part, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 6, '0');
+    break;
+  case 'H':
+    length= (uint) (int10_to_str(l_time->hour, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'h':
+  case 'I':
+    hours_i= (l_time->hour%24 + 11)%12+1;
+    length= (uint) (int10_to_str(hours_i, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'i':					/* minutes */
+    length= (uint) (int10_to_str(l_time->minute, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'j':
+    if (type == MYSQL_TIMESTAMP_TIME || !l_time->month || !l_time->year)
+      return 1;
+    length= (uint) (int10_to_str(calc_daynr(l_time->year,l_time->month,
+				    l_time->day) - 
+		 calc_daynr(l_time->year,1,1) + 1, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 3, '0');
+    break;
+  case 'k':
+    length= (uint) (int10_to_str(l_time->hour, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    break;
+  case 'l':
+    hours_i= (l_time->hour%24 + 11)%12+1;
+    length= (uint) (int10_to_str(hours_i, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    break;
+  case 'p':
+    hours_i= l_time->hour%24;
+    str->append(hours_i < 12 ? "AM" : "PM",2);
+    break;
+  case 'r':
+    length= sprintf(intbuff, ((l_time->hour % 24) < 12) ?
+                "%02d:%02d:%02d AM" : "%02d:%02d:%02d PM",
+		(l_time->hour+11)%12+1,
+		l_time->minute,
+		l_time->second);
+    str->append(intbuff, length);
+    break;
+  case 'S':
+  case 's':
+    length= (uint) (int10_to_str(l_time->second, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+    break;
+  case 'T':
+    length= sprintf(intbuff, "%02d:%02d:%02d",
+		l_time->hour, l_time->minute, l_time->second);
+    str->append(intbuff, length);
+    break;
+  case 'U':
+  case 'u':
+  {
+    uint year;
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(calc_week(l_time,
+				   spec == 'U' ?
+				   WEEK_FIRST_WEEKDAY : WEEK_MONDAY_FIRST,
+				   &year),
+			 intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+  }
+  break;
+  case 'v':
+  case 'V':
+  {
+    uint year;
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    length= (uint) (int10_to_str(calc_week(l_time,
+				   (spec == 'V' ?
+				    (WEEK_YEAR | WEEK_FIRST_WEEKDAY) :
+				    (WEEK_YEAR | WEEK_MONDAY_FIRST)),
+				   &year),
+			 intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 2, '0');
+  }
+  break;
+  case 'x':
+  case 'X':
+  {
+    uint year;
+    if (type == MYSQL_TIMESTAMP_TIME)
+      return 1;
+    (void) calc_week(l_time,
+		     (spec == 'X' ?
+		      WEEK_YEAR | WEEK_FIRST_WEEKDAY :
+		      WEEK_YEAR | WEEK_MONDAY_FIRST),
+		     &year);
+    length= (uint) (int10_to_str(year, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 4, '0');
+  }
+  break;
+  case 'w':
+    if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
+      return 1;
+    weekday=calc_weekday(calc_daynr(l_time->year,l_time->month,
+				    l_time->day),1);
+    length= (uint) (int10_to_str(weekday, intbuff, 10) - intbuff);
+    str->append_with_prefill(intbuff, length, 1, '0');
+    break;
+
+  default:
+    str->append(spec);
+    break;
+  }
+  return 0;
+}
+
+
+/**
+  Create a formatted date/time value in a string.
+*/
+
+static bool make_date_time(const String *format, const MYSQL_TIME *l_time,
+                           timestamp_type type, const MY_LOCALE *locale,
+                           String *str)
+{
   const char *ptr, *end;
 
   str->length(0);
@@ -493,217 +715,79 @@ static bool make_date_time(const String *format, const MYSQL_TIME *l_time,
   {
     if (*ptr != '%' || ptr+1 == end)
       str->append(*ptr);
-    else
-    {
-      switch (*++ptr) {
-      case 'M':
-        if (type == MYSQL_TIMESTAMP_TIME || !l_time->month)
-          return 1;
-        str->append(locale->month_names->type_names[l_time->month-1],
-                    (uint) strlen(locale->month_names->type_names[l_time->month-1]),
-                    system_charset_info);
-        break;
-      case 'b':
-        if (type == MYSQL_TIMESTAMP_TIME || !l_time->month)
-          return 1;
-        str->append(locale->ab_month_names->type_names[l_time->month-1],
-                    (uint) strlen(locale->ab_month_names->type_names[l_time->month-1]),
-                    system_charset_info);
-        break;
-      case 'W':
-        if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
-          return 1;
-        weekday= calc_weekday(calc_daynr(l_time->year,l_time->month,
-                              l_time->day),0);
-        str->append(locale->day_names->type_names[weekday],
-                    (uint) strlen(locale->day_names->type_names[weekday]),
-                    system_charset_info);
-        break;
-      case 'a':
-        if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
-          return 1;
-        weekday=calc_weekday(calc_daynr(l_time->year,l_time->month,
-                             l_time->day),0);
-        str->append(locale->ab_day_names->type_names[weekday],
-                    (uint) strlen(locale->ab_day_names->type_names[weekday]),
-                    system_charset_info);
-        break;
-      case 'D':
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	if (l_time->day >= 10 &&  l_time->day <= 19)
-	  str->append(STRING_WITH_LEN("th"));
-	else
-	{
-	  switch (l_time->day %10) {
-	  case 1:
-	    str->append(STRING_WITH_LEN("st"));
-	    break;
-	  case 2:
-	    str->append(STRING_WITH_LEN("nd"));
-	    break;
-	  case 3:
-	    str->append(STRING_WITH_LEN("rd"));
-	    break;
-	  default:
-	    str->append(STRING_WITH_LEN("th"));
-	    break;
-	  }
-	}
-	break;
-      case 'Y':
-        if (type == MYSQL_TIMESTAMP_TIME)
-          return 1;
-	length= (uint) (int10_to_str(l_time->year, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 4, '0');
-	break;
-      case 'y':
-        if (type == MYSQL_TIMESTAMP_TIME)
-          return 1;
-	length= (uint) (int10_to_str(l_time->year%100, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'm':
-        if (type == MYSQL_TIMESTAMP_TIME)
-          return 1;
-	length= (uint) (int10_to_str(l_time->month, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'c':
-        if (type == MYSQL_TIMESTAMP_TIME)
-          return 1;
-	length= (uint) (int10_to_str(l_time->month, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	break;
-      case 'd':
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'e':
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	length= (uint) (int10_to_str(l_time->day, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	break;
-      case 'f':
-	length= (uint) (int10_to_str(l_time->second_part, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 6, '0');
-	break;
-      case 'H':
-	length= (uint) (int10_to_str(l_time->hour, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'h':
-      case 'I':
-	hours_i= (l_time->hour%24 + 11)%12+1;
-	length= (uint) (int10_to_str(hours_i, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'i':					/* minutes */
-	length= (uint) (int10_to_str(l_time->minute, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'j':
-	if (type == MYSQL_TIMESTAMP_TIME || !l_time->month || !l_time->year)
-	  return 1;
-	length= (uint) (int10_to_str(calc_daynr(l_time->year,l_time->month,
-					l_time->day) - 
-		     calc_daynr(l_time->year,1,1) + 1, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 3, '0');
-	break;
-      case 'k':
-	length= (uint) (int10_to_str(l_time->hour, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	break;
-      case 'l':
-	hours_i= (l_time->hour%24 + 11)%12+1;
-	length= (uint) (int10_to_str(hours_i, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	break;
-      case 'p':
-	hours_i= l_time->hour%24;
-	str->append(hours_i < 12 ? "AM" : "PM",2);
-	break;
-      case 'r':
-	length= sprintf(intbuff, ((l_time->hour % 24) < 12) ?
-                    "%02d:%02d:%02d AM" : "%02d:%02d:%02d PM",
-		    (l_time->hour+11)%12+1,
-		    l_time->minute,
-		    l_time->second);
-	str->append(intbuff, length);
-	break;
-      case 'S':
-      case 's':
-	length= (uint) (int10_to_str(l_time->second, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-	break;
-      case 'T':
-	length= sprintf(intbuff, "%02d:%02d:%02d",
-		    l_time->hour, l_time->minute, l_time->second);
-	str->append(intbuff, length);
-	break;
-      case 'U':
-      case 'u':
-      {
-	uint year;
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	length= (uint) (int10_to_str(calc_week(l_time,
-				       (*ptr) == 'U' ?
-				       WEEK_FIRST_WEEKDAY : WEEK_MONDAY_FIRST,
-				       &year),
-			     intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-      }
-      break;
-      case 'v':
-      case 'V':
-      {
-	uint year;
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	length= (uint) (int10_to_str(calc_week(l_time,
-				       ((*ptr) == 'V' ?
-					(WEEK_YEAR | WEEK_FIRST_WEEKDAY) :
-					(WEEK_YEAR | WEEK_MONDAY_FIRST)),
-				       &year),
-			     intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 2, '0');
-      }
-      break;
-      case 'x':
-      case 'X':
-      {
-	uint year;
-	if (type == MYSQL_TIMESTAMP_TIME)
-	  return 1;
-	(void) calc_week(l_time,
-			 ((*ptr) == 'X' ?
-			  WEEK_YEAR | WEEK_FIRST_WEEKDAY :
-			  WEEK_YEAR | WEEK_MONDAY_FIRST),
-			 &year);
-	length= (uint) (int10_to_str(year, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 4, '0');
-      }
-      break;
-      case 'w':
-	if (type == MYSQL_TIMESTAMP_TIME || !(l_time->month || l_time->year))
-	  return 1;
-	weekday=calc_weekday(calc_daynr(l_time->year,l_time->month,
-					l_time->day),1);
-	length= (uint) (int10_to_str(weekday, intbuff, 10) - intbuff);
-	str->append_with_prefill(intbuff, length, 1, '0');
-	break;
+    else if (append_date_time_spec(*++ptr, l_time, type, locale, str))
+      return 1;
+  }
+  return 0;
+}
 
-      default:
-	str->append(*ptr);
-	break;
-      }
+
+/**
+  Split a DATE_FORMAT() format string into steps, each one being a run
+  of literal characters optionally followed by a conversion specifier.
+
+  This is done once for a constant format, so that evaluation for every
+  row only appends the literal runs and the converted values.
+
+  @return the steps allocated on mem_root, or NULL on out of memory
+*/
+
+static Date_format_step *compile_date_format(MEM_ROOT *mem_root,
+                                             const String *format,
+                                             uint *step_count)
+{
+  const char *ptr, *end;
+  Date_format_step *steps, *step;
+
+  if (!(ptr= (const char *) memdup_root(mem_root, format->ptr(),
+                                        format->length())) ||
+      !(steps= step= (Date_format_step *)
+        alloc_root(mem_root,
+                   sizeof(Date_format_step) * (format->length() / 2 + 1))))
+    return NULL;
+
+  end= ptr + format->length();
+  while (ptr != end)
+  {
+    step->literal= ptr;
+    while (ptr != end && (*ptr != '%' || ptr + 1 == end))
+      ptr++;
+    step->literal_length= (uint) (ptr - step->literal);
+    if ((step->has_spec= ptr != end))
+    {
+      step->spec= ptr[1];
+      ptr+= 2;
     }
+    step++;
+  }
+  *step_count= (uint) (step - steps);
+  return steps;
+}
+
+
+/**
+  Create a formatted date/time value in a string from a format compiled
+  with compile_date_format().
+*/
+
+static bool make_date_time(const Date_format_step *step, uint step_count,
+                           const MYSQL_TIME *l_time, timestamp_type type,
+                           const MY_LOCALE *locale, String *str)
+{
+  const Date_format_step *end= step + step_count;
+
+  str->length(0);
+
+  if (l_time->neg)
+    str->append('-');
+
+  for (; step != end; step++)
+  {
+    if (step->literal_length)
+      str->append(step->literal, step->literal_length);
+    if (step->has_spec &&
+        append_date_time_spec(step->spec, l_time, type, locale, str))
+      return 1;
   }
   return 0;
 }
@@ -1758,10 +1842,15 @@ bool Item_func_date_format::fix_length_and_dec(THD *thd)
   collation.set(cs, arg1->collation.derivation, repertoire);
   StringBuffer<STRING_BUFFER_USUAL_SIZE> buffer;
   String *str;
+  format_steps= NULL;
   if (args[1]->basic_const_item() && (str= args[1]->val_str(&buffer)))
   {						// Optimize the normal case
     fixed_length=1;
     max_length= format_length(str) * collation.collation->mbmaxlen;
+    if (str->length() &&
+        !(format_steps= compile_date_format(thd->mem_root, str,
+                                            &format_step_count)))
+      return TRUE;
   }
   else
   {
@@ -1892,7 +1981,9 @@ String *Item_func_date_format::val_str(String *str)
                                      Temporal::Options(mode, thd))))
     return 0;
   
-  if (!(format= args[1]->val_str(&format_buffer)) || !format->length())
+  if (format_steps)
+    format= NULL;                          // The format is precompiled
+  else if (!(format= args[1]->val_str(&format_buffer)) || !format->length())
     goto null_date;
 
   if (!is_time_format && !(lc= locale) && !(lc= args[2]->locale_from_val_str()))
@@ -1912,7 +2003,12 @@ String *Item_func_date_format::val_str(String *str)
 
   /* Create the result string */
   str->set_charset(collation.collation);
-  if (!make_date_time(format, &l_time,
+  if (format_steps ?
+      !make_date_time(format_steps, format_step_count, &l_time,
+                      is_time_format ? MYSQL_TIMESTAMP_TIME :
+                                       MYSQL_TIMESTAMP_DATE,
+                      lc, str) :
+      !make_date_time(format, &l_time,
                       is_time_format ? MYSQL_TIMESTAMP_TIME :
                                        MYSQL_TIMESTAMP_DATE,
                       lc, str))
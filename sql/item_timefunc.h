@@ -926,6 +926,19 @@ class Item_func_from_days :public Item_datefunc
 };
 
 
+/*
+  A step of a compiled DATE_FORMAT() format: a run of literal characters
+  followed by an optional conversion specifier.
+*/
+struct Date_format_step
+{
+  const char *literal;
+  uint literal_length;
+  char spec;
+  bool has_spec;
+};
+
+
 class Item_func_date_format :public Item_str_func
 {
   bool check_arguments() const override
@@ -936,13 +949,18 @@ class Item_func_date_format :public Item_str_func
   const MY_LOCALE *locale;
   int fixed_length;
   String value;
+  /* Constant format string compiled by fix_length_and_dec(), or NULL */
+  Date_format_step *format_steps;
+  uint format_step_count;
 protected:
   bool is_time_format;
 public:
   Item_func_date_format(THD *thd, Item *a, Item *b):
-    Item_str_func(thd, a, b), locale(0), is_time_format(false) {}
+    Item_str_func(thd, a, b), locale(0), format_steps(0),
+    format_step_count(0), is_time_format(false) {}
   Item_func_date_format(THD *thd, Item *a, Item *b, Item *c):
-    Item_str_func(thd, a, b, c), locale(0), is_time_format(false) {}
+    Item_str_func(thd, a, b, c), locale(0), format_steps(0),
+    format_step_count(0), is_time_format(false) {}
   String *val_str(String *str) override;
   LEX_CSTRING func_name_cstring() const override
   {
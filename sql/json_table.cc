@@ -378,6 +378,117 @@ static void store_json_in_field(Field *f, const json_engine_t *je)
 }
 
 
+/*
+  @brief
+    Remembers where the keys of the JSON object that is the context node
+    of the current row are.
+
+  @detail
+    Columns with the '$.key' paths usually read the same object, and
+    each of them would otherwise scan it from the beginning. Here the
+    object is scanned once, and the positions of the keys met are
+    recorded, so the next column looks among the recorded keys first.
+    The scan only goes as far as the farthest key looked up so far.
+*/
+
+class Json_table_key_offsets
+{
+  static const uint MAX_KEYS= 64;
+
+  CHARSET_INFO *m_cs;
+  const uchar *m_node_start;
+  const uchar *m_node_end;
+  json_engine_t m_je;   /* Scans the object, stays on the last key met */
+  bool m_is_object;
+  bool m_scan_done;
+  /* Positions of the key names (right after the opening quote) */
+  const uchar *m_keys[MAX_KEYS];
+  uint m_n_keys;
+
+  bool key_matches(const uchar *key, const json_path_t *path,
+                   json_engine_t *je)
+  {
+    const json_path_step_t *step= path->last_step;
+    json_string_t key_name;
+
+    json_string_set_cs(&key_name, path->s.cs);
+    json_string_set_str(&key_name, step->key, step->key_end);
+    json_scan_start(je, m_cs, key, m_node_end);
+    je->state= JST_KEY;
+    return json_key_matches(je, &key_name);
+  }
+
+  /*
+    Moves the scan to the next key, skipping the value of the current one.
+    Returns TRUE if there are no more keys, or the JSON is broken.
+  */
+  bool next_key()
+  {
+    if (m_je.state == JST_KEY && json_skip_key(&m_je))
+      return true;
+    return json_scan_next(&m_je) || m_je.state != JST_KEY;
+  }
+
+  void start(CHARSET_INFO *cs, const uchar *node_start, const uchar *node_end)
+  {
+    m_cs= cs;
+    m_node_start= node_start;
+    m_node_end= node_end;
+    m_n_keys= 0;
+    json_scan_start(&m_je, cs, node_start, node_end);
+    m_is_object= !json_read_value(&m_je) &&
+                 m_je.value_type == JSON_VALUE_OBJECT;
+    m_scan_done= !m_is_object;
+  }
+
+public:
+  Json_table_key_offsets(): m_node_start(NULL) {}
+
+  /*
+    @brief
+      Look up the key of the '$.key' path in the object.
+
+    @return
+      -1  The path is not a single key step, or the node is not
+          an object, or the key is not among the recorded ones
+          and no more can be recorded. The caller should use
+          json_find_path().
+       0  Found, je is set up to read the value.
+       1  No such key.
+  */
+  int find(CHARSET_INFO *cs, const uchar *node_start, const uchar *node_end,
+           const json_path_t *path, json_engine_t *je)
+  {
+    if (path->last_step != path->steps + 1 ||
+        path->last_step->type != JSON_PATH_KEY)
+      return -1;
+
+    if (node_start != m_node_start || node_end != m_node_end || cs != m_cs)
+      start(cs, node_start, node_end);
+    if (!m_is_object)
+      return -1;
+
+    for (uint i= 0; i < m_n_keys; i++)
+    {
+      if (key_matches(m_keys[i], path, je))
+        return json_read_value(je);
+    }
+
+    while (!m_scan_done)
+    {
+      if (m_n_keys == MAX_KEYS)
+        return -1;
+      if ((m_scan_done= next_key()))
+        break;
+      m_keys[m_n_keys++]= m_je.s.c_str;
+      if (key_matches(m_je.s.c_str, path, je))
+        return json_read_value(je);
+    }
+    return 1;
+  }
+};
+
+
 bool Json_table_nested_path::check_error(const char *str)
 {
   if (m_engine.s.error)
@@ -440,6 +551,7 @@ int ha_json_table::fill_column_values(THD *thd, uchar * buf, uchar *pos)
   Field **f= table->field;
   Json_table_column *jc;
   List_iterator_fast<Json_table_column> jc_i(m_jt->m_columns);
+  Json_table_key_offsets key_offsets;
   my_ptrdiff_t ptrdiff= buf - table->record[0];
   Abort_on_warning_instant_set ao_set(table->in_use, FALSE);
   enum_check_fields cf_orig= table->in_use->count_cuted_fields;
@@ -524,11 +636,15 @@ int ha_json_table::fill_column_values(THD *thd, uchar * buf, uchar *pos)
           node_end=   jc->m_nest->get_value_end();
         }
 
-        json_scan_start(&je, m_js->charset(), node_start, node_end);
-
         cur_step= jc->m_path.steps;
-        not_found= json_find_path(&je, &jc->m_path, &cur_step, array_counters) ||
-                   json_read_value(&je);
+        if ((not_found= key_offsets.find(m_js->charset(), node_start,
+                                         node_end, &jc->m_path, &je)) < 0)
+        {
+          json_scan_start(&je, m_js->charset(), node_start, node_end);
+          not_found= json_find_path(&je, &jc->m_path, &cur_step,
+                                    array_counters) ||
+                     json_read_value(&je);
+        }
 
         if (jc->m_column_type == Json_table_column::EXISTS_PATH)
         {
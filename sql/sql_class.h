@@ -706,6 +706,7 @@ typedef struct system_variables
   ulong column_compression_zlib_strategy;
   ulong lock_wait_timeout;
   ulong join_cache_level;
+  ulong load_data_parse_threads;
   ulong max_allowed_packet;
   ulong max_error_count;
   ulong max_length_for_sort_data;
@@ -939,6 +940,8 @@ typedef struct system_status_var
   ulong filesort_rows_;
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
+  ulong regexp_cache_hits;          /* +1 reusing an earlier compiled pattern */
+  ulong regexp_compilations;        /* +1 compiling a REGEXP pattern */
 
   /* Features used */
   ulong feature_custom_aggregate_functions; /* +1 when custom aggregate
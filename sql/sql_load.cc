@@ -101,6 +101,11 @@ class Term_string
 #define GET (stack_pos != stack ? *--stack_pos : my_b_get(&cache))
 #define PUSH(A) *(stack_pos++)=(A)
 
+/* Size of the pieces a file is split into by LOAD DATA parse threads */
+#define LOAD_DATA_CHUNK_SIZE (1024*1024)
+
+class Load_data_parallel;
+
 #ifdef WITH_WSREP
 /** If requested by wsrep_load_data_splitting and streaming replication is
     not enabled, replicate a streaming fragment every 10,000 rows.*/
@@ -147,6 +152,7 @@ class READ_INFO: public Load_data_param
   int	enclosed_char,escape_char;
   int	*stack,*stack_pos;
   bool	found_end_of_line,start_of_line,eof;
+  bool  helper;                         /* Used by a LOAD DATA parse thread */
   int level; /* for load xml */
 
   bool getbyte(char *to)
@@ -226,10 +232,13 @@ class READ_INFO: public Load_data_param
   uchar	*row_start,			/* Found row starts here */
 	*row_end;			/* Found row ends here */
   LOAD_FILE_IO_CACHE cache;
+  /* If set, fields come from rows split by LOAD DATA parse threads */
+  Load_data_parallel *parallel;
 
   READ_INFO(THD *thd, File file, const Load_data_param &param,
 	    String &field_term,String &line_start,String &line_term,
-	    String &enclosed,int escape,bool get_it_from_net, bool is_fifo);
+	    String &enclosed,int escape,bool get_it_from_net, bool is_fifo,
+            my_off_t start= 0);
   ~READ_INFO();
   int read_field();
   int read_fixed_length(void);
@@ -248,7 +257,11 @@ class READ_INFO: public Load_data_param
   int clear_level(int level);
 
   my_off_t file_length() { return cache.end_of_file; }
-  my_off_t position()    { return my_b_tell(&cache); }
+  inline my_off_t position();
+  /* Offset of the next byte read_field() or next_line() will look at */
+  my_off_t read_position()
+  { return my_b_tell(&cache) - (my_off_t) (stack_pos - stack); }
+  bool has_line_term() const { return m_line_term.length() != 0; }
 
   /**
     skip all data till the eof.
@@ -260,6 +273,113 @@ class READ_INFO: public Load_data_param
   }
 };
 
+/**
+  Splits a server side file into rows with helper threads.
+
+  The file after the skipped lines is divided into chunks of
+  LOAD_DATA_CHUNK_SIZE bytes. A parse thread starts a chunk after the first
+  line terminator it finds there and parses rows with its own READ_INFO until
+  a row starts in the next chunk, storing the unescaped fields of each row.
+  The statement thread replays the stored rows through READ_INFO::read_field()
+  and READ_INFO::next_line() in file order, so value conversion, triggers,
+  auto-increment and write_record() work exactly as in a serial load.
+
+  A line terminator inside an enclosed or escaped value can make a parse
+  thread start its chunk in the middle of a row. Such a chunk does not start
+  where the previous chunk ended, and the statement thread parses it again
+  from the right position.
+*/
+
+class Load_data_parallel
+{
+  /* Header of a stored row: start offset, data length, fields, flags */
+  static const uint ROW_HEADER_SIZE= 8 + 4 + 4 + 1;
+  /* Header of a stored field: length, flags. The value is 0 terminated */
+  static const uint FIELD_HEADER_SIZE= 4 + 1;
+  enum { ROW_LINE_CUTED= 1, ROW_EOF= 2 };
+  enum { FIELD_ENCLOSED= 1, FIELD_NULL= 2 };
+
+  struct Chunk
+  {
+    String rows;                        /* Parsed rows */
+    ulonglong number;                   /* Chunk the buffer is used for */
+    my_off_t start;                     /* Offset of the first row */
+    my_off_t next_row;                  /* Offset of the row after the last */
+    bool ready;                         /* Set when the rows are parsed */
+    bool eof;                           /* The last row ends the file */
+    bool error;                         /* Out of memory */
+  };
+
+  struct Worker
+  {
+    Load_data_parallel *owner;
+    pthread_t thread;
+    File file;
+    uint id;
+    bool started;
+  };
+
+  const Load_data_param m_param;
+  String *m_field_term, *m_line_start, *m_line_term, *m_enclosed;
+  int m_escape;
+  uint m_fields;                        /* Fields to read from a row */
+  my_off_t m_base;                      /* Offset of the first chunk */
+  my_off_t m_chunk_size;
+
+  Worker *m_workers;
+  uint m_threads;
+  Chunk *m_chunks;
+  uint m_chunk_count;                   /* Two chunk buffers per thread */
+  File m_file;                          /* For chunks parsed again */
+  mysql_mutex_t m_lock;
+  mysql_cond_t m_cond;
+  bool m_running;                       /* Mutex and threads exist */
+  bool m_abort;
+
+  /* Replay state of the statement thread */
+  Chunk *m_chunk;
+  ulonglong m_chunk_nr;
+  const char *m_pos, *m_end, *m_row_end;
+  my_off_t m_position;
+  uint m_fields_left;
+  uchar m_row_flags;
+  bool m_in_row;
+  bool m_done;                          /* All rows replayed or error */
+
+  static void *parse_thread(void *arg);
+  void run(Worker *worker);
+  bool parse_chunk(Chunk *chunk, File file, ulonglong nr, my_off_t start);
+  bool fetch_chunk();
+
+public:
+  Load_data_parallel(const Load_data_param &param,
+                     String &field_term, String &line_start,
+                     String &line_term, String &enclosed, int escape,
+                     uint fields)
+    :m_param(param), m_field_term(&field_term), m_line_start(&line_start),
+     m_line_term(&line_term), m_enclosed(&enclosed), m_escape(escape),
+     m_fields(fields), m_base(0), m_chunk_size(LOAD_DATA_CHUNK_SIZE),
+     m_workers(NULL), m_threads(0), m_chunks(NULL), m_chunk_count(0),
+     m_file(-1), m_running(false), m_abort(false), m_chunk(NULL),
+     m_chunk_nr(0), m_pos(NULL), m_end(NULL), m_row_end(NULL),
+     m_position(0), m_fields_left(0), m_row_flags(0), m_in_row(false),
+     m_done(false)
+  {}
+  ~Load_data_parallel() { stop(); }
+  bool start(const char *name, my_off_t base, my_off_t file_length,
+             uint threads);
+  void stop();
+  int read_field(READ_INFO *info);
+  int next_line(READ_INFO *info);
+  my_off_t position() const { return m_position; }
+};
+
+
+inline my_off_t READ_INFO::position()
+{
+  return parallel ? parallel->position() : my_b_tell(&cache);
+}
+
 static int read_fixed_length(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
                              List<Item> &fields_vars, List<Item> &set_fields,
                              List<Item> &set_values, READ_INFO &read_info,
@@ -283,6 +403,33 @@ static bool write_execute_load_query_log_event(THD *, const sql_exchange*, const
 #endif /* EMBEDDED_LIBRARY */
 
 
+/**
+  Check if the rows of LOAD DATA can be split by parse threads.
+
+  The file must be a regular server side file with a line terminator.
+  With statement based logging the file is written to the binary log
+  from the READ_INFO read buffer, so all of it has to be read there.
+  The lines of IGNORE n LINES have already been read by the caller, and
+  the chunks start after them.
+*/
+
+static bool load_data_can_parse_in_parallel(THD *thd, const sql_exchange *ex,
+                                            READ_INFO &read_info,
+                                            bool read_file_from_client,
+                                            bool is_fifo)
+{
+  if (read_file_from_client || is_fifo ||
+      ex->filetype == FILETYPE_XML || read_info.is_fixed_length() ||
+      !read_info.has_line_term() || read_info.error)
+    return false;
+#ifndef EMBEDDED_LIBRARY
+  if (mysql_bin_log.is_open() && !thd->is_current_stmt_binlog_format_row())
+    return false;
+#endif
+  return true;
+}
+
+
 bool Load_data_param::add_outvar_field(THD *thd, const Field *field)
 {
   if (field->flags & BLOB_FLAG)
@@ -617,6 +764,9 @@ int mysql_load(THD *thd, const sql_exchange *ex, TABLE_LIST *table_list,
       mysql_file_close(file, MYF(0));           // no files in net reading
     DBUG_RETURN(TRUE);				// Can't allocate buffers
   }
+  Load_data_parallel parallel(param, *ex->field_term, *ex->line_start,
+                              *ex->line_term, *ex->enclosed,
+                              info.escape_char, fields_vars.elements);
 
 #ifndef EMBEDDED_LIBRARY
   if (mysql_bin_log.is_open())
@@ -641,6 +791,21 @@ int mysql_load(THD *thd, const sql_exchange *ex, TABLE_LIST *table_list,
 	break;
     }
   }
+  /* skip_lines is not 0 here only if the file ended in the ignored lines */
+  if (thd->variables.load_data_parse_threads > 1 && !skip_lines &&
+      load_data_can_parse_in_parallel(thd, ex, read_info,
+                                      read_file_from_client, is_fifo) &&
+      !parallel.start(name, read_info.read_position(),
+                      read_info.file_length(),
+                      (uint) thd->variables.load_data_parse_threads))
+    read_info.parallel= &parallel;
+  DBUG_EXECUTE_IF("load_data_parallel_required",
+                  if (!read_info.parallel)
+                  {
+                    my_error(ER_INTERNAL_ERROR, MYF(0),
+                             "LOAD DATA was not split by parse threads");
+                    read_info.error= true;
+                  });
 
   thd_proc_info(thd, "Reading file");
   if (likely(!(error= MY_TEST(read_info.error))))
@@ -688,6 +853,11 @@ int mysql_load(THD *thd, const sql_exchange *ex, TABLE_LIST *table_list,
       error= read_sep_field(thd, info, table_list, fields_vars,
                             set_fields, set_values, read_info,
                             *ex->enclosed, skip_lines, ignore);
+    if (read_info.parallel)
+    {
+      parallel.stop();
+      read_info.parallel= NULL;
+    }
 
     if (table_list->table->file->ha_table_flags() & HA_DUPLICATE_POS)
       table_list->table->file->ha_rnd_end();
@@ -1343,6 +1513,9 @@ READ_INFO::unescape(char chr)
 /*
   Read a line using buffering
   If last line is empty (in line mode) then it isn't outputed
+
+  thd is NULL when the object is used by a LOAD DATA parse thread,
+  which reads the file from offset "start".
 */
 
 
@@ -1350,14 +1523,15 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
                      const Load_data_param &param,
 		     String &field_term, String &line_start, String &line_term,
 		     String &enclosed_par, int escape, bool get_it_from_net,
-		     bool is_fifo)
+		     bool is_fifo, my_off_t start)
   :Load_data_param(param),
    file(file_par),
    m_field_term(field_term), m_line_term(line_term), m_line_start(line_start),
-   escape_char(escape), found_end_of_line(false), eof(false),
-   error(false), line_cuted(false), found_null(false)
+   escape_char(escape), found_end_of_line(false), eof(false), helper(!thd),
+   error(false), line_cuted(false), found_null(false), parallel(NULL)
 {
-  data.set_thread_specific();
+  if (!helper)
+    data.set_thread_specific();
   /*
     Field and line terminators must be interpreted as sequence of unsigned char.
     Otherwise, non-ascii terminators will be negative on some platforms,
@@ -1375,17 +1549,22 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
   uint length= MY_MAX(charset()->mbmaxlen, MY_MAX(m_field_term.length(),
                                                   m_line_term.length())) + 1;
   set_if_bigger(length,line_start.length());
-  stack= stack_pos= (int*) thd->alloc(sizeof(int) * length);
+  if (helper)
+    stack= (int*) my_malloc(PSI_INSTRUMENT_ME, sizeof(int) * length,
+                            MYF(MY_WME));
+  else
+    stack= (int*) thd->alloc(sizeof(int) * length);
+  stack_pos= stack;
 
   DBUG_ASSERT(m_fixed_length < UINT_MAX32);
-  if (data.reserve((size_t) m_fixed_length))
+  if (!stack || data.reserve((size_t) m_fixed_length))
     error=1; /* purecov: inspected */
   else
   {
     if (init_io_cache(&cache,(get_it_from_net) ? -1 : file, 0,
 		      (get_it_from_net) ? READ_NET :
-		      (is_fifo ? READ_FIFO : READ_CACHE),0L,1,
-		      MYF(MY_WME | MY_THREAD_SPECIFIC)))
+		      (is_fifo ? READ_FIFO : READ_CACHE),start,1,
+		      MYF(MY_WME | (helper ? 0 : MY_THREAD_SPECIFIC))))
     {
       error=1;
     }
@@ -1395,7 +1574,7 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
       if (get_it_from_net)
 	cache.read_function = _my_b_net_read;
 
-      if (mysql_bin_log.is_open())
+      if (mysql_bin_log.is_open() && !helper)
       {
         cache.real_read_function= cache.read_function;
         cache.read_function= log_loaded_block;
@@ -1409,6 +1588,8 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
 READ_INFO::~READ_INFO()
 {
   ::end_io_cache(&cache);
+  if (helper)
+    my_free(stack);
   List_iterator<XML_TAG> xmlit(taglist);
   XML_TAG *t;
   while ((t= xmlit++))
@@ -1488,6 +1669,8 @@ int READ_INFO::read_field()
 {
   int chr,found_enclosed_char;
 
+  if (parallel)
+    return parallel->read_field(this);
   found_null=0;
   if (found_end_of_line)
     return 1;					// One have to call next_line
@@ -1687,6 +1870,8 @@ int READ_INFO::read_fixed_length()
 
 int READ_INFO::next_line()
 {
+  if (parallel)
+    return parallel->next_line(this);
   line_cuted=0;
   start_of_line= m_line_start.length() != 0;
   if (found_end_of_line || eof)
@@ -1786,6 +1971,368 @@ bool READ_INFO::find_start_of_fields()
 }
 
 
+/**
+  Start the parse threads.
+
+  @param name         file to load
+  @param base         offset of the first row to load
+  @param file_length  length of the file
+  @param threads      number of parse threads to use
+
+  @retval false  Threads are running, rows are read through read_field()
+  @retval true   The file is too small or the threads could not be started,
+                 the file should be read serially
+*/
+
+bool Load_data_parallel::start(const char *name, my_off_t base,
+                               my_off_t file_length, uint threads)
+{
+  ulonglong chunks;
+  DBUG_ENTER("Load_data_parallel::start");
+
+  DBUG_EXECUTE_IF("load_data_small_chunks", m_chunk_size= 64;);
+  if (file_length <= base || file_length - base <= m_chunk_size)
+    DBUG_RETURN(true);
+  chunks= (file_length - base + m_chunk_size - 1) / m_chunk_size;
+  m_threads= (uint) MY_MIN(threads, chunks);
+  m_chunk_count= m_threads * 2;
+  m_base= base;
+
+  if (!(m_workers= (Worker*) my_malloc(PSI_INSTRUMENT_ME,
+                                       sizeof(Worker) * m_threads,
+                                       MYF(MY_WME | MY_ZEROFILL))))
+    DBUG_RETURN(true);
+  for (uint i= 0; i < m_threads; i++)
+    m_workers[i].file= -1;
+  if (!(m_chunks= new Chunk[m_chunk_count]))
+    goto err;
+  for (uint i= 0; i < m_chunk_count; i++)
+  {
+    m_chunks[i].number= i;
+    m_chunks[i].ready= false;
+  }
+  if ((m_file= mysql_file_open(key_file_load, name, O_RDONLY,
+                               MYF(MY_WME))) < 0)
+    goto err;
+  for (uint i= 0; i < m_threads; i++)
+  {
+    Worker *worker= m_workers + i;
+    worker->owner= this;
+    worker->id= i;
+    if ((worker->file= mysql_file_open(key_file_load, name, O_RDONLY,
+                                       MYF(MY_WME))) < 0)
+      goto err;
+  }
+
+  mysql_mutex_init(key_LOCK_load_data, &m_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_load_data, &m_cond, NULL);
+  m_running= true;
+  for (uint i= 0; i < m_threads; i++)
+  {
+    Worker *worker= m_workers + i;
+    if (mysql_thread_create(key_thread_load_data, &worker->thread, NULL,
+                            parse_thread, worker))
+    {
+      stop();
+      DBUG_RETURN(true);
+    }
+    worker->started= true;
+  }
+  DBUG_PRINT("info", ("threads: %u  chunks: %llu", m_threads, chunks));
+  DBUG_RETURN(false);
+
+err:
+  stop();
+  DBUG_RETURN(true);
+}
+
+
+/**
+  Stop the parse threads and free the chunk buffers
+*/
+
+void Load_data_parallel::stop()
+{
+  if (!m_workers)
+    return;
+  if (m_running)
+  {
+    mysql_mutex_lock(&m_lock);
+    m_abort= true;
+    mysql_cond_broadcast(&m_cond);
+    mysql_mutex_unlock(&m_lock);
+    for (uint i= 0; i < m_threads; i++)
+    {
+      if (m_workers[i].started)
+        pthread_join(m_workers[i].thread, NULL);
+    }
+    mysql_cond_destroy(&m_cond);
+    mysql_mutex_destroy(&m_lock);
+    m_running= false;
+  }
+  for (uint i= 0; i < m_threads; i++)
+  {
+    if (m_workers[i].file >= 0)
+      mysql_file_close(m_workers[i].file, MYF(0));
+  }
+  if (m_file >= 0)
+    mysql_file_close(m_file, MYF(0));
+  delete [] m_chunks;
+  my_free(m_workers);
+  m_workers= NULL;
+  m_chunks= NULL;
+  m_chunk= NULL;
+  m_file= -1;
+}
+
+
+void *Load_data_parallel::parse_thread(void *arg)
+{
+  Worker *worker= (Worker*) arg;
+  my_thread_init();
+  worker->owner->run(worker);
+  my_thread_end();
+  return NULL;
+}
+
+
+/**
+  Parse the chunks of a parse thread: number id, id + threads, ...
+
+  A chunk buffer is reused for the chunk m_chunk_count further on when
+  the statement thread has replayed its rows. The thread continues after
+  a chunk that ended the file, as the statement thread may parse that
+  chunk again and then need the following ones; chunks after the end of
+  the file are empty. It stops when stop() is called.
+*/
+
+void Load_data_parallel::run(Worker *worker)
+{
+  for (ulonglong nr= worker->id; ; nr+= m_threads)
+  {
+    Chunk *chunk= m_chunks + nr % m_chunk_count;
+    mysql_mutex_lock(&m_lock);
+    while (chunk->number != nr && !m_abort)
+      mysql_cond_wait(&m_cond, &m_lock);
+    bool abort= m_abort;
+    mysql_mutex_unlock(&m_lock);
+    if (abort)
+      break;
+
+    parse_chunk(chunk, worker->file, nr, HA_POS_ERROR);
+
+    mysql_mutex_lock(&m_lock);
+    chunk->ready= true;
+    mysql_cond_broadcast(&m_cond);
+    mysql_mutex_unlock(&m_lock);
+    if (chunk->error)
+      break;
+  }
+}
+
+
+/**
+  Parse the rows starting in chunk nr into chunk->rows
+
+  @param chunk  buffer for the rows
+  @param file   file to read
+  @param nr     number of the chunk
+  @param start  offset of the first row, HA_POS_ERROR to start after the
+                first line terminator in the chunk
+
+  @return chunk->error
+*/
+
+bool Load_data_parallel::parse_chunk(Chunk *chunk, File file, ulonglong nr,
+                                     my_off_t start)
+{
+  my_off_t begin= m_base + nr * m_chunk_size;
+  my_off_t end= begin + m_chunk_size;
+  bool find_start= start == HA_POS_ERROR;
+
+  chunk->rows.length(0);
+  chunk->eof= chunk->error= false;
+  if (find_start)
+  {
+    /*
+      Start so far before the chunk that a line terminator ending exactly
+      at the chunk border is found
+    */
+    start= nr ? begin - MY_MIN(m_line_term->length(), begin - m_base) : begin;
+  }
+
+  READ_INFO info(NULL, file, m_param, *m_field_term, *m_line_start,
+                 *m_line_term, *m_enclosed, m_escape, false, false, start);
+  if (info.error)
+    return (chunk->error= true);
+  if (find_start && nr && info.next_line())
+  {
+    chunk->start= chunk->next_row= info.read_position();
+    chunk->eof= true;
+    return false;
+  }
+  chunk->start= info.read_position();
+
+  for (;;)
+  {
+    my_off_t row= info.read_position();
+    uint fields;
+    size_t header;
+    uchar flags= 0;
+
+    if (row >= end)
+    {
+      chunk->next_row= row;
+      break;
+    }
+    header= chunk->rows.length();
+    if (chunk->rows.reserve(ROW_HEADER_SIZE))
+      return (chunk->error= true);
+    chunk->rows.length(header + ROW_HEADER_SIZE);
+
+    for (fields= 0; fields < m_fields && !info.read_field(); fields++)
+    {
+      uint length= (uint) (info.row_end - info.row_start);
+      char field_header[FIELD_HEADER_SIZE];
+      int4store(field_header, length);
+      field_header[4]= (char) ((info.enclosed ? FIELD_ENCLOSED : 0) |
+                               (info.found_null ? FIELD_NULL : 0));
+      if (chunk->rows.append(field_header, FIELD_HEADER_SIZE) ||
+          chunk->rows.append((const char*) info.row_start, length) ||
+          chunk->rows.append('\0'))
+        return (chunk->error= true);
+    }
+    if (info.error)
+      return (chunk->error= true);
+    if (!fields)
+    {
+      /* End of file */
+      chunk->rows.length(header);
+      chunk->next_row= row;
+      chunk->eof= true;
+      break;
+    }
+
+    bool last= info.next_line();
+    if (info.line_cuted)
+      flags|= ROW_LINE_CUTED;
+    if (last)
+      flags|= ROW_EOF;
+    char *to= (char*) chunk->rows.ptr() + header;
+    int8store(to, row);
+    int4store(to + 8, chunk->rows.length() - header - ROW_HEADER_SIZE);
+    int4store(to + 12, fields);
+    to[16]= (char) flags;
+    if (last)
+    {
+      chunk->next_row= info.read_position();
+      chunk->eof= true;
+      break;
+    }
+  }
+  return false;
+}
+
+
+/**
+  Make the rows of the next chunk current
+
+  @retval false  ok
+  @retval true   no more rows or error
+*/
+
+bool Load_data_parallel::fetch_chunk()
+{
+  my_off_t expected= m_base;
+  Chunk *chunk;
+
+  if (m_chunk)
+  {
+    bool eof= m_chunk->eof;
+    expected= m_chunk->next_row;
+    mysql_mutex_lock(&m_lock);
+    m_chunk->ready= false;
+    m_chunk->number+= m_chunk_count;
+    mysql_cond_broadcast(&m_cond);
+    mysql_mutex_unlock(&m_lock);
+    m_chunk= NULL;
+    if (eof)
+      return (m_done= true);
+    m_chunk_nr++;
+  }
+
+  chunk= m_chunks + m_chunk_nr % m_chunk_count;
+  mysql_mutex_lock(&m_lock);
+  while (!chunk->ready)
+    mysql_cond_wait(&m_cond, &m_lock);
+  mysql_mutex_unlock(&m_lock);
+  DBUG_ASSERT(chunk->number == m_chunk_nr);
+
+  if (!chunk->error && chunk->start != expected)
+  {
+    /*
+      The parse thread guessed the start of the first row wrong, because
+      a line terminator in the data was escaped or enclosed
+    */
+    DBUG_PRINT("info", ("chunk %llu parsed again from %llu",
+                        m_chunk_nr, (ulonglong) expected));
+    parse_chunk(chunk, m_file, m_chunk_nr, expected);
+  }
+  m_chunk= chunk;
+  m_pos= chunk->rows.ptr();
+  m_end= m_pos + chunk->rows.length();
+  return (m_done= chunk->error);
+}
+
+
+int Load_data_parallel::read_field(READ_INFO *info)
+{
+  info->found_null= 0;
+  if (!m_in_row)
+  {
+    while (m_pos == m_end)
+    {
+      if (m_done || fetch_chunk())
+      {
+        if (m_chunk && m_chunk->error)
+          info->error= 1;
+        return 1;
+      }
+    }
+    m_position= (my_off_t) uint8korr(m_pos);
+    m_row_end= m_pos + ROW_HEADER_SIZE + uint4korr(m_pos + 8);
+    m_fields_left= uint4korr(m_pos + 12);
+    m_row_flags= (uchar) m_pos[16];
+    m_pos+= ROW_HEADER_SIZE;
+    m_in_row= true;
+  }
+  if (!m_fields_left)
+    return 1;
+  m_fields_left--;
+
+  uint length= uint4korr(m_pos);
+  uchar flags= (uchar) m_pos[4];
+  info->row_start= (uchar*) m_pos + FIELD_HEADER_SIZE;
+  info->row_end= info->row_start + length;
+  info->enclosed= MY_TEST(flags & FIELD_ENCLOSED);
+  info->found_null= MY_TEST(flags & FIELD_NULL);
+  m_pos+= FIELD_HEADER_SIZE + length + 1;
+  return 0;
+}
+
+
+int Load_data_parallel::next_line(READ_INFO *info)
+{
+  info->line_cuted= 0;
+  if (!m_in_row)
+    return 1;
+  m_in_row= false;
+  m_pos= m_row_end;
+  info->line_cuted= MY_TEST(m_row_flags & ROW_LINE_CUTED);
+  return MY_TEST(m_row_flags & ROW_EOF);
+}
+
+
 /*
   Clear taglist from tags with a specified level
 */
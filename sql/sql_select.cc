@@ -19959,6 +19959,22 @@ bool open_tmp_table(TABLE *table)
 }
 
 
+/*
+  Check if an internal temporary table is only appended to and then read
+  sequentially
+
+  Such tables have no keys to look up rows by, so rows are never read back
+  at random. They can be stored in a simple sequential row format and be
+  written through the row write cache instead of the page cache.
+*/
+
+static bool tmp_table_is_append_only(TABLE *table)
+{
+  return (!table->s->keys && !table->s->uniques && !table->no_rows &&
+          !table->keep_row_order && !table->rows_updated_by_position);
+}
+
+
 #ifdef USE_ARIA_FOR_TMP_TABLES
 /*
   Create internal (MyISAM or Maria) temporary table
@@ -20109,11 +20125,17 @@ bool create_internal_tmp_table(TABLE *table, KEY *keyinfo,
     we first write the row, then check for key conflicts and then we have to
     delete the row.  The cases when this can happen is when there is
     a group by and no sum functions or if distinct is used.
+    Tables without keys that are only appended to and then scanned
+    (UNION ALL, derived tables, materialized join results) gain nothing
+    from BLOCK_RECORD. DYNAMIC_RECORD lets them write and read rows
+    sequentially through the row cache, without bitmap pages, row
+    directories or the page cache.
   */
   {
     enum data_file_type file_type= table->no_rows ? NO_RECORD :
         (share->reclength < 64 && !share->blob_fields ? STATIC_RECORD :
-         table->used_for_duplicate_elimination ? DYNAMIC_RECORD : BLOCK_RECORD);
+         (table->used_for_duplicate_elimination ||
+          tmp_table_is_append_only(table)) ? DYNAMIC_RECORD : BLOCK_RECORD);
     uint create_flags= HA_CREATE_TMP_TABLE | HA_CREATE_INTERNAL_TABLE |
         (table->keep_row_order ? HA_PRESERVE_INSERT_ORDER : 0);
 
@@ -20408,6 +20430,9 @@ create_internal_tmp_table_from_heap(THD *thd, TABLE *table,
   }
   if (!new_table.no_rows && new_table.file->ha_end_bulk_insert())
     goto err;
+  /* Rows that are only appended are written through the row cache */
+  if (tmp_table_is_append_only(&new_table))
+    (void) new_table.file->extra(HA_EXTRA_WRITE_CACHE);
   /* copy row that filled HEAP table */
   if (unlikely((write_err=new_table.file->ha_write_tmp_row(table->record[0]))))
   {
@@ -20845,6 +20870,9 @@ bool instantiate_tmp_table(TABLE *table, KEY *keyinfo,
   }
   if (open_tmp_table(table))
     return TRUE;
+  if (table->s->db_type() == TMP_ENGINE_HTON &&
+      tmp_table_is_append_only(table))
+    (void) table->file->extra(HA_EXTRA_WRITE_CACHE);
 
   return FALSE;
 }
@@ -673,22 +673,10 @@ int Binary_string::strstr(const Binary_string &s, uint32 offset)
     if (!s.length())
       return ((int) offset);	// Empty string is always found
 
-    const char *str = Ptr+offset;
-    const char *search=s.ptr();
-    const char *end=Ptr+str_length-s.length()+1;
-    const char *search_end=s.ptr()+s.length();
-skip:
-    while (str != end)
-    {
-      if (*str++ == *search)
-      {
-	char *i,*j;
-	i=(char*) str; j=(char*) search+1;
-	while (j != search_end)
-	  if (*i++ != *j++) goto skip;
-	return (int) (str-Ptr) -1;
-      }
-    }
+    const uchar *str= bfind((const uchar *) Ptr + offset, str_length - offset,
+                            (const uchar *) s.ptr(), s.length());
+    if (str)
+      return (int) (str - (const uchar *) Ptr);
   }
   return -1;
 }
@@ -3143,6 +3143,8 @@ bool Window_funcs_computation::setup(THD *thd,
                                      JOIN_TAB *tab)
 {
   order_window_funcs_by_window_specs(window_funcs);
+  /* Window function values are stored back into the rows of the tmp table */
+  tab->table->rows_updated_by_position= true;
 
   SQL_SELECT *sel= NULL;
   /*
@@ -1435,6 +1435,16 @@ static Sys_var_charptr_fscs Sys_language(
        READ_ONLY GLOBAL_VAR(lc_messages_dir_ptr), CMD_LINE(REQUIRED_ARG, 'L'),
        DEFAULT(0));
 
+static Sys_var_ulong Sys_load_data_parse_threads(
+       "load_data_parse_threads",
+       "Number of threads LOAD DATA INFILE uses to split the file into "
+       "fields ahead of the statement thread. The file is read in 1M "
+       "chunks starting at line boundaries; rows are still converted and "
+       "written in file order by the statement thread. 1 disables the "
+       "helper threads. Only used for server side files",
+       SESSION_VAR(load_data_parse_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_local_infile(
        "local_infile", "Enable LOAD DATA LOCAL INFILE",
        GLOBAL_VAR(opt_local_infile), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
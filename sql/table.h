@@ -1481,6 +1481,11 @@ struct TABLE
     Forces DYNAMIC Aria row format for internal temporary tables.
   */
   bool keep_row_order;
+  /**
+    Rows of this internal temporary table are read back and updated by
+    position while the table is being processed (window functions).
+  */
+  bool rows_updated_by_position;
 
   bool no_keyread;
   /**
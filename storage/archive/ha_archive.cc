@@ -21,6 +21,7 @@
 #pragma implementation        // gcc: Class implementation
 #endif
 
+#define MYSQL_SERVER 1
 #include <my_global.h>
 #include "sql_class.h"                          // SSV
 #include "sql_table.h"                          // build_table_filename
@@ -28,9 +29,11 @@
 
 #include "ha_archive.h"
 #include "discover.h"
+#include "item_cmpfunc.h"
 #include <my_dir.h>
 
 #include <mysql/plugin.h>
+#include "lz4.h"
 
 /*
   First, if you want to understand storage engines you should look at 
@@ -103,12 +106,58 @@
   <5.1.5 - v.1
   5.1.5-5.1.15 - v.2
   >5.1.15 - v.3
+
+  COLUMNAR tables
+
+  A table created with COLUMNAR=1 keeps its rows in a separate row group
+  file (.ARG). Rows are collected in memory and written in groups of
+  ROW_GROUP_ROWS rows, or earlier when they take more than
+  archive_row_group_buffer_size bytes. Inside a group the values are
+  stored column by column, which compresses better than rows, and the
+  group is compressed with zlib or, with COMPRESSION_ALGORITHM=LZ4, with
+  LZ4. For every integer, DATE and DATETIME column the group header has
+  the minimum and maximum value (a zone map). A table scan uses
+  comparisons with constants from the pushed condition (cond_push()) to
+  skip groups that cannot have a matching row, and uncompresses up to
+  archive_decompress_threads groups in parallel.
+
+  Pending rows are written as a smaller group when the table is read or
+  closed, so interleaved inserts and reads give small groups. OPTIMIZE
+  TABLE rewrites the table in full groups.
+
+  Layout of the .ARG file:
+
+  File header, ARCHIVE_GROUP_FILE_HEADER_SIZE bytes
+    4  ARCHIVE_GROUP_FILE_MAGIC
+    1  ARCHIVE_COLUMNAR_VERSION
+    1  Compression algorithm, ARCHIVE_COMPRESSION_*
+    2  Number of fields
+    4  Maximum rows per group
+    4  Reserved
+
+  Each row group
+    4  ARCHIVE_GROUP_MAGIC
+    4  Number of rows
+    4  Length of the compressed data
+    4  Length of the uncompressed data
+    4  Checksum of the compressed data
+    For each field, ARCHIVE_ZONE_SIZE bytes:
+    1  ARCHIVE_ZONE_* flags
+    8  Minimum value
+    8  Maximum value
+    Compressed data
+
+  The uncompressed data is the length of each column (4 bytes each),
+  the null bytes of all rows and then, column by column, Field::pack()
+  of the values that are not NULL.
 */
 
 /* The file extension */
 #define ARZ ".ARZ"               // The data file
 #define ARN ".ARN"               // Files used during an optimize call
 #define ARM ".ARM"               // Meta file (deprecated)
+#define ARG ".ARG"               // Row groups of COLUMNAR tables
+#define AGN ".AGN"               // Row groups written during an optimize call
 
 /* 5.0 compatibility */
 #define META_V1_OFFSET_CHECK_HEADER  0
@@ -144,6 +193,80 @@ int archive_discover(handlerton *hton, THD* thd, TABLE_SHARE *share);
 */
 #define ARCHIVE_ROW_HEADER_SIZE 4
 
+/* Row group file of COLUMNAR tables, see the description at the top */
+#define ARCHIVE_GROUP_FILE_MAGIC       0x47524101
+#define ARCHIVE_GROUP_FILE_HEADER_SIZE 16
+#define ARCHIVE_GROUP_MAGIC            0x50524701
+#define ARCHIVE_GROUP_HEADER_SIZE      20
+#define ARCHIVE_ZONE_SIZE              17
+#define ARCHIVE_GROUP_MAX_ROWS         65536
+/* Upper limit of archive_row_group_buffer_size */
+#define ARCHIVE_GROUP_MAX_LENGTH       (64*1024*1024)
+
+#define ARCHIVE_ZONE_HAS_NULL   1
+#define ARCHIVE_ZONE_HAS_MINMAX 2
+
+/* Fields that have a zone map */
+#define ARCHIVE_ZONE_NONE     0
+#define ARCHIVE_ZONE_SIGNED   1
+#define ARCHIVE_ZONE_UNSIGNED 2
+#define ARCHIVE_ZONE_TEMPORAL 3
+
+/* Comparison of a pushed condition, "field <op> constant" */
+#define ARCHIVE_COND_EQ 0
+#define ARCHIVE_COND_LT 1
+#define ARCHIVE_COND_LE 2
+#define ARCHIVE_COND_GT 3
+#define ARCHIVE_COND_GE 4
+
+/*
+  Table options
+*/
+struct ha_table_option_struct
+{
+  ulonglong row_group_rows;
+  uint compression;
+  bool columnar;
+};
+
+static ha_create_table_option archive_table_option_list[]=
+{
+  HA_TOPTION_BOOL("COLUMNAR", columnar, 0),
+  HA_TOPTION_ENUM("COMPRESSION_ALGORITHM", compression, "ZLIB,LZ4", 0),
+  HA_TOPTION_NUMBER("ROW_GROUP_ROWS", row_group_rows, 8192, 16,
+                    ARCHIVE_GROUP_MAX_ROWS, 1),
+  HA_TOPTION_END
+};
+
+static uint archive_decompress_threads;
+static ulong archive_row_group_buffer_size;
+static ulonglong archive_row_groups_read= 0, archive_row_groups_skipped= 0;
+
+static MYSQL_SYSVAR_UINT(decompress_threads, archive_decompress_threads,
+       PLUGIN_VAR_RQCMDARG,
+       "Number of row groups of a COLUMNAR table that a table scan reads "
+       "ahead and uncompresses in parallel",
+       NULL, NULL, 4, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(row_group_buffer_size, archive_row_group_buffer_size,
+       PLUGIN_VAR_RQCMDARG,
+       "Memory used per COLUMNAR table to collect inserted rows. The rows "
+       "are written as a row group when ROW_GROUP_ROWS rows are collected "
+       "or when they take this much memory",
+       NULL, NULL, 8*1024*1024, 64*1024, ARCHIVE_GROUP_MAX_LENGTH, 1024);
+
+static struct st_mysql_sys_var *archive_system_variables[]= {
+  MYSQL_SYSVAR(decompress_threads),
+  MYSQL_SYSVAR(row_group_buffer_size),
+  NULL
+};
+
+static SHOW_VAR archive_status_variables[]= {
+  {"row_groups_read", (char*) &archive_row_groups_read, SHOW_LONGLONG},
+  {"row_groups_skipped", (char*) &archive_row_groups_skipped, SHOW_LONGLONG},
+  {NullS, NullS, SHOW_LONG}
+};
+
 static handler *archive_create_handler(handlerton *hton,
                                        TABLE_SHARE *table, 
                                        MEM_ROOT *mem_root)
@@ -201,6 +324,7 @@ static void init_archive_psi_keys(void)
 */
 static const char *ha_archive_exts[] = {
   ARZ,
+  ARG,
   ARM,
   NullS
 };
@@ -220,6 +344,7 @@ int archive_db_init(void *p)
   archive_hton->flags= HTON_NO_FLAGS;
   archive_hton->discover_table= archive_discover;
   archive_hton->tablefile_extensions= ha_archive_exts;
+  archive_hton->table_options= archive_table_option_list;
 
   DBUG_RETURN(0);
 }
@@ -228,6 +353,7 @@ int archive_db_init(void *p)
 Archive_share::Archive_share()
 {
   crashed= false;
+  columnar= false;
   in_optimize= false;
   archive_write_open= false;
   dirty= false;
@@ -265,6 +391,10 @@ ha_archive::ha_archive(handlerton *hton, TABLE_SHARE *table_arg)
   /* The size of the offset value we will use for position() */
   ref_length= sizeof(my_off_t);
   archive_reader_open= FALSE;
+  group_file= -1;
+  group_slots= NULL;
+  group_slot_count= group_slots_used= group_slot= 0;
+  zone_conds= 0;
 }
 
 int archive_discover(handlerton *hton, THD* thd, TABLE_SHARE *share)
@@ -527,6 +657,26 @@ Archive_share *ha_archive::get_share(const char *table_name, int *rc)
     else if (frm_compare(&archive_tmp))
       *rc= HA_ERR_TABLE_DEF_CHANGED;
 
+    if (table->s->option_struct->columnar)
+    {
+      char group_file_name[FN_REFLEN];
+      fn_format(group_file_name, share->data_file_name, "", ARG,
+                MY_REPLACE_EXT);
+      share->columnar= true;
+      if (share->group_writer.read_header(group_file_name, table->s->fields))
+        share->crashed= true;
+      else if (share->group_writer.compression == ARCHIVE_COMPRESSION_LZ4 &&
+               !provider_service_lz4->is_loaded)
+      {
+        my_error(ER_PROVIDER_NOT_LOADED, MYF(0), "LZ4 compression");
+        azclose(&archive_tmp);
+        delete tmp_share;
+        *rc= HA_ERR_UNSUPPORTED;
+        tmp_share= NULL;
+        goto err;
+      }
+    }
+
     azclose(&archive_tmp);
 
     set_ha_share_ptr(static_cast<Handler_share*>(tmp_share));
@@ -557,6 +707,19 @@ int Archive_share::init_archive_writer()
     crashed= true;
     DBUG_RETURN(1);
   }
+  if (columnar)
+  {
+    char group_file_name[FN_REFLEN];
+    fn_format(group_file_name, data_file_name, "", ARG, MY_REPLACE_EXT);
+    if (group_writer.open(group_file_name))
+    {
+      DBUG_PRINT("ha_archive", ("Could not open row group file"));
+      azclose(&archive_write);
+      crashed= true;
+      DBUG_RETURN(1);
+    }
+    group_writer.rows= (ha_rows) archive_write.rows;
+  }
   archive_write_open= true;
 
   DBUG_RETURN(0);
@@ -570,6 +733,12 @@ void Archive_share::close_archive_writer()
   {
     if (archive_write.version == 1)
       (void) write_v1_metafile();
+    if (columnar)
+    {
+      if (group_writer.close())
+        crashed= true;
+      archive_write.rows= group_writer.rows;
+    }
     azclose(&archive_write);
     archive_write_open= false;
     dirty= false;
@@ -577,6 +746,339 @@ void Archive_share::close_archive_writer()
 }
 
 
+/*
+  Type of zone map kept for a field of a COLUMNAR table
+*/
+static uint archive_zone_type(Field *field)
+{
+  switch (field->type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    return ((field->flags & UNSIGNED_FLAG) ? ARCHIVE_ZONE_UNSIGNED :
+            ARCHIVE_ZONE_SIGNED);
+  case MYSQL_TYPE_DATE:
+  case MYSQL_TYPE_NEWDATE:
+  case MYSQL_TYPE_DATETIME:
+    return ARCHIVE_ZONE_TEMPORAL;
+  default:
+    return ARCHIVE_ZONE_NONE;
+  }
+}
+
+
+Archive_group_writer::Archive_group_writer()
+  :file(-1), length(0), rows(0), compression(ARCHIVE_COMPRESSION_ZLIB),
+   max_rows(ARCHIVE_GROUP_MAX_ROWS), fields(0), group_rows(0),
+   group_length(0), column(NULL), zone(NULL)
+{
+}
+
+
+Archive_group_writer::~Archive_group_writer()
+{
+  if (file >= 0)
+    mysql_file_close(file, MYF(0));
+  if (column)
+  {
+    for (uint i= 0; i < fields; i++)
+      column[i].~String();
+    my_free(column);
+  }
+  my_free(zone);
+}
+
+
+/**
+  @brief Read the header of an existing row group file
+
+  @return Completion status
+    @retval  0 Success
+    @retval !0 Failure
+*/
+
+int Archive_group_writer::read_header(const char *name, uint fields_arg)
+{
+  uchar buf[ARCHIVE_GROUP_FILE_HEADER_SIZE];
+  File fd;
+  DBUG_ENTER("Archive_group_writer::read_header");
+
+  if ((fd= mysql_file_open(arch_key_file_data, name, O_RDONLY | O_BINARY,
+                           MYF(0))) < 0)
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+
+  if (mysql_file_read(fd, buf, sizeof(buf), MYF(MY_NABP)) ||
+      uint4korr(buf) != ARCHIVE_GROUP_FILE_MAGIC ||
+      buf[4] != ARCHIVE_COLUMNAR_VERSION ||
+      buf[5] > ARCHIVE_COMPRESSION_LZ4 ||
+      uint2korr(buf + 6) != fields_arg ||
+      !uint4korr(buf + 8) || uint4korr(buf + 8) > ARCHIVE_GROUP_MAX_ROWS)
+  {
+    mysql_file_close(fd, MYF(0));
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+  }
+  compression= buf[5];
+  max_rows= uint4korr(buf + 8);
+  length= mysql_file_seek(fd, 0, MY_SEEK_END, MYF(0));
+  mysql_file_close(fd, MYF(0));
+  DBUG_RETURN(0);
+}
+
+
+int Archive_group_writer::open(const char *name)
+{
+  DBUG_ENTER("Archive_group_writer::open");
+  if ((file= mysql_file_open(arch_key_file_data, name, O_RDWR | O_BINARY,
+                             MYF(0))) < 0)
+    DBUG_RETURN(my_errno);
+  DBUG_RETURN(0);
+}
+
+
+/**
+  @brief Create a row group file. compression and max_rows must be set.
+
+  @return Completion status
+    @retval  0 Success
+    @retval !0 Failure
+*/
+
+int Archive_group_writer::create(const char *name, uint fields_arg)
+{
+  uchar buf[ARCHIVE_GROUP_FILE_HEADER_SIZE];
+  DBUG_ENTER("Archive_group_writer::create");
+
+  bzero(buf, sizeof(buf));
+  int4store(buf, ARCHIVE_GROUP_FILE_MAGIC);
+  buf[4]= ARCHIVE_COLUMNAR_VERSION;
+  buf[5]= (uchar) compression;
+  int2store(buf + 6, fields_arg);
+  int4store(buf + 8, max_rows);
+
+  if ((file= mysql_file_create(arch_key_file_data, name, 0,
+                               O_RDWR | O_TRUNC | O_BINARY, MYF(0))) < 0 ||
+      mysql_file_write(file, buf, sizeof(buf), MYF(MY_NABP)))
+    DBUG_RETURN(my_errno ? my_errno : HA_ERR_INTERNAL_ERROR);
+  length= sizeof(buf);
+  rows= 0;
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Write the pending rows and close the file
+*/
+int Archive_group_writer::close()
+{
+  int rc= flush();
+  if (file >= 0)
+  {
+    if (mysql_file_close(file, MYF(0)) && !rc)
+      rc= my_errno;
+    file= -1;
+  }
+  return rc;
+}
+
+
+/*
+  Add a row to the group being built. The group is written when it is
+  full.
+*/
+int Archive_group_writer::add_row(TABLE *table, const uchar *record)
+{
+  my_ptrdiff_t const rec_offset= record - table->record[0];
+  MY_BITMAP *old_map;
+  DBUG_ENTER("Archive_group_writer::add_row");
+
+  if (!column)
+  {
+    /*
+      String uses Sql_alloc, so new[] would take the columns from the
+      statement's MEM_ROOT. The writer outlives the statement.
+    */
+    if (!(zone= (archive_zone*) my_malloc(PSI_INSTRUMENT_ME,
+                                          sizeof(archive_zone) *
+                                          table->s->fields,
+                                          MYF(MY_WME | MY_ZEROFILL))))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    if (!(column= (String*) my_malloc(PSI_INSTRUMENT_ME,
+                                      sizeof(String) * table->s->fields,
+                                      MYF(MY_WME))))
+    {
+      my_free(zone);
+      zone= NULL;
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    }
+    fields= table->s->fields;
+    for (uint i= 0; i < fields; i++)
+      ::new (column + i) String();
+  }
+
+  if (nulls.append((const char*) record, table->s->null_bytes))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  group_length+= table->s->null_bytes;
+
+  /* The zone maps read columns that the statement did not ask for */
+  old_map= dbug_tmp_use_all_columns(table, &table->read_set);
+  for (uint i= 0; i < fields; i++)
+  {
+    Field *field= table->field[i];
+    archive_zone *field_zone= zone + i;
+    String *col= column + i;
+    uint kind;
+
+    if (field->is_null(rec_offset))
+    {
+      field_zone->flags|= ARCHIVE_ZONE_HAS_NULL;
+      continue;
+    }
+
+    size_t max_length= field->pack_length() + 2;
+    if (field->flags & BLOB_FLAG)
+      max_length+= ((Field_blob*) field)->get_length(rec_offset);
+    if (col->reserve(max_length, col->length()))
+    {
+      dbug_tmp_restore_column_map(&table->read_set, old_map);
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    }
+    uchar *to= (uchar*) col->ptr() + col->length();
+    uchar *end= field->pack(to, record + field->offset(table->record[0]));
+    col->length(col->length() + (uint32) (end - to));
+    group_length+= end - to;
+
+    if ((kind= archive_zone_type(field)) != ARCHIVE_ZONE_NONE)
+    {
+      bool is_unsigned= kind == ARCHIVE_ZONE_UNSIGNED;
+      longlong value;
+      field->move_field_offset(rec_offset);
+      value= (kind == ARCHIVE_ZONE_TEMPORAL ?
+              field->val_datetime_packed(table->in_use) : field->val_int());
+      field->move_field_offset(-rec_offset);
+
+      Longlong_hybrid nr(value, is_unsigned);
+      if (!(field_zone->flags & ARCHIVE_ZONE_HAS_MINMAX))
+      {
+        field_zone->min= field_zone->max= value;
+        field_zone->flags|= ARCHIVE_ZONE_HAS_MINMAX;
+      }
+      else if (nr.cmp(Longlong_hybrid(field_zone->min, is_unsigned)) < 0)
+        field_zone->min= value;
+      else if (nr.cmp(Longlong_hybrid(field_zone->max, is_unsigned)) > 0)
+        field_zone->max= value;
+    }
+  }
+  dbug_tmp_restore_column_map(&table->read_set, old_map);
+
+  if (++group_rows == max_rows ||
+      group_length >= archive_row_group_buffer_size)
+    DBUG_RETURN(flush());
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Compress the pending rows and append them as a row group
+*/
+int Archive_group_writer::flush()
+{
+  size_t data_length, bound, packed_length, header_length;
+  uchar *buffer, *data, *pos;
+  uint i;
+  DBUG_ENTER("Archive_group_writer::flush");
+
+  if (!group_rows)
+    DBUG_RETURN(0);
+
+  data_length= fields * 4 + nulls.length();
+  for (i= 0; i < fields; i++)
+    data_length+= column[i].length();
+  if (data_length > (compression == ARCHIVE_COMPRESSION_LZ4 ?
+                     (size_t) LZ4_MAX_INPUT_SIZE : (size_t) UINT_MAX32))
+    DBUG_RETURN(HA_ERR_TO_BIG_ROW);
+
+  header_length= ARCHIVE_GROUP_HEADER_SIZE + fields * ARCHIVE_ZONE_SIZE;
+  bound= (compression == ARCHIVE_COMPRESSION_LZ4 ?
+          (size_t) LZ4_compressBound((int) data_length) :
+          (size_t) compressBound((uLong) data_length));
+
+  /* The uncompressed data is built after the room for the compressed */
+  if (!(buffer= (uchar*) my_malloc(PSI_INSTRUMENT_ME,
+                                   header_length + bound + data_length,
+                                   MYF(MY_WME))))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  data= buffer + header_length + bound;
+
+  pos= data;
+  for (i= 0; i < fields; i++, pos+= 4)
+    int4store(pos, column[i].length());
+  memcpy(pos, nulls.ptr(), nulls.length());
+  pos+= nulls.length();
+  for (i= 0; i < fields; i++)
+  {
+    memcpy(pos, column[i].ptr(), column[i].length());
+    pos+= column[i].length();
+  }
+
+  if (compression == ARCHIVE_COMPRESSION_LZ4)
+  {
+    int res= LZ4_compress_default((const char*) data,
+                                  (char*) buffer + header_length,
+                                  (int) data_length, (int) bound);
+    packed_length= res > 0 ? (size_t) res : 0;
+  }
+  else
+  {
+    uLongf dest_length= (uLongf) bound;
+    packed_length= (compress2(buffer + header_length, &dest_length, data,
+                              (uLong) data_length,
+                              Z_DEFAULT_COMPRESSION) == Z_OK ?
+                    (size_t) dest_length : 0);
+  }
+  if (!packed_length)
+  {
+    my_free(buffer);
+    DBUG_RETURN(HA_ERR_INTERNAL_ERROR);
+  }
+
+  int4store(buffer, ARCHIVE_GROUP_MAGIC);
+  int4store(buffer + 4, group_rows);
+  int4store(buffer + 8, (uint32) packed_length);
+  int4store(buffer + 12, (uint32) data_length);
+  int4store(buffer + 16, my_checksum(0, buffer + header_length,
+                                     packed_length));
+  pos= buffer + ARCHIVE_GROUP_HEADER_SIZE;
+  for (i= 0; i < fields; i++, pos+= ARCHIVE_ZONE_SIZE)
+  {
+    pos[0]= zone[i].flags;
+    int8store(pos + 1, zone[i].min);
+    int8store(pos + 9, zone[i].max);
+  }
+
+  if (mysql_file_pwrite(file, buffer, header_length + packed_length, length,
+                        MYF(MY_NABP)))
+  {
+    my_free(buffer);
+    DBUG_RETURN(my_errno ? my_errno : HA_ERR_INTERNAL_ERROR);
+  }
+  my_free(buffer);
+  DBUG_PRINT("ha_archive", ("Wrote row group of %u rows at %llu",
+                            group_rows, (ulonglong) length));
+
+  length+= header_length + packed_length;
+  rows+= group_rows;
+  group_rows= 0;
+  group_length= 0;
+  nulls.length(0);
+  for (i= 0; i < fields; i++)
+    column[i].length(0);
+  bzero(zone, sizeof(archive_zone) * fields);
+  DBUG_RETURN(0);
+}
+
+
 /* 
   No locks are required because it is associated with just one handler instance
 */
@@ -599,6 +1101,19 @@ int ha_archive::init_archive_reader()
     }
     archive_reader_open= TRUE;
   }
+  if (share->columnar && group_file < 0)
+  {
+    char group_file_name[FN_REFLEN];
+    fn_format(group_file_name, share->data_file_name, "", ARG,
+              MY_REPLACE_EXT);
+    if ((group_file= mysql_file_open(arch_key_file_data, group_file_name,
+                                     O_RDONLY | O_BINARY, MYF(0))) < 0)
+    {
+      DBUG_PRINT("ha_archive", ("Could not open row group file"));
+      share->crashed= TRUE;
+      DBUG_RETURN(1);
+    }
+  }
 
   DBUG_RETURN(0);
 }
@@ -682,6 +1197,7 @@ int ha_archive::close(void)
   DBUG_ENTER("ha_archive::close");
 
   destroy_record_buffer(record_buffer);
+  free_group_slots();
 
   /* First close stream */
   if (archive_reader_open)
@@ -689,6 +1205,12 @@ int ha_archive::close(void)
     if (azclose(&archive))
       rc= 1;
   }
+  if (group_file >= 0)
+  {
+    if (mysql_file_close(group_file, MYF(0)))
+      rc= 1;
+    group_file= -1;
+  }
   DBUG_RETURN(rc);
 }
 
@@ -771,10 +1293,19 @@ int ha_archive::create(const char *name, TABLE *table_arg,
   const uchar *frm_ptr;
   size_t frm_len;
 
+  ha_table_option_struct *options= table_arg->s->option_struct;
   DBUG_ENTER("ha_archive::create");
 
   stats.auto_increment_value= create_info->auto_increment_value;
 
+  if (options->columnar &&
+      options->compression == ARCHIVE_COMPRESSION_LZ4 &&
+      !provider_service_lz4->is_loaded)
+  {
+    my_error(ER_PROVIDER_NOT_LOADED, MYF(0), "LZ4 compression");
+    DBUG_RETURN(HA_ERR_UNSUPPORTED);
+  }
+
   for (uint key= 0; key < table_arg->s->keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -866,6 +1397,22 @@ int ha_archive::create(const char *name, TABLE *table_arg,
     goto error2;
   }
 
+  if (options->columnar)
+  {
+    Archive_group_writer group_writer;
+    group_writer.compression= options->compression;
+    group_writer.max_rows= (uint) options->row_group_rows;
+    fn_format(name_buff, name_buff, "", ARG, MY_REPLACE_EXT);
+    if ((error= group_writer.create(name_buff, table_arg->s->fields)) ||
+        (error= group_writer.close()))
+      goto error2;
+    if (linkname[0])
+    {
+      fn_format(linkname, linkname, "", ARG, MY_REPLACE_EXT);
+      my_symlink(name_buff, linkname, MYF(0));
+    }
+  }
+
   DBUG_PRINT("ha_archive", ("Creating File %s", name_buff));
   DBUG_PRINT("ha_archive", ("Creating Link %s", linkname));
 
@@ -1067,7 +1614,13 @@ int ha_archive::write_row(const uchar *buf)
     In case of a failed row write, we will never try to reuse the value.
   */
   share->rows_recorded++;
-  rc= real_write_row(buf,  &(share->archive_write));
+  if (share->columnar)
+  {
+    if (!(rc= share->group_writer.add_row(table, buf)))
+      share->dirty= share->group_writer.group_rows != 0;
+  }
+  else
+    rc= real_write_row(buf,  &(share->archive_write));
 error:
   mysql_mutex_unlock(&share->mutex);
   my_free(read_buf);
@@ -1125,7 +1678,7 @@ int ha_archive::index_read_idx(uchar *buf, uint index, const uchar *key,
   if (rc)
     goto error;
 
-  while (!(get_row(&archive, buf)))
+  while (!(read_next_row(buf)))
   {
     if (!memcmp(current_key, buf + current_k_offset, current_key_len))
     {
@@ -1153,7 +1706,7 @@ int ha_archive::index_next(uchar * buf)
 
   DBUG_ENTER("ha_archive::index_next");
 
-  while (!(get_row(&archive, buf)))
+  while (!(read_next_row(buf)))
   {
     if (!memcmp(current_key, buf+current_k_offset, current_key_len))
     {
@@ -1189,7 +1742,16 @@ int ha_archive::rnd_init(bool scan)
     DBUG_PRINT("info", ("archive will retrieve %llu rows", 
                         (unsigned long long) scan_rows));
 
-    if (read_data_header(&archive))
+    if (share->columnar)
+    {
+      my_off_t end;
+      flush_and_clear_pending_writes();
+      mysql_mutex_lock(&share->mutex);
+      end= share->group_writer.length;
+      mysql_mutex_unlock(&share->mutex);
+      group_scan_init(end);
+    }
+    else if (read_data_header(&archive))
       DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
   }
 
@@ -1388,6 +1950,416 @@ int ha_archive::get_row_version2(azio_stream *file_to_read, uchar *buf)
 }
 
 
+/*
+  Set the column cursors of a row group to its first row
+*/
+static int archive_group_rewind(archive_group_slot *slot)
+{
+  const uchar *pos, *end= slot->data + slot->data_length;
+  size_t header_length= (size_t) slot->fields * 4;
+
+  slot->next_row= 0;
+  slot->nulls= slot->data + header_length;
+  pos= slot->nulls + (size_t) slot->rows * slot->null_bytes;
+  if (header_length > slot->data_length || pos > end)
+    return HA_ERR_CRASHED_ON_USAGE;
+  for (uint i= 0; i < slot->fields; i++)
+  {
+    size_t length= uint4korr(slot->data + i * 4);
+    if (length > (size_t) (end - pos))
+      return HA_ERR_CRASHED_ON_USAGE;
+    slot->column[i]= pos;
+    pos+= length;
+    slot->column_end[i]= pos;
+  }
+  return pos == end ? 0 : HA_ERR_CRASHED_ON_USAGE;
+}
+
+
+/*
+  Verify and uncompress a row group that was read into the slot.
+  This is called from helper threads, so no errors are given here.
+*/
+static int archive_uncompress_group(archive_group_slot *slot)
+{
+  size_t data_length= uint4korr(slot->header + 12);
+
+  if (my_checksum(0, slot->packed, slot->packed_length) !=
+      uint4korr(slot->header + 16))
+    return HA_ERR_CRASHED_ON_USAGE;
+
+  if (data_length > slot->data_alloced)
+  {
+    uchar *data;
+    if (!(data= (uchar*) my_realloc(PSI_INSTRUMENT_ME, slot->data,
+                                    data_length, MYF(MY_ALLOW_ZERO_PTR))))
+      return HA_ERR_OUT_OF_MEM;
+    slot->data= data;
+    slot->data_alloced= data_length;
+  }
+
+  if (slot->compression == ARCHIVE_COMPRESSION_LZ4)
+  {
+    if (LZ4_decompress_safe((const char*) slot->packed, (char*) slot->data,
+                            (int) slot->packed_length, (int) data_length) !=
+        (int) data_length)
+      return HA_ERR_CRASHED_ON_USAGE;
+  }
+  else
+  {
+    uLongf length= (uLongf) data_length;
+    if (uncompress(slot->data, &length, slot->packed,
+                   (uLong) slot->packed_length) != Z_OK ||
+        length != data_length)
+      return HA_ERR_CRASHED_ON_USAGE;
+  }
+  slot->data_length= data_length;
+  return archive_group_rewind(slot);
+}
+
+
+static void *archive_uncompress_thread(void *arg)
+{
+  archive_group_slot *slot= (archive_group_slot*) arg;
+  my_thread_init();
+  slot->error= archive_uncompress_group(slot);
+  my_thread_end();
+  return 0;
+}
+
+
+bool ha_archive::alloc_group_slots(uint count)
+{
+  uint fields= table->s->fields;
+  size_t header_length= ARCHIVE_GROUP_HEADER_SIZE + fields * ARCHIVE_ZONE_SIZE;
+  uchar *headers;
+  const uchar **columns;
+  DBUG_ENTER("ha_archive::alloc_group_slots");
+
+  if (count <= group_slot_count)
+    DBUG_RETURN(0);
+  free_group_slots();
+  if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(MY_WME | MY_ZEROFILL),
+                       &group_slots, sizeof(archive_group_slot) * count,
+                       &headers, header_length * count,
+                       &columns, sizeof(uchar*) * fields * 2 * count,
+                       NullS))
+    DBUG_RETURN(1);
+  for (uint i= 0; i < count; i++)
+  {
+    archive_group_slot *slot= group_slots + i;
+    slot->header= headers + header_length * i;
+    slot->column= columns + fields * 2 * i;
+    slot->column_end= slot->column + fields;
+    slot->fields= fields;
+    slot->null_bytes= table->s->null_bytes;
+    slot->compression= share->group_writer.compression;
+  }
+  group_slot_count= count;
+  DBUG_RETURN(0);
+}
+
+
+void ha_archive::free_group_slots()
+{
+  for (uint i= 0; i < group_slot_count; i++)
+  {
+    my_free(group_slots[i].packed);
+    my_free(group_slots[i].data);
+  }
+  my_free(group_slots);
+  group_slots= NULL;
+  group_slot_count= group_slots_used= group_slot= 0;
+}
+
+
+/*
+  Read the header of the row group at 'offset' into the slot
+*/
+int ha_archive::read_group_header(archive_group_slot *slot, my_off_t offset,
+                                  my_off_t end)
+{
+  size_t header_length= (ARCHIVE_GROUP_HEADER_SIZE +
+                         slot->fields * ARCHIVE_ZONE_SIZE);
+  DBUG_ENTER("ha_archive::read_group_header");
+
+  if (offset + header_length > end ||
+      mysql_file_pread(group_file, slot->header, header_length, offset,
+                       MYF(MY_NABP)) ||
+      uint4korr(slot->header) != ARCHIVE_GROUP_MAGIC)
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+
+  slot->offset= offset;
+  slot->rows= uint4korr(slot->header + 4);
+  slot->packed_length= uint4korr(slot->header + 8);
+  slot->next_row= 0;
+  slot->data_length= 0;
+  if (!slot->rows || slot->rows > ARCHIVE_GROUP_MAX_ROWS ||
+      offset + header_length + slot->packed_length > end)
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Read the compressed data of the row group whose header is in the slot
+*/
+int ha_archive::read_group_data(archive_group_slot *slot)
+{
+  size_t header_length= (ARCHIVE_GROUP_HEADER_SIZE +
+                         slot->fields * ARCHIVE_ZONE_SIZE);
+  DBUG_ENTER("ha_archive::read_group_data");
+
+  if (slot->packed_length > slot->packed_alloced)
+  {
+    uchar *packed;
+    if (!(packed= (uchar*) my_realloc(PSI_INSTRUMENT_ME, slot->packed,
+                                      slot->packed_length,
+                                      MYF(MY_ALLOW_ZERO_PTR | MY_WME))))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    slot->packed= packed;
+    slot->packed_alloced= slot->packed_length;
+  }
+  if (mysql_file_pread(group_file, slot->packed, slot->packed_length,
+                       slot->offset + header_length, MYF(MY_NABP)))
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Check if the zone maps of a row group show that no row in it can
+  satisfy the pushed condition
+*/
+bool ha_archive::zone_excludes(const uchar *header)
+{
+  for (archive_zone_cond *cond= zone_cond, *end= cond + zone_conds;
+       cond < end; cond++)
+  {
+    const uchar *zone= (header + ARCHIVE_GROUP_HEADER_SIZE +
+                        cond->field * ARCHIVE_ZONE_SIZE);
+    if (!(zone[0] & ARCHIVE_ZONE_HAS_MINMAX))
+    {
+      /* Only NULL values, no comparison is true */
+      if (zone[0] & ARCHIVE_ZONE_HAS_NULL)
+        return true;
+      continue;
+    }
+
+    Longlong_hybrid value(cond->bound, cond->bound_unsigned);
+    int cmp_min= Longlong_hybrid(sint8korr(zone + 1),
+                                 cond->field_unsigned).cmp(value);
+    int cmp_max= Longlong_hybrid(sint8korr(zone + 9),
+                                 cond->field_unsigned).cmp(value);
+    switch (cond->op) {
+    case ARCHIVE_COND_EQ:
+      if (cmp_min > 0 || cmp_max < 0)
+        return true;
+      break;
+    case ARCHIVE_COND_LT:
+      if (cmp_min >= 0)
+        return true;
+      break;
+    case ARCHIVE_COND_LE:
+      if (cmp_min > 0)
+        return true;
+      break;
+    case ARCHIVE_COND_GT:
+      if (cmp_max <= 0)
+        return true;
+      break;
+    case ARCHIVE_COND_GE:
+      if (cmp_max < 0)
+        return true;
+      break;
+    }
+  }
+  return false;
+}
+
+
+/*
+  Read the next row groups of the scan that may have matching rows, and
+  uncompress them in parallel. The first one is done in this thread.
+*/
+int ha_archive::read_group_batch()
+{
+  uint count= MY_MAX(archive_decompress_threads, 1), started= 0, i;
+  ulonglong groups_read= 0, groups_skipped= 0;
+  size_t header_length= (ARCHIVE_GROUP_HEADER_SIZE +
+                         table->s->fields * ARCHIVE_ZONE_SIZE);
+  int rc= 0;
+  DBUG_ENTER("ha_archive::read_group_batch");
+
+  if (alloc_group_slots(count))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+
+  group_slots_used= group_slot= 0;
+  while (group_slots_used < count && group_next < group_end)
+  {
+    archive_group_slot *slot= group_slots + group_slots_used;
+    if ((rc= read_group_header(slot, group_next, group_end)))
+      break;
+    group_next+= header_length + slot->packed_length;
+    if (zone_conds && zone_excludes(slot->header))
+    {
+      groups_skipped++;
+      continue;
+    }
+    if ((rc= read_group_data(slot)))
+      break;
+    groups_read++;
+    group_slots_used++;
+  }
+  /* The counters are shared by all threads */
+  my_atomic_add64_explicit((volatile int64*) &archive_row_groups_read,
+                           groups_read, MY_MEMORY_ORDER_RELAXED);
+  my_atomic_add64_explicit((volatile int64*) &archive_row_groups_skipped,
+                           groups_skipped, MY_MEMORY_ORDER_RELAXED);
+  if (rc || !group_slots_used)
+  {
+    group_slots_used= 0;
+    DBUG_RETURN(rc ? rc : HA_ERR_END_OF_FILE);
+  }
+
+  for (i= 1; i < group_slots_used; i++)
+  {
+    if (mysql_thread_create(PSI_NOT_INSTRUMENTED, &group_slots[i].thread,
+                            NULL, archive_uncompress_thread,
+                            group_slots + i))
+      break;
+    started++;
+  }
+  rc= archive_uncompress_group(group_slots);
+  for (i= 1; i <= started; i++)
+    pthread_join(group_slots[i].thread, NULL);
+  /* Groups for which no thread could be started */
+  for (; i < group_slots_used; i++)
+    group_slots[i].error= archive_uncompress_group(group_slots + i);
+  for (i= 1; !rc && i < group_slots_used; i++)
+    rc= group_slots[i].error;
+  if (rc)
+    group_slots_used= 0;
+  DBUG_RETURN(rc);
+}
+
+
+int ha_archive::unpack_group_row(archive_group_slot *slot, uchar *record)
+{
+  uint null_bytes= table->s->null_bytes;
+  DBUG_ENTER("ha_archive::unpack_group_row");
+
+  memcpy(record, slot->nulls + (size_t) slot->next_row * null_bytes,
+         null_bytes);
+  slot->next_row++;
+  for (uint i= 0; i < slot->fields; i++)
+  {
+    Field *field= table->field[i];
+    if (!field->is_null_in_record(record))
+    {
+      if (!(slot->column[i]=
+            field->unpack(record + field->offset(table->record[0]),
+                          slot->column[i], slot->column_end[i])))
+        DBUG_RETURN(HA_ERR_WRONG_IN_RECORD);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Start a scan of the row groups of a COLUMNAR table
+*/
+void ha_archive::group_scan_init(my_off_t end)
+{
+  group_next= ARCHIVE_GROUP_FILE_HEADER_SIZE;
+  group_end= end;
+  group_slots_used= group_slot= 0;
+}
+
+
+int ha_archive::get_group_row(uchar *buf)
+{
+  int rc;
+  DBUG_ENTER("ha_archive::get_group_row");
+
+  for (;;)
+  {
+    if (group_slot < group_slots_used)
+    {
+      archive_group_slot *slot= group_slots + group_slot;
+      if (slot->next_row < slot->rows)
+      {
+        current_position= (slot->offset << 16) | slot->next_row;
+        DBUG_RETURN(unpack_group_row(slot, buf));
+      }
+      group_slot++;
+      continue;
+    }
+    if ((rc= read_group_batch()))
+      DBUG_RETURN(rc);
+  }
+}
+
+
+/*
+  Read row number 'row' of the row group at 'offset'. A following
+  get_group_row() continues with the next row.
+*/
+int ha_archive::get_group_row_at(uchar *buf, my_off_t offset, uint row)
+{
+  archive_group_slot *slot;
+  int rc;
+  DBUG_ENTER("ha_archive::get_group_row_at");
+
+  for (group_slot= 0; group_slot < group_slots_used; group_slot++)
+  {
+    if (group_slots[group_slot].offset == offset)
+      break;
+  }
+  if (group_slot == group_slots_used)
+  {
+    my_off_t end;
+    if (alloc_group_slots(1))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    mysql_mutex_lock(&share->mutex);
+    end= share->group_writer.length;
+    mysql_mutex_unlock(&share->mutex);
+
+    group_slots_used= group_slot= 0;
+    slot= group_slots;
+    if ((rc= read_group_header(slot, offset, end)) ||
+        (rc= read_group_data(slot)) ||
+        (rc= archive_uncompress_group(slot)))
+      DBUG_RETURN(rc);
+    group_slots_used= 1;
+    group_next= (offset + ARCHIVE_GROUP_HEADER_SIZE +
+                 slot->fields * ARCHIVE_ZONE_SIZE + slot->packed_length);
+    group_end= end;
+  }
+  slot= group_slots + group_slot;
+  if (row >= slot->rows)
+    DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
+
+  /* Values are packed one after another, so unpack from the start */
+  if (row < slot->next_row && (rc= archive_group_rewind(slot)))
+    DBUG_RETURN(rc);
+  while (slot->next_row < row)
+  {
+    if ((rc= unpack_group_row(slot, buf)))
+      DBUG_RETURN(rc);
+  }
+  current_position= (offset << 16) | row;
+  DBUG_RETURN(unpack_group_row(slot, buf));
+}
+
+
+int ha_archive::read_next_row(uchar *buf)
+{
+  return share->columnar ? get_group_row(buf) : get_row(&archive, buf);
+}
+
+
 /* 
   Called during ORDER BY. Its position is either from being called sequentially
   or by having had ha_archive::rnd_pos() called before it is called.
@@ -1401,6 +2373,9 @@ int ha_archive::rnd_next(uchar *buf)
   if (share->crashed)
       DBUG_RETURN(HA_ERR_CRASHED_ON_USAGE);
 
+  if (share->columnar)
+    DBUG_RETURN(get_group_row(buf));
+
   if (!scan_rows)
   {
     rc= HA_ERR_END_OF_FILE;
@@ -1442,6 +2417,12 @@ int ha_archive::rnd_pos(uchar * buf, uchar *pos)
   int rc;
   DBUG_ENTER("ha_archive::rnd_pos");
   current_position= (my_off_t)my_get_ptr(pos, ref_length);
+  if (share->columnar)
+  {
+    rc= get_group_row_at(buf, current_position >> 16,
+                         (uint) (current_position & 0xffff));
+    goto end;
+  }
   if (azseek(&archive, current_position, SEEK_SET) == (my_off_t)(-1L))
   {
     rc= HA_ERR_CRASHED_ON_USAGE;
@@ -1500,7 +2481,9 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
 {
   int rc= 0;
   azio_stream writer;
+  Archive_group_writer group_writer;
   char writer_filename[FN_REFLEN];
+  char group_filename[FN_REFLEN];
   DBUG_ENTER("ha_archive::optimize");
 
   mysql_mutex_lock(&share->mutex);
@@ -1514,8 +2497,12 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
   // now we close both our writer and our reader for the rename
   if (share->archive_write_open)
   {
+    /* Pending rows of a COLUMNAR table are written first */
+    if (share->columnar && share->group_writer.close())
+      share->crashed= TRUE;
     azclose(&(share->archive_write));
     share->archive_write_open= FALSE;
+    share->dirty= FALSE;
   }
 
   /* Lets create a file to contain the new data */
@@ -1535,6 +2522,16 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
   if ((rc= frm_copy(&archive, &writer)))
     goto error;
 
+  if (share->columnar)
+  {
+    fn_format(group_filename, share->table_name, "", AGN,
+              MY_REPLACE_EXT | MY_UNPACK_FILENAME);
+    group_writer.compression= share->group_writer.compression;
+    group_writer.max_rows= share->group_writer.max_rows;
+    if ((rc= group_writer.create(group_filename, table->s->fields)))
+      goto error;
+  }
+
   /* 
     An extended rebuild is a lot more effort. We open up each row and re-record it. 
     Any dead rows are removed (aka rows that may have been partially recorded). 
@@ -1551,6 +2548,11 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
       start of the file.
     */
     rc= read_data_header(&archive);
+    if (share->columnar)
+    {
+      zone_conds= 0;
+      group_scan_init(share->group_writer.length);
+    }
 
     /* 
       On success of writing out the new header, we now fetch each row and
@@ -1563,9 +2565,15 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
       share->archive_write.auto_increment= 0;
       MY_BITMAP *org_bitmap= tmp_use_all_columns(table, &table->read_set);
 
-      while (!(rc= get_row(&archive, table->record[0])))
+      while (!(rc= read_next_row(table->record[0])))
       {
-        real_write_row(table->record[0], &writer);
+        if (share->columnar)
+        {
+          if ((rc= group_writer.add_row(table, table->record[0])))
+            break;
+        }
+        else
+          real_write_row(table->record[0], &writer);
         /*
           Long term it should be possible to optimize this so that
           it is not called on each row.
@@ -1583,6 +2591,13 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
       }
 
       tmp_restore_column_map(&table->read_set, org_bitmap);
+      if (share->columnar)
+      {
+        int close_rc= group_writer.close();
+        if (close_rc && (!rc || rc == HA_ERR_END_OF_FILE))
+          rc= close_rc;
+        writer.rows= group_writer.rows;
+      }
       share->rows_recorded= (ha_rows)writer.rows;
     }
 
@@ -1607,6 +2622,26 @@ int ha_archive::optimize(THD* thd, HA_CHECK_OPT* check_opt)
   share->dirty= FALSE;
   
   azclose(&archive);
+  archive_reader_open= FALSE;
+
+  if (share->columnar)
+  {
+    char final_filename[FN_REFLEN];
+    if (group_file >= 0)
+    {
+      mysql_file_close(group_file, MYF(0));
+      group_file= -1;
+    }
+    group_slots_used= group_slot= 0;
+    fn_format(final_filename, share->data_file_name, "", ARG, MY_REPLACE_EXT);
+    if ((rc= my_rename(group_filename, final_filename, MYF(0))))
+    {
+      mysql_mutex_unlock(&share->mutex);
+      DBUG_RETURN(rc);
+    }
+    share->group_writer.length= group_writer.length;
+    share->group_writer.rows= group_writer.rows;
+  }
 
   // make the file we just wrote be our data file
   rc= my_rename(writer_filename, share->data_file_name, MYF(0));
@@ -1692,7 +2727,18 @@ int ha_archive::info(uint flag)
 {
   DBUG_ENTER("ha_archive::info");
 
-  flush_and_clear_pending_writes();
+  if (share->columnar)
+  {
+    /*
+      Pending rows are written when they are read. Writing them here
+      would give a small row group for every statement.
+    */
+    mysql_mutex_lock(&share->mutex);
+    stats.records= share->rows_recorded;
+    mysql_mutex_unlock(&share->mutex);
+  }
+  else
+    flush_and_clear_pending_writes();
   stats.deleted= 0;
 
   DBUG_PRINT("ha_archive", ("Stats rows is %d\n", (int)stats.records));
@@ -1747,6 +2793,153 @@ int ha_archive::external_lock(THD *thd, int lock_type)
 }
 
 
+static uint archive_cond_op(Item_func::Functype functype)
+{
+  switch (functype) {
+  case Item_func::LT_FUNC: return ARCHIVE_COND_LT;
+  case Item_func::LE_FUNC: return ARCHIVE_COND_LE;
+  case Item_func::GT_FUNC: return ARCHIVE_COND_GT;
+  case Item_func::GE_FUNC: return ARCHIVE_COND_GE;
+  default:                 return ARCHIVE_COND_EQ;
+  }
+}
+
+
+/* The same comparison with the arguments swapped */
+static uint archive_cond_reverse(uint op)
+{
+  switch (op) {
+  case ARCHIVE_COND_LT: return ARCHIVE_COND_GT;
+  case ARCHIVE_COND_LE: return ARCHIVE_COND_GE;
+  case ARCHIVE_COND_GT: return ARCHIVE_COND_LT;
+  case ARCHIVE_COND_GE: return ARCHIVE_COND_LE;
+  default:              return op;
+  }
+}
+
+
+/*
+  Remember "field <op> constant" if the field has a zone map and the
+  comparison is done the same way as the zone map values are compared.
+  'handler' is the type handler used for the comparison.
+*/
+void ha_archive::add_zone_cond(Item *field_item, Item *value, uint op,
+                               const Type_handler *handler)
+{
+  Item *real_item= field_item->real_item();
+  archive_zone_cond *cond= zone_cond + zone_conds;
+  Field *field;
+  uint kind;
+  THD *thd= ha_thd();
+
+  if (zone_conds == ARCHIVE_MAX_ZONE_CONDS ||
+      real_item->type() != Item::FIELD_ITEM ||
+      !value->const_item() || value->is_expensive())
+    return;
+  field= ((Item_field*) real_item)->field;
+  if (field->table != table ||
+      (kind= archive_zone_type(field)) == ARCHIVE_ZONE_NONE)
+    return;
+
+  if (kind == ARCHIVE_ZONE_TEMPORAL)
+  {
+    enum_field_types type= handler->field_type();
+    if (handler->cmp_type() != TIME_RESULT ||
+        (type != MYSQL_TYPE_DATE && type != MYSQL_TYPE_NEWDATE &&
+         type != MYSQL_TYPE_DATETIME))
+      return;
+  }
+  else if (handler->cmp_type() != INT_RESULT)
+    return;
+
+  /* Conversion warnings are given when the condition is evaluated */
+  Dummy_error_handler error_handler;
+  thd->push_internal_handler(&error_handler);
+  cond->bound= (kind == ARCHIVE_ZONE_TEMPORAL ?
+                value->val_datetime_packed(thd) : value->val_int());
+  thd->pop_internal_handler();
+  if (value->null_value || thd->is_error())
+    return;
+
+  cond->bound_unsigned= kind != ARCHIVE_ZONE_TEMPORAL && value->unsigned_flag;
+  cond->field_unsigned= kind == ARCHIVE_ZONE_UNSIGNED;
+  cond->field= field->field_index;
+  cond->op= op;
+  zone_conds++;
+}
+
+
+/*
+  Collect the comparisons of an AND condition that can be checked
+  against the zone maps
+*/
+void ha_archive::add_zone_conds(Item *cond)
+{
+  if (cond->type() == Item::COND_ITEM)
+  {
+    if (((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+    {
+      List_iterator<Item> li(*((Item_cond*) cond)->argument_list());
+      Item *item;
+      while ((item= li++))
+        add_zone_conds(item);
+    }
+    return;
+  }
+  if (cond->type() != Item::FUNC_ITEM)
+    return;
+
+  Item_func *func= (Item_func*) cond;
+  Item **args= func->arguments();
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC:
+  case Item_func::LT_FUNC:
+  case Item_func::LE_FUNC:
+  case Item_func::GT_FUNC:
+  case Item_func::GE_FUNC:
+  {
+    const Type_handler *handler=
+      ((Item_bool_rowready_func2*) func)->compare_type_handler();
+    uint op= archive_cond_op(func->functype());
+    add_zone_cond(args[0], args[1], op, handler);
+    add_zone_cond(args[1], args[0], archive_cond_reverse(op), handler);
+    break;
+  }
+  case Item_func::BETWEEN:
+    if (((Item_func_between*) func)->negated)
+      break;
+    add_zone_cond(args[0], args[1], ARCHIVE_COND_GE, args[1]->type_handler());
+    add_zone_cond(args[0], args[2], ARCHIVE_COND_LE, args[2]->type_handler());
+    break;
+  default:
+    break;
+  }
+}
+
+
+/*
+  Row groups of COLUMNAR tables are skipped when their zone maps show
+  that the condition cannot be true for any row in them. The condition
+  is not removed, the server still checks it for every row we return.
+*/
+const COND *ha_archive::cond_push(const COND *cond)
+{
+  DBUG_ENTER("ha_archive::cond_push");
+  zone_conds= 0;
+  if (share->columnar)
+    add_zone_conds(const_cast<COND*>(cond));
+  DBUG_PRINT("ha_archive", ("zone conditions: %u", zone_conds));
+  DBUG_RETURN(cond);
+}
+
+
+int ha_archive::reset()
+{
+  zone_conds= 0;
+  return 0;
+}
+
+
 void ha_archive::flush_and_clear_pending_writes()
 {
   mysql_mutex_lock(&share->mutex);
@@ -1754,7 +2947,13 @@ void ha_archive::flush_and_clear_pending_writes()
   {
     DBUG_PRINT("ha_archive", ("archive flushing out rows for scan"));
     DBUG_ASSERT(share->archive_write_open);
-    azflush(&(share->archive_write), Z_SYNC_FLUSH);
+    if (share->columnar)
+    {
+      if (share->group_writer.flush())
+        share->crashed= true;
+    }
+    else
+      azflush(&(share->archive_write), Z_SYNC_FLUSH);
     share->dirty= FALSE;
   }
 
@@ -1843,6 +3042,29 @@ int ha_archive::check(THD* thd, HA_CHECK_OPT* check_opt)
   DBUG_ENTER("ha_archive::check");
 
   old_proc_info= thd_proc_info(thd, "Checking table");
+  if (share->columnar)
+  {
+    my_off_t end;
+    /* Write pending rows and read all row groups up to that point */
+    flush_and_clear_pending_writes();
+    mysql_mutex_lock(&share->mutex);
+    count= share->rows_recorded;
+    end= share->group_writer.length;
+    mysql_mutex_unlock(&share->mutex);
+
+    if (init_archive_reader())
+      DBUG_RETURN(HA_ADMIN_CORRUPT);
+    zone_conds= 0;
+    group_scan_init(end);
+    while (!(rc= get_group_row(table->record[0])))
+      count--;
+    if (rc != HA_ERR_END_OF_FILE || count)
+      goto error;
+
+    thd_proc_info(thd, old_proc_info);
+    DBUG_RETURN(HA_ADMIN_OK);
+  }
+
   mysql_mutex_lock(&share->mutex);
   count= share->rows_recorded;
   /* Flush any waiting data */
@@ -1956,8 +3178,8 @@ maria_declare_plugin(archive)
   archive_db_init, /* Plugin Init */
   NULL, /* Plugin Deinit */
   0x0300 /* 3.0 */,
-  NULL,                       /* status variables                */
-  NULL,                       /* system variables                */
+  archive_status_variables,   /* status variables                */
+  archive_system_variables,   /* system variables                */
   "1.0",                      /* string version */
   MariaDB_PLUGIN_MATURITY_STABLE /* maturity */
 }
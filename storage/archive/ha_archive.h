@@ -32,12 +32,53 @@ typedef struct st_archive_record_buffer {
 } archive_record_buffer;
 
 
+/*
+  Minimum and maximum value of one field in a row group of a COLUMNAR
+  table. The values are val_int() or val_datetime_packed() of the field.
+*/
+typedef struct st_archive_zone {
+  longlong min, max;
+  uchar flags;
+} archive_zone;
+
+
+/*
+  Writes row groups to the .ARG file of a COLUMNAR table.
+  Rows are collected in memory, column by column, until the group is
+  full or until a reader needs to see them.
+*/
+class Archive_group_writer
+{
+public:
+  File file;
+  my_off_t length;            /* End of the last written row group */
+  ha_rows rows;               /* Rows in written row groups */
+  uint compression;           /* ARCHIVE_COMPRESSION_* */
+  uint max_rows;              /* Rows per row group */
+  uint fields;
+  uint group_rows;            /* Rows in the group being built */
+  size_t group_length;        /* Uncompressed size of the group */
+  String nulls;               /* Null bytes of all rows in the group */
+  String *column;             /* Packed non null values, one per field */
+  archive_zone *zone;
+  Archive_group_writer();
+  ~Archive_group_writer();
+  int read_header(const char *name, uint fields_arg);
+  int open(const char *name);
+  int create(const char *name, uint fields_arg);
+  int close();
+  int add_row(TABLE *table, const uchar *record);
+  int flush();
+};
+
+
 class Archive_share : public Handler_share
 {
 public:
   mysql_mutex_t mutex;
   THR_LOCK lock;
   azio_stream archive_write;     /* Archive file we are working with */
+  Archive_group_writer group_writer;  /* Row groups of COLUMNAR tables */
   ha_rows rows_recorded;    /* Number of rows in tables */
   char table_name[FN_REFLEN];
   char data_file_name[FN_REFLEN];
@@ -45,6 +86,7 @@ class Archive_share : public Handler_share
   bool archive_write_open;
   bool dirty;               /* Flag for if a flush should occur */
   bool crashed;             /* Meta file is crashed */
+  bool columnar;            /* Rows are stored in row groups in .ARG */
   Archive_share();
   virtual ~Archive_share();
   int init_archive_writer();
@@ -58,8 +100,55 @@ class Archive_share : public Handler_share
   1 - Initial Version (Never Released)
   2 - Stream Compression, seperate blobs, no packing
   3 - One stream (row and blobs), with packing
+  4 - COLUMNAR tables: row groups stored column by column in a separate
+      .ARG file. The .ARZ file is still version 3 and keeps the frm,
+      the row count and the auto increment value.
 */
 #define ARCHIVE_VERSION 3
+#define ARCHIVE_COLUMNAR_VERSION 4
+
+/* Compression algorithms of COLUMNAR tables */
+#define ARCHIVE_COMPRESSION_ZLIB 0
+#define ARCHIVE_COMPRESSION_LZ4  1
+
+/* Maximum number of pushed conditions used to skip row groups */
+#define ARCHIVE_MAX_ZONE_CONDS 16
+
+/*
+  A row group of a COLUMNAR table read from the .ARG file
+*/
+typedef struct st_archive_group_slot
+{
+  my_off_t offset;            /* Position of the group in the .ARG file */
+  uchar *header;
+  uchar *packed;              /* Compressed data */
+  uchar *data;                /* Uncompressed data */
+  size_t packed_length, data_length;
+  size_t packed_alloced, data_alloced;
+  const uchar *nulls;
+  const uchar **column;       /* Next value to unpack for each field */
+  const uchar **column_end;
+  uint rows;
+  uint next_row;              /* Next row to unpack */
+  uint compression;
+  uint fields;
+  uint null_bytes;
+  int error;
+  pthread_t thread;
+} archive_group_slot;
+
+/*
+  Pushed condition "field <op> constant" that is checked against the
+  zone maps of the row groups
+*/
+typedef struct st_archive_zone_cond
+{
+  longlong bound;             /* Value of the constant */
+  uint field;
+  uint op;                    /* ARCHIVE_COND_EQ ... */
+  bool bound_unsigned;
+  bool field_unsigned;
+} archive_zone_cond;
 
 class ha_archive final : public handler
 {
@@ -78,12 +167,36 @@ class ha_archive final : public handler
   uint current_k_offset;
   archive_record_buffer *record_buffer;
   bool archive_reader_open;
+  File group_file;              /* Reader of the .ARG file */
+  my_off_t group_next;          /* Next row group to read */
+  my_off_t group_end;           /* End of the row groups to read */
+  archive_group_slot *group_slots;
+  uint group_slot_count;        /* Allocated slots */
+  uint group_slots_used;        /* Slots filled by the last read */
+  uint group_slot;              /* Current slot */
+  archive_zone_cond zone_cond[ARCHIVE_MAX_ZONE_CONDS];
+  uint zone_conds;
 
   archive_record_buffer *create_record_buffer(unsigned int length);
   void destroy_record_buffer(archive_record_buffer *r);
   int frm_copy(azio_stream *src, azio_stream *dst);
   int frm_compare(azio_stream *src);
   unsigned int pack_row_v1(const uchar *record);
+  void add_zone_conds(Item *cond);
+  void add_zone_cond(Item *field_item, Item *value, uint op,
+                     const Type_handler *handler);
+  bool zone_excludes(const uchar *header);
+  bool alloc_group_slots(uint count);
+  void free_group_slots();
+  int read_group_header(archive_group_slot *slot, my_off_t offset,
+                        my_off_t end);
+  int read_group_data(archive_group_slot *slot);
+  int read_group_batch();
+  int unpack_group_row(archive_group_slot *slot, uchar *record);
+  void group_scan_init(my_off_t end);
+  int get_group_row(uchar *buf);
+  int get_group_row_at(uchar *buf, my_off_t offset, uint row);
+  int read_next_row(uchar *buf);
 
 public:
   ha_archive(handlerton *hton, TABLE_SHARE *table_arg);
@@ -97,7 +210,8 @@ class ha_archive final : public handler
             HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE |
             HA_STATS_RECORDS_IS_EXACT | HA_CAN_EXPORT |
             HA_HAS_RECORDS | HA_CAN_REPAIR | HA_SLOW_RND_POS |
-            HA_FILE_BASED | HA_CAN_INSERT_DELAYED | HA_CAN_GEOMETRY);
+            HA_FILE_BASED | HA_CAN_INSERT_DELAYED | HA_CAN_GEOMETRY |
+            HA_CAN_TABLE_CONDITION_PUSHDOWN);
   }
   ulong index_flags(uint idx, uint part, bool all_parts) const
   {
@@ -159,6 +273,9 @@ class ha_archive final : public handler
   unsigned int pack_row(const uchar *record, azio_stream *writer);
   bool check_if_incompatible_data(HA_CREATE_INFO *info, uint table_changes);
   int external_lock(THD *thd, int lock_type);
+  const COND *cond_push(const COND *cond);
+  void cond_pop() { zone_conds= 0; }
+  int reset();
 private:
   void flush_and_clear_pending_writes();
 };
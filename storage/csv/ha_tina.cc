@@ -48,6 +48,10 @@
 #include "ha_tina.h"
 #include "probes_mysql.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /*
   uchar + uchar + ulonglong + ulonglong + ulonglong + ulonglong + uchar
 */
@@ -55,6 +59,13 @@
   + sizeof(ulonglong) + sizeof(ulonglong) + sizeof(ulonglong) + sizeof(uchar)
 #define TINA_CHECK_HEADER 254 // The number we use to determine corruption
 #define BLOB_MEMROOT_ALLOC_SIZE 8192
+/*
+  A table scan of a mapped data file first parses TINA_PARSE_BATCH_START
+  bytes in one thread, and doubles that for every following batch until
+  each of tina_parse_threads threads gets TINA_PARSE_CHUNK_SIZE bytes.
+*/
+#define TINA_PARSE_BATCH_START 65536
+#define TINA_PARSE_CHUNK_SIZE (1024*1024)
 
 /* The file extension */
 #define CSV_EXT ".CSV"               // The data file
@@ -72,6 +83,19 @@ ha_create_table_option csv_table_option_list[]=
   HA_TOPTION_END
 };
 
+static uint tina_parse_threads;
+
+static MYSQL_SYSVAR_UINT(parse_threads, tina_parse_threads,
+       PLUGIN_VAR_RQCMDARG,
+       "Number of threads that split the data file of a CSV table into rows "
+       "and values during a table scan",
+       NULL, NULL, 4, 1, 64, 1);
+
+static struct st_mysql_sys_var *tina_system_variables[]= {
+  MYSQL_SYSVAR(parse_threads),
+  NULL
+};
+
 static TINA_SHARE *get_share(const char *table_name, TABLE *table);
 static int free_share(TINA_SHARE *share);
 static int read_meta_file(File meta_file, ha_rows *rows);
@@ -116,15 +140,28 @@ static PSI_memory_key csv_key_memory_tina_share;
 static PSI_memory_key csv_key_memory_blobroot;
 static PSI_memory_key csv_key_memory_tina_set;
 static PSI_memory_key csv_key_memory_row;
+static PSI_memory_key csv_key_memory_tina_chunk;
 
 #ifdef HAVE_PSI_INTERFACE
 
-static PSI_mutex_key csv_key_mutex_tina, csv_key_mutex_TINA_SHARE_mutex;
+static PSI_mutex_key csv_key_mutex_tina, csv_key_mutex_TINA_SHARE_mutex,
+  csv_key_mutex_tina_parse_workers_lock;
 
 static PSI_mutex_info all_tina_mutexes[]=
 {
   { &csv_key_mutex_tina, "tina", PSI_FLAG_GLOBAL},
-  { &csv_key_mutex_TINA_SHARE_mutex, "TINA_SHARE::mutex", 0}
+  { &csv_key_mutex_TINA_SHARE_mutex, "TINA_SHARE::mutex", 0},
+  { &csv_key_mutex_tina_parse_workers_lock, "tina_parse_workers::lock", 0}
+};
+
+static PSI_cond_key csv_key_cond_tina_parse_workers_cond,
+  csv_key_cond_tina_parse_workers_done_cond;
+
+static PSI_cond_info all_tina_conds[]=
+{
+  { &csv_key_cond_tina_parse_workers_cond, "tina_parse_workers::cond", 0},
+  { &csv_key_cond_tina_parse_workers_done_cond,
+    "tina_parse_workers::done_cond", 0}
 };
 
 static PSI_file_key csv_key_file_metadata, csv_key_file_data,
@@ -143,6 +180,7 @@ static PSI_memory_info all_tina_memory[]=
   { &csv_key_memory_blobroot, "blobroot", 0},
   { &csv_key_memory_tina_set, "tina_set", 0},
   { &csv_key_memory_row, "row", 0},
+  { &csv_key_memory_tina_chunk, "tina_chunk", 0},
   { &csv_key_memory_Transparent_file, "Transparent_file", 0}
 };
 
@@ -154,6 +192,9 @@ static void init_tina_psi_keys(void)
   count= array_elements(all_tina_mutexes);
   mysql_mutex_register(category, all_tina_mutexes, count);
 
+  count= array_elements(all_tina_conds);
+  mysql_cond_register(category, all_tina_conds, count);
+
   count= array_elements(all_tina_files);
   mysql_file_register(category, all_tina_files, count);
 
@@ -506,6 +547,267 @@ my_off_t find_eoln_buff(Transparent_file *data_buff, my_off_t begin,
 }
 
 
+/*
+  Return the first byte in [ptr, end) that is c1, c2 or c3, or end if
+  there is none. With SSE2 16 bytes are compared at a time.
+*/
+
+static inline const uchar *tina_find(const uchar *ptr, const uchar *end,
+                                     uchar c1, uchar c2, uchar c3)
+{
+#ifdef __SSE2__
+  const __m128i v1= _mm_set1_epi8((char) c1);
+  const __m128i v2= _mm_set1_epi8((char) c2);
+  const __m128i v3= _mm_set1_epi8((char) c3);
+  for ( ; ptr + 16 <= end; ptr+= 16)
+  {
+    __m128i b= _mm_loadu_si128((const __m128i *) ptr);
+    uint mask= (uint) _mm_movemask_epi8(
+                 _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(b, v1),
+                                           _mm_cmpeq_epi8(b, v2)),
+                              _mm_cmpeq_epi8(b, v3)));
+    if (mask)
+      return ptr + __builtin_ctz(mask);
+  }
+#endif
+  for ( ; ptr < end; ptr++)
+    if (*ptr == c1 || *ptr == c2 || *ptr == c3)
+      return ptr;
+  return end;
+}
+
+
+/*
+  Return the position after the end of line that comes first at or after
+  "ptr", or "end" if there is none. Line endings are the same as in
+  find_eoln_buff().
+*/
+
+static const uchar *tina_next_line(const uchar *ptr, const uchar *end)
+{
+  const uchar *eol= tina_find(ptr, end, '\n', '\r', '\n');
+  if (eol == end)
+    return end;
+  if (*eol == '\r' && eol + 1 < end && eol[1] == '\n')
+    return eol + 2;
+  return eol + 1;
+}
+
+
+/*
+  Split the line [pos, eol) into chunk->fields values, with the same
+  rules as ha_tina::find_current_row().
+
+  RETURN
+    0  ok
+    1  The row is damaged, or chunk->error is set
+*/
+
+static bool tina_parse_row(tina_chunk *chunk, const uchar *pos,
+                           const uchar *eol, tina_value *value)
+{
+  String *decoded= &chunk->decoded;
+
+  for (uint i= 0; i < chunk->fields; i++, value++)
+  {
+    const uchar *start, *segment, *next, *value_end;
+    size_t decoded_start= 0;
+    bool quoted;
+    uchar delimiter;
+
+    if (pos >= eol)
+      return 1;
+    if ((quoted= (*pos == '"')))
+      pos++;
+    delimiter= quoted ? '"' : ',';
+    start= segment= pos;
+    value->decoded= false;
+
+    for (;;)
+    {
+      next= tina_find(pos, eol, delimiter, '\\', delimiter);
+      if (next == eol)
+      {
+        /*
+          The value runs to the end of the line. Its last character is
+          an ordinary one, which is not allowed for a quoted value, and
+          can't be a quote for an unquoted one.
+        */
+        if (pos < eol && (quoted || eol[-1] == '"'))
+          return 1;
+        value_end= pos= eol;
+        break;
+      }
+      if (*next == '\\')
+      {
+        uchar escaped;
+        if (next + 1 == eol)
+        {
+          /* A backslash as the last character is an ordinary one */
+          if (quoted)
+            return 1;
+          value_end= pos= eol;
+          break;
+        }
+        if (!value->decoded)
+        {
+          value->decoded= true;
+          decoded_start= decoded->length();
+        }
+        if (decoded->append((const char*) segment, (size_t) (next - segment)))
+          goto err;
+        escaped= next[1];
+        if (escaped == 'r')
+          decoded->append('\r');
+        else if (escaped == 'n')
+          decoded->append('\n');
+        else if (escaped == '\\' ||
+                 (escaped == '"' && !(quoted && chunk->ietf_quotes)))
+          decoded->append((char) escaped);
+        else
+        {
+          decoded->append('\\');
+          decoded->append((char) escaped);
+        }
+        segment= pos= next + 2;
+        continue;
+      }
+      if (!quoted)
+      {
+        /* Move past the , */
+        value_end= next;
+        pos= next + 1;
+        break;
+      }
+      if (next + 1 == eol || next[1] == ',')
+      {
+        /* Move past the , and the " */
+        value_end= next;
+        pos= next + 2;
+        break;
+      }
+      if (chunk->ietf_quotes && next[1] == '"')
+      {
+        /* Embedded IETF quote */
+        if (!value->decoded)
+        {
+          value->decoded= true;
+          decoded_start= decoded->length();
+        }
+        if (decoded->append((const char*) segment,
+                            (size_t) (next - segment + 1)))
+          goto err;
+        segment= pos= next + 2;
+        continue;
+      }
+      /* A quote followed by something else is an ordinary character */
+      pos= next + 1;
+    }
+
+    if (value->decoded)
+    {
+      if (decoded->append((const char*) segment,
+                          (size_t) (value_end - segment)))
+        goto err;
+      value->offset= decoded_start;
+      value->length= (uint32) (decoded->length() - decoded_start);
+    }
+    else
+    {
+      value->offset= (size_t) (start - chunk->data);
+      value->length= (uint32) (value_end - start);
+    }
+  }
+  return 0;
+
+err:
+  chunk->error= HA_ERR_OUT_OF_MEM;
+  return 1;
+}
+
+
+/*
+  Split a chunk of the data file into rows and values.
+  This is called from helper threads, so no errors are given here.
+*/
+
+static void tina_parse_chunk(tina_chunk *chunk)
+{
+  const uchar *pos= chunk->data + chunk->begin;
+  const uchar *end= chunk->data + chunk->end;
+  const uchar *data_end= chunk->data + chunk->data_end;
+  size_t row_length= chunk->row_length();
+
+  chunk->row_count= 0;
+  chunk->error= 0;
+  chunk->decoded.length(0);
+
+  while (pos < end)
+  {
+    const uchar *eol= tina_find(pos, end, '\n', '\r', '\n'), *next;
+    tina_row *row;
+
+    /* A last line without a line ending is not a row */
+    if (eol == end)
+      break;
+    next= tina_next_line(eol, data_end);
+
+    if (chunk->row_count == chunk->rows_alloced)
+    {
+      size_t alloced= chunk->rows_alloced ? chunk->rows_alloced * 2 : 256;
+      uchar *rows= (uchar*) my_realloc(csv_key_memory_tina_chunk, chunk->rows,
+                                       alloced * row_length,
+                                       MYF(MY_ALLOW_ZERO_PTR));
+      if (!rows)
+      {
+        chunk->error= HA_ERR_OUT_OF_MEM;
+        return;
+      }
+      chunk->rows= rows;
+      chunk->rows_alloced= alloced;
+    }
+    row= chunk->row(chunk->row_count++);
+    row->begin= (my_off_t) (pos - chunk->data);
+    row->end= (my_off_t) (next - chunk->data);
+    row->bad= tina_parse_row(chunk, pos, eol, (tina_value*) (row + 1));
+    if (chunk->error)
+      return;
+    pos= next;
+  }
+}
+
+
+/*
+  A thread of tina_parse_workers. It parses its chunk of every batch of
+  a table scan, until it is told to stop.
+*/
+
+static void *tina_parse_thread(void *arg)
+{
+  tina_chunk *chunk= (tina_chunk*) arg;
+  tina_parse_workers *workers= chunk->workers;
+
+  my_thread_init();
+  mysql_mutex_lock(&workers->lock);
+  for (;;)
+  {
+    while (!chunk->queued && !workers->stop)
+      mysql_cond_wait(&workers->cond, &workers->lock);
+    if (!chunk->queued)
+      break;
+    mysql_mutex_unlock(&workers->lock);
+    tina_parse_chunk(chunk);
+    mysql_mutex_lock(&workers->lock);
+    chunk->queued= false;
+    if (!--workers->pending)
+      mysql_cond_signal(&workers->done_cond);
+  }
+  mysql_mutex_unlock(&workers->lock);
+  my_thread_end();
+  return 0;
+}
+
+
 static handler *tina_create_handler(handlerton *hton,
                                     TABLE_SHARE *table, 
                                     MEM_ROOT *mem_root)
@@ -522,8 +824,11 @@ ha_tina::ha_tina(handlerton *hton, TABLE_SHARE *table_arg)
   */
   current_position(0), next_position(0), local_saved_data_file_length(0),
   file_buff(0), chain_alloced(0), chain_size(DEFAULT_CHAIN_LENGTH),
-  local_data_file_version(0), records_is_known(0)
+  local_data_file_version(0), records_is_known(0), parse_chunks(0),
+  parse_threads(1), parse_chunks_alloced(0), parse_chunks_used(0),
+  parse_scan(0)
 {
+  parse_workers.started= 0;
   /* Set our original buffers from pre-allocated memory */
   buffer.set((char*)byte_buffer, IO_SIZE, &my_charset_bin);
   chain= chain_buffer;
@@ -644,7 +949,8 @@ int ha_tina::chain_append()
       if (chain_alloced)
       {
         if ((chain= (tina_set *) my_realloc(csv_key_memory_tina_set,
-                                            (uchar*)chain, chain_size,
+                                            (uchar*)chain,
+                                            chain_size * sizeof(tina_set),
                                             MYF(MY_WME))) == NULL)
           return -1;
       }
@@ -833,40 +1139,9 @@ int ha_tina::find_current_row(uchar *buf)
       }
     }
 
-    if (read_all || bitmap_is_set(table->read_set, (*field)->field_index))
-    {
-      bool is_enum= ((*field)->real_type() ==  MYSQL_TYPE_ENUM);
-      /*
-        Here CHECK_FIELD_WARN checks that all values in the csv file are valid
-        which is normally the case, if they were written  by
-        INSERT -> ha_tina::write_row. '0' values on ENUM fields are considered
-        invalid by Field_enum::store() but it can store them on INSERT anyway.
-        Thus, for enums we silence the warning, as it doesn't really mean
-        an invalid value.
-      */
-      if ((*field)->store_text(buffer.ptr(), buffer.length(), buffer.charset(),
-                               is_enum ? CHECK_FIELD_IGNORE : CHECK_FIELD_WARN))
-      {
-        if (!is_enum)
-          goto err;
-      }
-      if ((*field)->flags & BLOB_FLAG)
-      {
-        Field_blob *blob= *(Field_blob**) field;
-        uchar *src, *tgt;
-        uint length, packlength;
-
-        packlength= blob->pack_length_no_ptr();
-        length= blob->get_length(blob->ptr);
-        memcpy(&src, blob->ptr + packlength, sizeof(char*));
-        if (src)
-        {
-          tgt= (uchar*) alloc_root(&blobroot, length);
-          bmove(tgt, src, length);
-          memcpy(blob->ptr + packlength, &tgt, sizeof(char*));
-        }
-      }
-    }
+    if ((read_all || bitmap_is_set(table->read_set, (*field)->field_index)) &&
+        store_field(field, buffer.ptr(), buffer.length()))
+      goto err;
   }
   next_position= end_offset + eoln_len;
   error= 0;
@@ -877,6 +1152,267 @@ int ha_tina::find_current_row(uchar *buf)
   DBUG_RETURN(error);
 }
 
+
+/*
+  Store a value read from the data file in a field.
+
+  RETURN
+    0  ok
+    1  The value is not valid for the field
+*/
+
+bool ha_tina::store_field(Field **field, const char *from, size_t length)
+{
+  bool is_enum= ((*field)->real_type() ==  MYSQL_TYPE_ENUM);
+  /*
+    Here CHECK_FIELD_WARN checks that all values in the csv file are valid
+    which is normally the case, if they were written  by
+    INSERT -> ha_tina::write_row. '0' values on ENUM fields are considered
+    invalid by Field_enum::store() but it can store them on INSERT anyway.
+    Thus, for enums we silence the warning, as it doesn't really mean
+    an invalid value.
+  */
+  if ((*field)->store_text(from, length, &my_charset_bin,
+                           is_enum ? CHECK_FIELD_IGNORE : CHECK_FIELD_WARN))
+  {
+    if (!is_enum)
+      return 1;
+  }
+  if ((*field)->flags & BLOB_FLAG)
+  {
+    Field_blob *blob= *(Field_blob**) field;
+    uchar *src, *tgt;
+    uint length, packlength;
+
+    packlength= blob->pack_length_no_ptr();
+    length= blob->get_length(blob->ptr);
+    memcpy(&src, blob->ptr + packlength, sizeof(char*));
+    if (src)
+    {
+      tgt= (uchar*) alloc_root(&blobroot, length);
+      bmove(tgt, src, length);
+      memcpy(blob->ptr + packlength, &tgt, sizeof(char*));
+    }
+  }
+  return 0;
+}
+
+
+bool ha_tina::alloc_parse_chunks(uint count)
+{
+  if (parse_chunks_alloced >= count)
+    return 0;
+  free_parse_chunks();
+  if (!(parse_chunks= new tina_chunk[count]))
+    return 1;
+  parse_chunks_alloced= count;
+  return 0;
+}
+
+
+void ha_tina::free_parse_chunks()
+{
+  stop_parse_workers();
+  delete [] parse_chunks;
+  parse_chunks= 0;
+  parse_chunks_alloced= parse_chunks_used= 0;
+}
+
+
+/*
+  Start the threads that parse the chunks of the batches of a table scan.
+  Chunk 0 of a batch is parsed by the scanning thread, and chunk i by the
+  thread started for it. The chunks for which no thread could be started
+  are parsed by parse_batch() itself.
+*/
+
+void ha_tina::start_parse_workers()
+{
+  uint i;
+
+  if (parse_workers.started || parse_threads < 2)
+    return;
+  mysql_mutex_init(csv_key_mutex_tina_parse_workers_lock, &parse_workers.lock,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(csv_key_cond_tina_parse_workers_cond, &parse_workers.cond,
+                  NULL);
+  mysql_cond_init(csv_key_cond_tina_parse_workers_done_cond,
+                  &parse_workers.done_cond, NULL);
+  parse_workers.pending= 0;
+  parse_workers.stop= false;
+  for (i= 1; i < parse_threads; i++)
+  {
+    parse_chunks[i].workers= &parse_workers;
+    parse_chunks[i].queued= false;
+    if (mysql_thread_create(PSI_NOT_INSTRUMENTED, &parse_chunks[i].thread,
+                            NULL, tina_parse_thread, parse_chunks + i))
+      break;
+    parse_workers.started++;
+  }
+  if (!parse_workers.started)
+  {
+    mysql_cond_destroy(&parse_workers.done_cond);
+    mysql_cond_destroy(&parse_workers.cond);
+    mysql_mutex_destroy(&parse_workers.lock);
+  }
+}
+
+
+void ha_tina::stop_parse_workers()
+{
+  uint i;
+
+  if (!parse_workers.started)
+    return;
+  mysql_mutex_lock(&parse_workers.lock);
+  parse_workers.stop= true;
+  mysql_cond_broadcast(&parse_workers.cond);
+  mysql_mutex_unlock(&parse_workers.lock);
+  for (i= 1; i <= parse_workers.started; i++)
+    pthread_join(parse_chunks[i].thread, NULL);
+  parse_workers.started= 0;
+  mysql_cond_destroy(&parse_workers.done_cond);
+  mysql_cond_destroy(&parse_workers.cond);
+  mysql_mutex_destroy(&parse_workers.lock);
+}
+
+
+/*
+  Parse the next batch of rows of a table scan. The batch is split at
+  line endings into chunks, which are parsed in parallel by the threads
+  started in rnd_init(). The first one is done in this thread.
+*/
+
+int ha_tina::parse_batch()
+{
+  const uchar *data= file_buff->mapped();
+  my_off_t data_end= file_buff->end();
+  uint count, queued, i;
+  size_t chunk_size;
+  int rc= 0;
+  DBUG_ENTER("ha_tina::parse_batch");
+
+  parse_chunks_used= parse_chunk= 0;
+  parse_row= 0;
+  if (parse_offset >= data_end)
+    DBUG_RETURN(HA_ERR_END_OF_FILE);
+
+  count= (uint) MY_MIN(parse_threads,
+                       MY_MAX(parse_batch_size / TINA_PARSE_CHUNK_SIZE, 1));
+  chunk_size= parse_batch_size / count;
+  for (i= 0; i < count && parse_offset < data_end; i++)
+  {
+    tina_chunk *chunk= parse_chunks + i;
+    my_off_t end= parse_offset + chunk_size;
+
+    /* Let the chunk end after the end of line it ends in */
+    end= (end >= data_end ? data_end :
+          (my_off_t) (tina_next_line(data + end - 1, data + data_end) - data));
+    chunk->data= data;
+    chunk->begin= parse_offset;
+    chunk->end= end;
+    chunk->data_end= data_end;
+    chunk->fields= table->s->fields;
+    chunk->ietf_quotes= table_share->option_struct->ietf_quotes;
+    parse_offset= end;
+  }
+  parse_chunks_used= i;
+  if (parse_batch_size < (size_t) parse_threads * TINA_PARSE_CHUNK_SIZE)
+    parse_batch_size*= 2;
+
+  queued= MY_MIN(parse_workers.started + 1, parse_chunks_used) - 1;
+  if (queued)
+  {
+    mysql_mutex_lock(&parse_workers.lock);
+    for (i= 1; i <= queued; i++)
+      parse_chunks[i].queued= true;
+    parse_workers.pending= queued;
+    mysql_cond_broadcast(&parse_workers.cond);
+    mysql_mutex_unlock(&parse_workers.lock);
+  }
+  tina_parse_chunk(parse_chunks);
+  /* Chunks for which no thread could be started */
+  for (i= queued + 1; i < parse_chunks_used; i++)
+    tina_parse_chunk(parse_chunks + i);
+  if (queued)
+  {
+    mysql_mutex_lock(&parse_workers.lock);
+    while (parse_workers.pending)
+      mysql_cond_wait(&parse_workers.done_cond, &parse_workers.lock);
+    mysql_mutex_unlock(&parse_workers.lock);
+  }
+  for (i= 0; !rc && i < parse_chunks_used; i++)
+    rc= parse_chunks[i].error;
+  if (rc)
+    parse_chunks_used= 0;
+  DBUG_RETURN(rc);
+}
+
+
+/*
+  Return the next row of a table scan from the parsed batches.
+  Damaged rows are left to find_current_row(), so that they are
+  reported the same way as without parallel parsing.
+*/
+
+int ha_tina::read_parsed_row(uchar *buf)
+{
+  tina_chunk *chunk;
+  tina_row *row;
+  tina_value *value;
+  MY_BITMAP *org_bitmap;
+  bool read_all;
+  int rc;
+  DBUG_ENTER("ha_tina::read_parsed_row");
+
+  for (;;)
+  {
+    if (parse_chunk < parse_chunks_used)
+    {
+      chunk= parse_chunks + parse_chunk;
+      if (parse_row < chunk->row_count)
+        break;
+      parse_chunk++;
+      parse_row= 0;
+    }
+    else if ((rc= parse_batch()))
+      DBUG_RETURN(rc);
+  }
+
+  row= chunk->row(parse_row++);
+  current_position= row->begin;
+  if (row->bad)
+    DBUG_RETURN(find_current_row(buf));
+
+  free_root(&blobroot, MYF(0));
+  /* We must read all columns in case a table is opened for update */
+  read_all= !bitmap_is_clear_all(table->write_set);
+  /* Avoid asserts in ::store() for columns that are not going to be updated */
+  org_bitmap= dbug_tmp_use_all_columns(table, &table->write_set);
+  memset(buf, 0, table->s->null_bytes);
+
+  rc= 0;
+  value= (tina_value*) (row + 1);
+  for (Field **field=table->field ; *field ; field++, value++)
+  {
+    if (read_all || bitmap_is_set(table->read_set, (*field)->field_index))
+    {
+      const uchar *from= ((value->decoded ?
+                           (const uchar*) chunk->decoded.ptr() : chunk->data) +
+                          value->offset);
+      if (store_field(field, (const char*) from, value->length))
+      {
+        rc= HA_ERR_CRASHED_ON_USAGE;
+        break;
+      }
+    }
+  }
+  dbug_tmp_restore_column_map(&table->write_set, org_bitmap);
+  if (!rc)
+    next_position= row->end;
+  DBUG_RETURN(rc);
+}
+
 /*
   Three functions below are needed to enable concurrent insert functionality
   for CSV engine. For more details see mysys/thr_lock.c
@@ -1012,6 +1548,8 @@ int ha_tina::close(void)
   int rc= 0;
   DBUG_ENTER("ha_tina::close");
   free_root(&blobroot, MYF(0));
+  free_parse_chunks();
+  file_buff->unmap_file();
   rc= mysql_file_close(data_file, MYF(0));
   DBUG_RETURN(free_share(share) || rc);
 }
@@ -1222,6 +1760,34 @@ int ha_tina::rnd_init(bool scan)
   records_is_known= found_end_of_file= 0;
   chain_ptr= chain;
 
+  /*
+    Map the data file if possible. A scan then parses it in batches
+    ahead of the rows returned. find_eoln_buff() sees no rows at all in a
+    file that starts with an end of line, that is left to it.
+  */
+  parse_scan= (!file_buff->map_file(data_file, local_saved_data_file_length) &&
+               scan && file_buff->mapped()[0] != '\n' &&
+               file_buff->mapped()[0] != '\r');
+  parse_offset= 0;
+  parse_chunks_used= parse_chunk= 0;
+  parse_row= 0;
+  parse_batch_size= TINA_PARSE_BATCH_START;
+
+  /*
+    The helper threads of a scan that was not ended are kept, unless
+    csv_parse_threads was changed since.
+  */
+  if (parse_scan)
+  {
+    uint threads= MY_MAX(tina_parse_threads, 1);
+    if (threads != parse_threads)
+      stop_parse_workers();
+    parse_threads= threads;
+    if (alloc_parse_chunks(parse_threads))
+      DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+    start_parse_workers();
+  }
+
   DBUG_RETURN(0);
 }
 
@@ -1261,7 +1827,7 @@ int ha_tina::rnd_next(uchar *buf)
     goto end;
   }
 
-  if ((rc= find_current_row(buf)))
+  if ((rc= parse_scan ? read_parsed_row(buf) : find_current_row(buf)))
     goto end;
 
   stats.records++;
@@ -1382,6 +1948,9 @@ int ha_tina::rnd_end()
   DBUG_ENTER("ha_tina::rnd_end");
 
   records_is_known= found_end_of_file;
+  parse_scan= FALSE;
+  stop_parse_workers();
+  file_buff->unmap_file();
 
   if ((chain_ptr - chain)  > 0)
   {
@@ -1801,6 +2370,9 @@ int ha_tina::check(THD* thd, HA_CHECK_OPT* check_opt)
 int ha_tina::reset(void)
 {
   free_root(&blobroot, MYF(0));
+  parse_scan= FALSE;
+  stop_parse_workers();
+  file_buff->unmap_file();
   return 0;
 }
 
@@ -1830,7 +2402,7 @@ maria_declare_plugin(csv)
   tina_done_func, /* Plugin Deinit */
   0x0100 /* 1.0 */,
   NULL,                       /* status variables                */
-  NULL,                       /* system variables                */
+  tina_system_variables,      /* system variables                */
   "1.0",                      /* string version */
   MariaDB_PLUGIN_MATURITY_STABLE /* maturity */
 }
@@ -57,6 +57,65 @@ struct tina_set {
   my_off_t end;
 };
 
+/*
+  A row found by tina_parse_chunk(). It is followed in tina_chunk::rows
+  by a tina_value for each field of the table.
+*/
+struct tina_row {
+  my_off_t begin;           /* Position of the row in the data file */
+  my_off_t end;             /* Position of the next row */
+  bool bad;                 /* Row is damaged, values are not set */
+};
+
+/*
+  The value of a field: either a piece of the mapped data file or, if it
+  had to be unescaped, a piece of tina_chunk::decoded.
+*/
+struct tina_value {
+  size_t offset;
+  uint32 length;
+  bool decoded;
+};
+
+/*
+  The threads that parse the chunks of the batches of a table scan. They
+  are started by ha_tina::rnd_init() and wait between the batches.
+*/
+struct tina_parse_workers {
+  mysql_mutex_t lock;
+  mysql_cond_t cond;        /* A batch is ready or the threads are to stop */
+  mysql_cond_t done_cond;   /* The last chunk of a batch was parsed */
+  uint started;             /* Threads running */
+  uint pending;             /* Chunks of the batch not parsed yet */
+  bool stop;
+};
+
+/*
+  A part of a mapped data file, that holds only whole rows and is split
+  into rows and values by a single thread during a table scan.
+*/
+struct tina_chunk {
+  const uchar *data;        /* The mapped data file */
+  my_off_t begin, end;      /* The part of the file to parse */
+  my_off_t data_end;        /* Length of the mapped data file */
+  uint fields;
+  bool ietf_quotes;
+  int error;
+  uchar *rows;              /* tina_row + tina_value[fields], ... */
+  size_t row_count, rows_alloced;
+  String decoded;
+  tina_parse_workers *workers;
+  pthread_t thread;
+  bool queued;              /* To be parsed by its thread */
+
+  tina_chunk() : rows(0), row_count(0), rows_alloced(0), queued(0) {}
+  ~tina_chunk() { my_free(rows); }
+  size_t row_length() const
+  { return sizeof(tina_row) + fields * sizeof(tina_value); }
+  tina_row *row(size_t nr) const
+  { return (tina_row*) (rows + nr * row_length()); }
+};
+
 class ha_tina final : public handler
 {
   THR_LOCK_DATA lock;      /* MySQL lock */
@@ -83,6 +142,18 @@ class ha_tina final : public handler
   uint local_data_file_version;  /* Saved version of the data file used */
   bool records_is_known, found_end_of_file;
   MEM_ROOT blobroot;
+  /*
+    A table scan of a mapped data file parses batches of rows ahead,
+    split into chunks that are parsed in parallel.
+  */
+  tina_chunk *parse_chunks;
+  tina_parse_workers parse_workers;
+  uint parse_threads;        /* Threads of the scan, this one included */
+  uint parse_chunks_alloced, parse_chunks_used, parse_chunk;
+  size_t parse_row;
+  my_off_t parse_offset;     /* Where the next batch starts */
+  size_t parse_batch_size;
+  bool parse_scan;
 
 private:
   int curr_lock_type;
@@ -91,6 +162,13 @@ class ha_tina final : public handler
   int open_update_temp_file_if_needed();
   int init_tina_writer();
   int init_data_file();
+  bool alloc_parse_chunks(uint count);
+  void free_parse_chunks();
+  void start_parse_workers();
+  void stop_parse_workers();
+  int parse_batch();
+  int read_parsed_row(uchar *buf);
+  bool store_field(Field **field, const char *from, size_t length);
 
 public:
   ha_tina(handlerton *hton, TABLE_SHARE *table_arg);
@@ -100,6 +178,7 @@ class ha_tina final : public handler
       my_free(chain);
     if (file_buff)
       delete file_buff;
+    free_parse_chunks();
     free_root(&blobroot, MYF(0));
   }
   const char *index_type(uint inx) { return "NONE"; }
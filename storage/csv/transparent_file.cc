@@ -25,7 +25,8 @@
 
 PSI_memory_key csv_key_memory_Transparent_file;
 
-Transparent_file::Transparent_file() : lower_bound(0), buff_size(IO_SIZE)
+Transparent_file::Transparent_file() : map(0), lower_bound(0),
+  buff_size(IO_SIZE)
 { 
   buff= (uchar *) my_malloc(csv_key_memory_Transparent_file,
                             buff_size*sizeof(uchar),  MYF(MY_WME));
@@ -33,11 +34,13 @@ Transparent_file::Transparent_file() : lower_bound(0), buff_size(IO_SIZE)
 
 Transparent_file::~Transparent_file()
 { 
+  unmap_file();
   my_free(buff);
 }
 
 void Transparent_file::init_buff(File filedes_arg)
 {
+  unmap_file();
   filedes= filedes_arg;
   /* read the beginning of the file */
   lower_bound= 0;
@@ -46,9 +49,61 @@ void Transparent_file::init_buff(File filedes_arg)
     upper_bound= mysql_file_read(filedes, buff, buff_size, MYF(0));
 }
 
+/*
+  Map the first "length" bytes of the file into memory, so that they can
+  be accessed without copying. Data appended to the file later, like by a
+  concurrent insert, is not visible through the map.
+
+  Reading a mapped page past the end of the file raises SIGBUS, so the
+  file is not mapped if it is now shorter than "length". This happens
+  when the file was cut from outside the server; the engine itself only
+  truncates the file under a write lock, when no scan is running.
+
+  RETURN
+    0  ok
+    1  The file could not be mapped; init_buff() is used instead
+*/
+
+bool Transparent_file::map_file(File filedes_arg, my_off_t length)
+{
+  MY_STAT stat_info;
+  unmap_file();
+  if (!length || length > (my_off_t) (~((size_t) 0)) ||
+      mysql_file_fstat(filedes_arg, &stat_info, MYF(0)) ||
+      (my_off_t) stat_info.st_size < length)
+  {
+    init_buff(filedes_arg);
+    return 1;
+  }
+  map= (uchar*) my_mmap(0, (size_t) length, PROT_READ, MAP_SHARED,
+                        filedes_arg, 0L);
+  if (map == (uchar*) MAP_FAILED)
+  {
+    map= 0;
+    init_buff(filedes_arg);
+    return 1;
+  }
+#if defined(HAVE_MADVISE)
+  madvise((char*) map, (size_t) length, MADV_SEQUENTIAL);
+#endif
+  filedes= filedes_arg;
+  lower_bound= 0;
+  upper_bound= length;
+  return 0;
+}
+
+void Transparent_file::unmap_file()
+{
+  if (map)
+  {
+    my_munmap((char*) map, (size_t) upper_bound);
+    map= 0;
+  }
+}
+
 uchar *Transparent_file::ptr()
 { 
-  return buff; 
+  return map ? map : buff;
 }
 
 my_off_t Transparent_file::start()
@@ -65,6 +120,10 @@ my_off_t Transparent_file::read_next()
 {
   size_t bytes_read;
 
+  /* The whole mapped area is a single window */
+  if (map)
+    return (my_off_t) -1;
+
   /*
      No need to seek here, as the file managed by Transparent_file class
      always points to upper_bound byte
@@ -88,6 +147,9 @@ char Transparent_file::get_value(my_off_t offset)
 {
   size_t bytes_read;
 
+  if (map)
+    return offset < upper_bound ? (char) map[offset] : 0;
+
   /* check boundaries */
   if ((lower_bound <= offset) && (((my_off_t) offset) < upper_bound))
     return buff[offset - lower_bound];
@@ -24,6 +24,7 @@ class Transparent_file
 {
   File filedes;
   uchar *buff;  /* in-memory window to the file or mmaped area */
+  uchar *map;   /* The mapped beginning of the file, if map_file() was used */
   /* current window sizes */
   my_off_t lower_bound;
   my_off_t upper_bound;
@@ -35,6 +36,9 @@ class Transparent_file
   ~Transparent_file();
 
   void init_buff(File filedes_arg);
+  bool map_file(File filedes_arg, my_off_t length);
+  void unmap_file();
+  const uchar *mapped() { return map; }
   uchar *ptr();
   my_off_t start();
   my_off_t end();
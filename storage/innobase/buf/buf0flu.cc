@@ -38,6 +38,7 @@ Created 11/11/1995 Heikki Tuuri
 #include "page0zip.h"
 #include "fil0fil.h"
 #include "log0crypt.h"
+#include "log0online.h"
 #include "srv0mon.h"
 #include "fil0pagecompress.h"
 #include "lzo/lzo1x.h"
@@ -917,6 +918,10 @@ inline bool buf_page_t::flush(bool lru, fil_space_t *space)
     write_frame= page;
   }
 
+  if (UNIV_UNLIKELY(srv_track_changed_pages) &&
+      space->purpose != FIL_TYPE_TEMPORARY)
+    log_online_track_page(id());
+
   if ((s & LRU_MASK) == REINIT || !space->use_doublewrite())
   {
     if (UNIV_LIKELY(space->purpose == FIL_TYPE_TABLESPACE))
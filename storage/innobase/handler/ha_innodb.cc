@@ -90,6 +90,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "ibuf0ibuf.h"
 #include "lock0lock.h"
 #include "log0crypt.h"
+#include "log0online.h"
 #include "mtr0mtr.h"
 #include "os0file.h"
 #include "page0zip.h"
@@ -18314,6 +18315,31 @@ innobase_fts_find_ranking(FT_INFO* fts_hdl, uchar*, uint)
 	return(fts_retrieve_ranking(result, ft_prebuilt->fts_doc_id));
 }
 
+/** Dummy for SET GLOBAL innodb_flush_changed_page_bitmaps=ON */
+static my_bool	innodb_flush_changed_page_bitmaps;
+
+/** Write the pages that were recorded by innodb_track_changed_pages
+so far, so that mariabackup --incremental can read them. */
+static void
+innodb_flush_changed_page_bitmaps_update(THD *thd, st_mysql_sys_var*, void*,
+                                         const void *save)
+{
+  if (!*static_cast<const my_bool*>(save))
+    return;
+  if (!srv_track_changed_pages)
+  {
+    push_warning(thd, Sql_condition::WARN_LEVEL_WARN, HA_ERR_WRONG_COMMAND,
+                 "InnoDB: innodb_track_changed_pages is not enabled");
+    return;
+  }
+  mysql_mutex_unlock(&LOCK_global_system_variables);
+  const bool ok= log_online_write_run(true);
+  mysql_mutex_lock(&LOCK_global_system_variables);
+  if (!ok)
+    push_warning(thd, Sql_condition::WARN_LEVEL_WARN, ER_ERROR_ON_WRITE,
+                 "InnoDB: Failed to write the changed page bitmap");
+}
+
 #ifdef UNIV_DEBUG
 static my_bool	innodb_log_checkpoint_now = TRUE;
 static my_bool	innodb_buf_flush_list_now = TRUE;
@@ -18840,6 +18866,12 @@ static MYSQL_SYSVAR_BOOL(stats_include_delete_marked,
   "Include delete marked records when calculating persistent statistics",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_UINT(import_threads, srv_import_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for converting the pages of a tablespace"
+  " in ALTER TABLE...IMPORT TABLESPACE",
+  NULL, NULL, 4, 1, 32, 0);
+
 static MYSQL_SYSVAR_ENUM(instant_alter_column_allowed,
 			 innodb_instant_alter_column_allowed,
   PLUGIN_VAR_RQCMDARG,
@@ -19310,6 +19342,13 @@ static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   "Maximum modification log file size for online index creation",
   NULL, NULL, 128<<20, 65536, ~0ULL, 0);
 
+static MYSQL_SYSVAR_UINT(online_alter_log_apply_threads,
+  srv_online_apply_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for applying the modification log"
+  " of online index creation",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_BOOL(optimize_fulltext_only, innodb_optimize_fulltext_only,
   PLUGIN_VAR_NOCMDARG,
   "Only optimize the Fulltext index of the table",
@@ -19330,6 +19369,12 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt. Value 5 can return bogus data, and 6 can permanently corrupt data.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_BOOL(recovery_parallel_init, srv_recovery_parallel_init,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "During crash recovery, initialize the pages that are not read from the"
+  " data files in innodb_read_io_threads threads.",
+  NULL, NULL, TRUE);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Page size to use for all InnoDB tablespaces.",
@@ -19410,6 +19455,24 @@ static MYSQL_SYSVAR_ULONGLONG(max_undo_log_size, srv_max_undo_log_size,
   10 << 20, 10 << 20,
   1ULL << (32 + UNIV_PAGE_SIZE_SHIFT_MAX), 0);
 
+static MYSQL_SYSVAR_BOOL(track_changed_pages, srv_track_changed_pages,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Record the written pages in ib_modified_log_*.xdb files,"
+  " for mariabackup --incremental",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONGLONG(max_bitmap_file_size, srv_max_bitmap_file_size,
+  PLUGIN_VAR_OPCMDARG,
+  "Size of a changed page bitmap file after which a new file is started",
+  NULL, NULL,
+  100 << 20, 4096, ULLONG_MAX, 0);
+
+static MYSQL_SYSVAR_BOOL(flush_changed_page_bitmaps,
+  innodb_flush_changed_page_bitmaps,
+  PLUGIN_VAR_OPCMDARG,
+  "Write the pages recorded by innodb_track_changed_pages so far",
+  NULL, innodb_flush_changed_page_bitmaps_update, FALSE);
+
 static MYSQL_SYSVAR_ULONG(purge_rseg_truncate_frequency,
   srv_purge_rseg_truncate_frequency,
   PLUGIN_VAR_OPCMDARG,
@@ -19770,6 +19833,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(flush_log_at_trx_commit),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
+  MYSQL_SYSVAR(recovery_parallel_init),
   MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
@@ -19820,6 +19884,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(online_alter_log_apply_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19842,6 +19907,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(read_ahead_threshold),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(read_only_compressed),
+  MYSQL_SYSVAR(import_threads),
   MYSQL_SYSVAR(instant_alter_column_allowed),
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
@@ -19861,6 +19927,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(print_all_deadlocks),
   MYSQL_SYSVAR(cmp_per_index_enabled),
   MYSQL_SYSVAR(max_undo_log_size),
+  MYSQL_SYSVAR(track_changed_pages),
+  MYSQL_SYSVAR(max_bitmap_file_size),
+  MYSQL_SYSVAR(flush_changed_page_bitmaps),
   MYSQL_SYSVAR(purge_rseg_truncate_frequency),
   MYSQL_SYSVAR(undo_log_truncate),
   MYSQL_SYSVAR(undo_directory),
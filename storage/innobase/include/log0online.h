@@ -0,0 +1,146 @@
+/*****************************************************************************
+
+Copyright (c) 2011-2012 Percona Inc. All Rights Reserved.
+Copyright (c) 2022, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/log0online.h
+Changed page tracking for incremental backups (innodb_track_changed_pages)
+
+The identifiers of persistent pages are recorded when the pages are
+submitted for writing, and the accumulated set is written as a "run" of
+bitmap blocks to files ib_modified_log_<seq>_<lsn>.xdb in the data home
+directory. All blocks of a run carry the same pair of LSN:
+
+MODIFIED_PAGE_START_LSN is the latest checkpoint C at the time the run
+was written. Every page that was modified at or before C has been
+written, and thus recorded in this run or an earlier one.
+
+MODIFIED_PAGE_END_LSN is the current LSN H at the time the run was
+written. Every page that is modified after H will be recorded in a
+later run.
+
+The <lsn> in a file name plays the role of H for the first run of the
+file. So, the pages modified in (L, E] are covered by the runs starting
+from the first one whose H > L, up to and including the first one
+whose C >= E.
+*******************************************************/
+
+#ifndef log0online_h
+#define log0online_h
+
+#include "log0types.h"
+#include "buf0types.h"
+#include "mach0data.h"
+
+/** File name stem for bitmap files. */
+static constexpr const char *bmp_file_name_stem= "ib_modified_log_";
+
+/** The bitmap file block size in bytes.  All writes will be multiples of this.
+ */
+enum {
+	MODIFIED_PAGE_BLOCK_SIZE = 4096
+};
+
+/** Offsets in a file bitmap block */
+enum {
+	MODIFIED_PAGE_IS_LAST_BLOCK = 0,/* 1 if last block in the current
+					write, 0 otherwise. */
+	MODIFIED_PAGE_START_LSN = 4,	/* The checkpoint LSN C of this and
+					other blocks in the same write */
+	MODIFIED_PAGE_END_LSN = 12,	/* The current LSN H of this and
+					other blocks in the same write */
+	MODIFIED_PAGE_SPACE_ID = 20,	/* The space ID of tracked pages in
+					this block */
+	MODIFIED_PAGE_1ST_PAGE_ID = 24,	/* The page ID of the first tracked
+					page in this block */
+	MODIFIED_PAGE_BLOCK_UNUSED_1 = 28,/* Unused in order to align the start
+					  of bitmap at 8 byte boundary */
+	MODIFIED_PAGE_BLOCK_BITMAP = 32,/* Start of the bitmap itself */
+	MODIFIED_PAGE_BLOCK_UNUSED_2 = MODIFIED_PAGE_BLOCK_SIZE - 8,
+					/* Unused in order to align the end of
+					bitmap at 8 byte boundary */
+	MODIFIED_PAGE_BLOCK_CHECKSUM = MODIFIED_PAGE_BLOCK_SIZE - 4
+					/* The checksum of the current block */
+};
+
+/** Length of the bitmap data in a block */
+enum { MODIFIED_PAGE_BLOCK_BITMAP_LEN
+       = MODIFIED_PAGE_BLOCK_UNUSED_2 - MODIFIED_PAGE_BLOCK_BITMAP };
+
+/** Length of the bitmap data in a block in page ids */
+enum { MODIFIED_PAGE_BLOCK_ID_COUNT = MODIFIED_PAGE_BLOCK_BITMAP_LEN * 8 };
+
+/** The unit of the bitmap; bit i of a block is bit (i & 63) of
+word (i >> 6), in native byte order */
+typedef uint64_t	bitmap_word_t;
+
+/** Calculate a bitmap block checksum.  Algorithm borrowed from
+log_block_calc_checksum.
+@param block  bitmap block
+@return checksum */
+inline ulint log_online_calc_checksum(const byte *block)
+{
+	ulint	sum = 1;
+	ulint	sh = 0;
+
+	for (ulint i = 0; i < MODIFIED_PAGE_BLOCK_CHECKSUM; i++) {
+		ulint	b = block[i];
+		sum &= 0x7FFFFFFFUL;
+		sum += b;
+		sum += b << sh;
+		sh++;
+		if (sh > 24) {
+			sh = 0;
+		}
+	}
+
+	return sum;
+}
+
+/** Start recording written pages, before any page can be written
+during startup. Resets srv_track_changed_pages if tracking is not
+possible. */
+void log_online_init();
+
+/** Start the first bitmap file.
+@param lsn  the LSN after which all page modifications will be written
+            after this call (the end of the recovered log) */
+void log_online_start(lsn_t lsn);
+
+/** Record a page that is being written.
+@param id  page identifier */
+void log_online_track_page(const page_id_t id);
+
+/** Record a range of pages that were written bypassing the buffer pool.
+@param space_id  tablespace identifier
+@param first     first page number
+@param n_pages   number of pages */
+void log_online_track_pages(uint32_t space_id, uint32_t first,
+                            uint32_t n_pages);
+
+/** Write the pages recorded so far as a run to the bitmap file.
+@param force  whether to write a run even if no checkpoint was made since
+              the previous run
+@return whether the run was written successfully (or there was
+nothing to write) */
+bool log_online_write_run(bool force);
+
+/** Write the final run at shutdown and stop the tracking. */
+void log_online_close();
+
+#endif /* log0online_h */
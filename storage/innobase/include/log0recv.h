@@ -129,6 +129,8 @@ struct page_recv_t
     RECV_NOT_PROCESSED,
     /** not processed; the page will be reinitialized */
     RECV_WILL_NOT_READ,
+    /** RECV_WILL_NOT_READ, queued in recv_sys_t::init_queue */
+    RECV_BEING_INITIALIZED,
     /** page is being read */
     RECV_BEING_READ,
     /** log records are being applied on the page */
@@ -224,6 +226,11 @@ struct recv_sys_t
   lsn_t file_checkpoint;
   /** the time when progress was last reported */
   time_t progress_time;
+  /** my_interval_timer() at the start of the current batch */
+  ulonglong apply_start_time;
+  /** number of pages to which log was applied in the current batch;
+  protected by mutex */
+  size_t pages_applied;
 
   using map = std::map<const page_id_t, page_recv_t,
                        std::less<const page_id_t>,
@@ -273,6 +280,21 @@ struct recv_sys_t
   @retval nullptr if the page cannot be initialized based on log records */
   buf_block_t *recover_low(const page_id_t page_id);
 
+  /** Pages in the RECV_BEING_INITIALIZED state, to be processed by
+  init_pages(); protected by mutex */
+  std::vector<page_id_t> init_queue;
+  /** number of submitted init_pages() tasks that have not finished;
+  protected by mutex */
+  ulint n_init_tasks;
+public:
+  /** Initialize the pages in init_queue. Executed concurrently in
+  up to srv_n_read_io_threads tasks of srv_thread_pool. */
+  void init_pages();
+private:
+  /** Queue a RECV_WILL_NOT_READ page for init_pages().
+  @param p  iterator pointing to the page */
+  inline void queue_init(map::iterator p);
+
   /** All found log files (multiple ones are possible if we are upgrading
   from before MariaDB Server 10.5.1) */
   std::vector<log_file_t> files;
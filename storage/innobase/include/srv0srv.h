@@ -211,6 +211,10 @@ extern my_bool	srv_file_per_table;
 extern ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
+/** innodb_online_alter_log_apply_threads */
+extern uint	srv_online_apply_threads;
+/** innodb_import_threads */
+extern uint	srv_import_threads;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -242,6 +246,12 @@ extern uint32_t srv_undo_tablespaces_active;
 /** Maximum size of undo tablespace. */
 extern unsigned long long	srv_max_undo_log_size;
 
+/** Whether written pages are recorded for incremental backups
+(innodb_track_changed_pages) */
+extern my_bool	srv_track_changed_pages;
+/** Size of a changed page bitmap file after which a new one is started */
+extern unsigned long long	srv_max_bitmap_file_size;
+
 extern uint	srv_n_fil_crypt_threads;
 extern uint	srv_n_fil_crypt_threads_started;
 
@@ -336,6 +346,9 @@ extern double	srv_adaptive_flushing_lwm;
 extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
+/** innodb_recovery_parallel_init: whether crash recovery initializes
+the pages that are not read in srv_n_read_io_threads tasks */
+extern my_bool	srv_recovery_parallel_init;
 
 /** innodb_fast_shutdown=1 skips purge and change buffer merge.
 innodb_fast_shutdown=2 effectively crashes the server (no log checkpoint).
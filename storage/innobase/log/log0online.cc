@@ -0,0 +1,367 @@
+/*****************************************************************************
+
+Copyright (c) 2011-2012 Percona Inc. All Rights Reserved.
+Copyright (c) 2022, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file log/log0online.cc
+Changed page tracking for incremental backups (innodb_track_changed_pages)
+
+Unlike the XtraDB implementation, which parsed the redo log in a
+dedicated thread, the page identifiers are collected when pages are
+submitted for writing. A page write only appends the page identifier to
+one of LOG_ONLINE_SHARDS buffers. The buffers are merged into bitmap
+blocks when a run is written after a checkpoint.
+*******************************************************/
+
+#include "log0online.h"
+#include "log.h"
+#include "log0log.h"
+#include "srv0srv.h"
+#include "srv0start.h"
+#include "os0file.h"
+#include "my_dir.h"
+#include "srw_lock.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+/** A bitmap block of the current run */
+struct log_online_block_t
+{
+  alignas(8) byte data[MODIFIED_PAGE_BLOCK_SIZE];
+};
+
+/** Number of buffers of recorded page identifiers */
+static constexpr size_t LOG_ONLINE_SHARDS= 64;
+/** Minimum size of a buffer at which duplicates are removed */
+static constexpr size_t LOG_ONLINE_COMPACT_MIN= 4096;
+
+/** Identifiers of the pages that were written since the latest run */
+struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) log_online_shard_t
+{
+  /** protects the fields below */
+  srw_spin_mutex mutex;
+  /** page_id_t::raw() of the written pages; may contain duplicates */
+  std::vector<uint64_t> pages;
+  /** size of pages at which duplicates will be removed */
+  size_t compact_at;
+};
+
+static log_online_shard_t log_online_shards[LOG_ONLINE_SHARDS];
+
+/** The state of changed page tracking */
+static struct
+{
+  /** serializes log_online_write_run() and protects the fields below */
+  mysql_mutex_t write_mutex;
+  /** the current bitmap file */
+  pfs_os_file_t file;
+  /** whether file is open */
+  bool file_open;
+  /** name of the current bitmap file */
+  char name[FN_REFLEN];
+  /** size of the current bitmap file */
+  uint64_t offset;
+  /** sequence number of the next bitmap file */
+  ulong next_seq;
+  /** MODIFIED_PAGE_END_LSN of the latest run, or the LSN that
+  was passed to log_online_start() */
+  lsn_t end_lsn;
+  /** MODIFIED_PAGE_START_LSN of the latest run */
+  lsn_t checkpoint_lsn;
+  /** whether log_online_init() was invoked */
+  bool initialized;
+  /** whether log_online_start() was invoked */
+  bool started;
+} log_online;
+
+/** Start recording written pages, before any page can be written
+during startup. Resets srv_track_changed_pages if tracking is not
+possible. */
+void log_online_init()
+{
+  if (!srv_track_changed_pages)
+    return;
+  if (srv_read_only_mode || srv_operation != SRV_OPERATION_NORMAL)
+  {
+    srv_track_changed_pages= false;
+    return;
+  }
+
+  for (log_online_shard_t &shard : log_online_shards)
+  {
+    shard.mutex.init();
+    shard.compact_at= LOG_ONLINE_COMPACT_MIN;
+  }
+  mysql_mutex_init(0, &log_online.write_mutex, nullptr);
+  log_online.file_open= false;
+  log_online.next_seq= 1;
+  log_online.started= false;
+  log_online.initialized= true;
+}
+
+/** Start the first bitmap file.
+@param lsn  the LSN after which all page modifications will be written
+            after this call (the end of the recovered log) */
+void log_online_start(lsn_t lsn)
+{
+  if (!srv_track_changed_pages)
+    return;
+
+  mysql_mutex_lock(&log_online.write_mutex);
+  /* Never append to an existing file, because it may end in
+  an incomplete run. */
+  if (MY_DIR *dir= my_dir(srv_data_home, MYF(0)))
+  {
+    for (size_t i= 0; i < dir->number_of_files; i++)
+    {
+      char stem[FN_REFLEN];
+      ulong seq;
+      lsn_t start_lsn;
+      if (sscanf(dir->dir_entry[i].name, "%[a-z_]%lu_" LSN_PF ".xdb",
+                 stem, &seq, &start_lsn) == 3 &&
+          !strcmp(stem, bmp_file_name_stem) && seq >= log_online.next_seq)
+        log_online.next_seq= seq + 1;
+    }
+    my_dirend(dir);
+  }
+
+  log_online.end_lsn= lsn;
+  log_online.checkpoint_lsn= 0;
+  log_online.started= true;
+  mysql_mutex_unlock(&log_online.write_mutex);
+}
+
+/** Set the bit of a page in a run.
+@param blocks  the blocks of the run, by (space_id << 32 | first page)
+@param id      page_id_t::raw() of the page */
+static void log_online_set_bit(std::map<uint64_t, log_online_block_t> &blocks,
+                               uint64_t id)
+{
+  const uint32_t bit= uint32_t(id) % MODIFIED_PAGE_BLOCK_ID_COUNT;
+  log_online_block_t &block= blocks[id - bit];
+  reinterpret_cast<bitmap_word_t*>
+    (block.data + MODIFIED_PAGE_BLOCK_BITMAP)[bit >> 6]|=
+    bitmap_word_t{1} << (bit & 63);
+}
+
+/** Record a page that is being written.
+@param id  page identifier */
+void log_online_track_page(const page_id_t id)
+{
+  ut_ad(log_online.initialized);
+  log_online_shard_t &shard= log_online_shards[id.fold() % LOG_ONLINE_SHARDS];
+  shard.mutex.wr_lock();
+  shard.pages.push_back(id.raw());
+  if (UNIV_UNLIKELY(shard.pages.size() >= shard.compact_at))
+  {
+    /* Runs are only written after a checkpoint. Until then, keep the
+    buffer from growing with pages that are written many times. */
+    std::sort(shard.pages.begin(), shard.pages.end());
+    shard.pages.erase(std::unique(shard.pages.begin(), shard.pages.end()),
+                      shard.pages.end());
+    shard.compact_at= std::max(LOG_ONLINE_COMPACT_MIN,
+                               2 * shard.pages.size());
+  }
+  shard.mutex.wr_unlock();
+}
+
+/** Record a range of pages that were written bypassing the buffer pool.
+@param space_id  tablespace identifier
+@param first     first page number
+@param n_pages   number of pages */
+void log_online_track_pages(uint32_t space_id, uint32_t first,
+                            uint32_t n_pages)
+{
+  if (!srv_track_changed_pages)
+    return;
+  for (uint32_t i= 0; i < n_pages; i++)
+    log_online_track_page(page_id_t{space_id, first + i});
+}
+
+/** Create the next bitmap file, named after log_online.end_lsn.
+@return whether the file was created */
+static bool log_online_create_file()
+{
+  mysql_mutex_assert_owner(&log_online.write_mutex);
+  ut_ad(!log_online.file_open);
+
+  const size_t len= strlen(srv_data_home);
+  const char sep[2]=
+    {len && srv_data_home[len - 1] != FN_LIBCHAR ? FN_LIBCHAR : '\0', '\0'};
+  snprintf(log_online.name, sizeof log_online.name,
+           "%s%s%s%lu_" LSN_PF ".xdb", srv_data_home, sep,
+           bmp_file_name_stem, log_online.next_seq++, log_online.end_lsn);
+
+  bool success;
+  log_online.file=
+    os_file_create_simple_no_error_handling(innodb_data_file_key,
+                                            log_online.name, OS_FILE_CREATE,
+                                            OS_FILE_READ_WRITE, false,
+                                            &success);
+  if (!success)
+  {
+    sql_print_error("InnoDB: Cannot create changed page bitmap file %s",
+                    log_online.name);
+    return false;
+  }
+
+  log_online.file_open= true;
+  log_online.offset= 0;
+  return true;
+}
+
+/** Close the current bitmap file. */
+static void log_online_close_file()
+{
+  mysql_mutex_assert_owner(&log_online.write_mutex);
+  if (log_online.file_open)
+  {
+    os_file_close(log_online.file);
+    log_online.file_open= false;
+  }
+}
+
+/** Write the pages recorded so far as a run to the bitmap file.
+@param force  whether to write a run even if no checkpoint was made since
+              the previous run
+@return whether the run was written successfully (or there was
+nothing to write) */
+bool log_online_write_run(bool force)
+{
+  if (!srv_track_changed_pages)
+    return true;
+
+  mysql_mutex_lock(&log_online.write_mutex);
+  if (!log_online.started)
+  {
+    mysql_mutex_unlock(&log_online.write_mutex);
+    return true;
+  }
+
+  /* Read the checkpoint before the buffers: every page that was
+  modified at or before the checkpoint must already have been recorded. */
+  std::map<uint64_t, log_online_block_t> blocks;
+  std::vector<uint64_t> pages;
+  const lsn_t checkpoint_lsn= log_sys.last_checkpoint_lsn;
+  lsn_t end_lsn;
+  bool success= true;
+
+  if (!force && checkpoint_lsn == log_online.checkpoint_lsn)
+    goto func_exit;
+
+  for (log_online_shard_t &shard : log_online_shards)
+  {
+    shard.mutex.wr_lock();
+    pages.swap(shard.pages);
+    shard.compact_at= LOG_ONLINE_COMPACT_MIN;
+    shard.mutex.wr_unlock();
+    if (&shard == log_online_shards)
+      DEBUG_SYNC_C("log_online_write_run_swap");
+    for (const uint64_t id : pages)
+      log_online_set_bit(blocks, id);
+    pages.clear();
+  }
+
+  /* Read the LSN after the last buffer was taken. A page that was
+  modified and written while the buffers were being taken may have
+  been recorded in this run, which must then end after its LSN. Every
+  page that will be recorded after this point will be in a later run. */
+  end_lsn= log_sys.get_lsn();
+
+  if (blocks.empty())
+    /* An empty run only advances the LSN. */
+    blocks[0];
+
+  if (log_online.file_open && log_online.offset >= srv_max_bitmap_file_size)
+    log_online_close_file();
+
+  if (!log_online.file_open && !log_online_create_file())
+  {
+    success= false;
+    goto func_exit;
+  }
+
+  for (auto b= blocks.begin(); b != blocks.end(); )
+  {
+    byte *block= b->second.data;
+    const uint64_t key= b->first;
+    mach_write_to_4(block + MODIFIED_PAGE_IS_LAST_BLOCK,
+                    ++b == blocks.end());
+    mach_write_to_8(block + MODIFIED_PAGE_START_LSN, checkpoint_lsn);
+    mach_write_to_8(block + MODIFIED_PAGE_END_LSN, end_lsn);
+    mach_write_to_4(block + MODIFIED_PAGE_SPACE_ID, uint32_t(key >> 32));
+    mach_write_to_4(block + MODIFIED_PAGE_1ST_PAGE_ID, uint32_t(key));
+    mach_write_to_4(block + MODIFIED_PAGE_BLOCK_CHECKSUM,
+                    log_online_calc_checksum(block));
+    if (os_file_write(IORequestWrite, log_online.name, log_online.file,
+                      block, log_online.offset, MODIFIED_PAGE_BLOCK_SIZE)
+        != DB_SUCCESS)
+    {
+      success= false;
+      break;
+    }
+    log_online.offset+= MODIFIED_PAGE_BLOCK_SIZE;
+  }
+
+  if (success)
+    success= os_file_flush(log_online.file);
+
+  if (!success)
+  {
+    /* The pages of this run are lost. Continue in a new file that
+    starts from end_lsn, so that mariabackup will notice the gap and
+    fall back to a full scan for any range that includes this run. */
+    sql_print_error("InnoDB: Failed to write changed page bitmap file %s",
+                    log_online.name);
+    log_online_close_file();
+    log_online.end_lsn= end_lsn;
+    goto func_exit;
+  }
+
+  log_online.end_lsn= end_lsn;
+  log_online.checkpoint_lsn= checkpoint_lsn;
+
+func_exit:
+  mysql_mutex_unlock(&log_online.write_mutex);
+  return success;
+}
+
+/** Write the final run at shutdown and stop the tracking. */
+void log_online_close()
+{
+  if (!log_online.initialized)
+    return;
+
+  log_online_write_run(true);
+
+  mysql_mutex_lock(&log_online.write_mutex);
+  log_online_close_file();
+  log_online.started= false;
+  mysql_mutex_unlock(&log_online.write_mutex);
+
+  for (log_online_shard_t &shard : log_online_shards)
+  {
+    shard.pages.clear();
+    shard.pages.shrink_to_fit();
+    shard.mutex.destroy();
+  }
+  mysql_mutex_destroy(&log_online.write_mutex);
+  log_online.initialized= false;
+}
@@ -1358,6 +1358,9 @@ void recv_sys_t::create()
 	file_checkpoint = 0;
 
 	progress_time = time(NULL);
+	apply_start_time = 0;
+	pages_applied = 0;
+	n_init_tasks = 0;
 	recv_max_page_lsn = 0;
 
 	memset(truncated_undo_spaces, 0, sizeof truncated_undo_spaces);
@@ -1372,6 +1375,8 @@ inline void recv_sys_t::clear()
   apply_log_recs= false;
   apply_batch_on= false;
   ut_ad(!after_apply || found_corrupt_fs || !UT_LIST_GET_LAST(blocks));
+  ut_ad(!n_init_tasks);
+  init_queue.clear();
   pages.clear();
 
   for (buf_block_t *block= UT_LIST_GET_LAST(blocks); block; )
@@ -3047,10 +3052,16 @@ static void recv_recover_page(buf_block_t* block, mtr_t& mtr,
 	ut_ad(p->second.is_being_processed());
 	ut_ad(!recv_sys.pages.empty());
 
+	recv_sys.pages_applied++;
+
 	if (recv_sys.report(now)) {
 		const size_t n = recv_sys.pages.size();
-		sql_print_information("InnoDB: To recover: %zu pages from log",
-				      n);
+		const ulonglong elapsed = my_interval_timer()
+			- recv_sys.apply_start_time;
+		sql_print_information("InnoDB: To recover: %zu pages from log"
+				      " (applying %llu pages/s)", n,
+				      recv_sys.pages_applied * 1000000000ULL
+				      / std::max(elapsed, 1ULL));
 		service_manager_extend_timeout(INNODB_EXTEND_TIMEOUT_INTERVAL,
 					       "To recover: %zu pages"
 					       " from log", n);
@@ -3181,7 +3192,8 @@ inline buf_block_t *recv_sys_t::recover_low(const page_id_t page_id,
   mysql_mutex_assert_owner(&mutex);
   ut_ad(p->first == page_id);
   page_recv_t &recs= p->second;
-  ut_ad(recs.state == page_recv_t::RECV_WILL_NOT_READ);
+  ut_ad(recs.state == page_recv_t::RECV_WILL_NOT_READ ||
+        recs.state == page_recv_t::RECV_BEING_INITIALIZED);
   buf_block_t* block= nullptr;
   mlog_init_t::init &i= mlog_init.last(page_id);
   const lsn_t end_lsn= recs.log.last()->lsn;
@@ -3254,8 +3266,11 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   mysql_mutex_lock(&mutex);
   map::iterator p= pages.find(page_id);
 
-  if (p != pages.end() && p->second.state == page_recv_t::RECV_WILL_NOT_READ)
+  if (p != pages.end() &&
+      (p->second.state == page_recv_t::RECV_WILL_NOT_READ ||
+       p->second.state == page_recv_t::RECV_BEING_INITIALIZED))
   {
+    /* If the page was queued for init_pages(), it will skip it. */
     mtr_t mtr;
     block= recover_low(page_id, p, mtr, free_block);
     ut_ad(!block || block == free_block);
@@ -3267,6 +3282,70 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   return block;
 }
 
+/** Queue a RECV_WILL_NOT_READ page for init_pages().
+@param p  iterator pointing to the page */
+inline void recv_sys_t::queue_init(map::iterator p)
+{
+  mysql_mutex_assert_owner(&mutex);
+  ut_ad(p->second.state == page_recv_t::RECV_WILL_NOT_READ);
+  p->second.state= page_recv_t::RECV_BEING_INITIALIZED;
+  init_queue.emplace_back(p->first);
+  if (n_init_tasks < srv_n_read_io_threads &&
+      n_init_tasks < init_queue.size())
+  {
+    static tpool::task init_task{[](void*) { recv_sys.init_pages(); },
+                                 nullptr};
+    n_init_tasks++;
+    srv_thread_pool->submit_task(&init_task);
+  }
+}
+
+/** Initialize the pages in init_queue. Executed concurrently in
+up to srv_n_read_io_threads tasks of srv_thread_pool. */
+void recv_sys_t::init_pages()
+{
+  buf_block_t *free_block= nullptr;
+  mysql_mutex_lock(&mutex);
+  ut_ad(n_init_tasks);
+
+  while (!init_queue.empty() && !is_corrupt_fs() && !is_corrupt_log())
+  {
+    if (!free_block)
+    {
+      mysql_mutex_unlock(&mutex);
+      free_block= buf_LRU_get_free_block(false);
+      mysql_mutex_lock(&mutex);
+      continue;
+    }
+
+    const page_id_t page_id= init_queue.back();
+    init_queue.pop_back();
+    map::iterator p= pages.find(page_id);
+    /* The page may have been initialized by recover() or read
+    by another thread in the meantime. */
+    if (p == pages.end() ||
+        p->second.state != page_recv_t::RECV_BEING_INITIALIZED)
+      continue;
+
+    mtr_t mtr;
+    if (recover_low(page_id, p, mtr, free_block))
+      free_block= nullptr;
+    else if ((p= pages.find(page_id)) != pages.end())
+    {
+      /* The tablespace was dropped; discard the log. */
+      p->second.log.clear();
+      pages.erase(p);
+    }
+  }
+
+  if (!--n_init_tasks)
+    pthread_cond_broadcast(&cond);
+  mysql_mutex_unlock(&mutex);
+
+  if (free_block)
+    buf_pool.free_block(free_block);
+}
+
 inline fil_space_t *fil_system_t::find(const char *path) const
 {
   mysql_mutex_assert_owner(&mutex);
@@ -3351,6 +3430,8 @@ void recv_sys_t::apply(bool last_batch)
 
     apply_log_recs= true;
     apply_batch_on= true;
+    apply_start_time= my_interval_timer();
+    pages_applied= 0;
 
     for (auto id= srv_undo_tablespaces_open; id--;)
     {
@@ -3400,10 +3481,21 @@ void recv_sys_t::apply(bool last_batch)
 
       switch (p->second.state) {
       case page_recv_t::RECV_BEING_READ:
+      case page_recv_t::RECV_BEING_INITIALIZED:
       case page_recv_t::RECV_BEING_PROCESSED:
         p++;
         continue;
       case page_recv_t::RECV_WILL_NOT_READ:
+        /* Initialize the pages in multiple threads, like
+        buf_page_t::read_complete() applies the log to the pages
+        that are being read. The first page of a tablespace
+        may be needed for creating a deferred tablespace. */
+        if (srv_recovery_parallel_init && srv_n_read_io_threads > 1 &&
+            page_id.page_no())
+        {
+          queue_init(p++);
+          continue;
+        }
         if (UNIV_LIKELY(!!recover_low(page_id, p, mtr, free_block)))
         {
 next_free_block:
@@ -3429,14 +3521,14 @@ void recv_sys_t::apply(bool last_batch)
     for (;;)
     {
       const bool empty= pages.empty();
-      if (empty && !buf_pool.n_pend_reads)
+      if (empty && !buf_pool.n_pend_reads && !n_init_tasks)
         break;
 
       if (!is_corrupt_fs() && !is_corrupt_log())
       {
         if (last_batch)
         {
-          if (!empty)
+          if (!empty || n_init_tasks)
             my_cond_wait(&cond, &mutex.m_mutex);
           else
           {
@@ -3461,11 +3553,21 @@ void recv_sys_t::apply(bool last_batch)
         }
         continue;
       }
+      /* init_pages() will stop after noticing the corruption. */
+      while (n_init_tasks)
+        my_cond_wait(&cond, &mutex.m_mutex);
       if (is_corrupt_fs() && !srv_force_recovery)
         sql_print_information("InnoDB: Set innodb_force_recovery=1"
                               " to ignore corrupted pages.");
       return;
     }
+
+    const ulonglong elapsed= my_interval_timer() - apply_start_time;
+    sql_print_information("InnoDB: Applied log to %zu pages in %.3f"
+                          " seconds (%llu pages/s)", pages_applied,
+                          double(elapsed) / 1e9,
+                          pages_applied * 1000000000ULL /
+                          std::max(elapsed, 1ULL));
   }
 
   if (last_batch)
@@ -41,6 +41,7 @@ Created 2012-02-08 by Sunny Bains.
 #include "fil0pagecompress.h"
 #include "trx0undo.h"
 #include "lock0lock.h"
+#include "log0online.h"
 #include "lzo/lzo1x.h"
 #include "snappy-c.h"
 
@@ -57,7 +58,12 @@ using st_::span;
 /** The size of the buffer to use for IO.
 @param n physical page size
 @return number of pages */
-#define IO_BUFFER_SIZE(n)	((1024 * 1024) / (n))
+#define IO_BUFFER_SIZE(n)	((4 * 1024 * 1024) / (n))
+
+/** The maximum total size of the IO buffers of the threads of a
+parallel PageConverter::run(), in bytes. With the maximum
+innodb_import_threads=32, every thread gets 1MiB. */
+#define IMPORT_IO_BUFFER_TOTAL	(32 * 1024 * 1024)
 
 /** For gathering stats on records during phase I */
 struct row_stats_t {
@@ -238,6 +244,8 @@ struct fil_iterator_t {
 	byte*		io_buffer;		/*!< Buffer to use for IO */
 	fil_space_crypt_t *crypt_data;		/*!< Crypt data (if encrypted) */
 	byte*           crypt_io_buffer;        /*!< IO buffer when encrypted */
+	uint32_t	actual_space_id;	/*!< FIL_PAGE_SPACE_ID of
+						the first page */
 };
 
 /** Use the page cursor to iterate over records in a block. */
@@ -412,7 +420,8 @@ class AbstractCallback
 		m_space(space_id),
 		m_xdes(),
 		m_xdes_page_no(UINT32_MAX),
-		m_space_flags(UINT32_MAX) UNIV_NOTHROW { }
+		m_space_flags(UINT32_MAX),
+		m_abort(NULL) UNIV_NOTHROW { }
 
 	/** Free any extent descriptor instance */
 	virtual ~AbstractCallback()
@@ -468,7 +477,11 @@ class AbstractCallback
 	/** @return the tablespace identifier */
 	uint32_t get_space_id() const { return m_space; }
 
-	bool is_interrupted() const { return trx_is_interrupted(m_trx); }
+	bool is_interrupted() const
+	{
+		return (m_abort && m_abort->load(std::memory_order_relaxed))
+			|| trx_is_interrupted(m_trx);
+	}
 
 	/**
 	Get the data page depending on the table type, compressed or not.
@@ -584,6 +597,9 @@ class AbstractCallback
 
 	/** Flags value read from the header page */
 	uint32_t		m_space_flags;
+
+	/** Set when another thread of the iteration failed, or NULL */
+	const std::atomic<bool>*m_abort;
 };
 
 /** Determine the page size to use for traversing the tablespace
@@ -638,13 +654,6 @@ AbstractCallback::init(
 }
 
 /**
-TODO: This can be made parallel trivially by chunking up the file
-and creating a callback per thread.. Main benefit will be to use
-multiple CPUs for checksums and compressed tables. We have to do
-compressed tables block by block right now. Secondly we need to
-decompress/compress and copy too much of data. These are
-CPU intensive.
-
 Iterate over all the pages in the tablespace.
 @param iter - Tablespace iterator
 @param block - block to use for IO
@@ -847,9 +856,35 @@ class PageConverter : public AbstractCallback {
 		m_rec_iter(),
 		m_offsets_(), m_offsets(m_offsets_),
 		m_heap(0),
-		m_cluster_index(dict_table_get_first_index(cfg->m_table))
+		m_cluster_index(dict_table_get_first_index(cfg->m_table)),
+		m_stats(NULL)
+	{
+		rec_offs_init(m_offsets_);
+	}
+
+	/** Constructor for a thread of a parallel run()
+	@param base   the converter that was initialized for the file
+	@param abort  flag that is set when another thread failed */
+	PageConverter(const PageConverter& base,
+		      const std::atomic<bool>* abort)
+		:
+		AbstractCallback(base.m_trx, base.m_space),
+		m_cfg(base.m_cfg),
+		m_index(base.m_cfg->m_indexes),
+		m_rec_iter(),
+		m_offsets_(), m_offsets(m_offsets_),
+		m_heap(0),
+		m_cluster_index(base.m_cluster_index),
+		m_stats(UT_NEW_ARRAY_NOKEY(row_stats_t,
+					   base.m_cfg->m_n_indexes))
 	{
 		rec_offs_init(m_offsets_);
+		m_zip_size = base.m_zip_size;
+		m_file = base.m_file;
+		m_filepath = base.m_filepath;
+		m_space_flags = base.m_space_flags;
+		m_abort = abort;
+		memset(m_stats, 0, m_cfg->m_n_indexes * sizeof *m_stats);
 	}
 
 	~PageConverter() UNIV_NOTHROW override
@@ -857,13 +892,17 @@ class PageConverter : public AbstractCallback {
 		if (m_heap != 0) {
 			mem_heap_free(m_heap);
 		}
+
+		UT_DELETE_ARRAY(m_stats);
 	}
 
+	/** Convert the pages, in multiple threads if the file
+	spans several extent descriptor pages.
+	@param iter   tablespace iterator
+	@param block  block to use for IO
+	@return DB_SUCCESS or error code */
 	dberr_t run(const fil_iterator_t& iter,
-		    buf_block_t* block) UNIV_NOTHROW override
-	{
-		return fil_iterate(iter, block, *this);
-	}
+		    buf_block_t* block) UNIV_NOTHROW override;
 
 	/** Called for each block as it is read from the file.
 	@param block block to convert, it is not from the buffer pool.
@@ -935,6 +974,27 @@ class PageConverter : public AbstractCallback {
 		rec_t*			rec,
 		const rec_offs*		offsets) UNIV_NOTHROW;
 
+	/** @return the statistics of the current index */
+	row_stats_t& stats() UNIV_NOTHROW
+	{
+		return m_stats
+			? m_stats[m_index - m_cfg->m_indexes]
+			: m_index->m_stats;
+	}
+
+	/** Convert the pages of the chunks of a parallel run().
+	@param iter   tablespace iterator, with own buffers
+	@param block  block to use for IO
+	@param next   start of the next chunk to convert
+	@param chunk  size of a chunk, in bytes
+	@param end    end of the file
+	@return DB_SUCCESS or error code */
+	dberr_t run_chunks(fil_iterator_t& iter, buf_block_t* block,
+			   std::atomic<os_offset_t>& next,
+			   os_offset_t chunk, os_offset_t end) UNIV_NOTHROW;
+
+	friend struct PageConverterThread;
+
 	/** Find an index with the matching id.
 	@return row_index_t* instance or 0 */
 	row_index_t* find_index(index_id_t id) UNIV_NOTHROW
@@ -971,6 +1031,10 @@ class PageConverter : public AbstractCallback {
 
 	/** Cluster index instance */
 	dict_index_t*		m_cluster_index;
+
+	/** Statistics of a thread of a parallel run(), for each index
+	of m_cfg, to be added to row_index_t::m_stats; or NULL */
+	row_stats_t*		m_stats;
 };
 
 /**
@@ -1782,11 +1846,11 @@ inline bool PageConverter::purge() UNIV_NOTHROW
 	/* We can't have a page that is empty and not root. */
 	if (m_rec_iter.remove(index, m_offsets)) {
 
-		++m_index->m_stats.m_n_purged;
+		++stats().m_n_purged;
 
 		return(true);
 	} else {
-		++m_index->m_stats.m_n_purge_failed;
+		++stats().m_n_purge_failed;
 	}
 
 	return(false);
@@ -1882,9 +1946,9 @@ PageConverter::update_records(
 				m_rec_iter.next();
 			}
 
-			++m_index->m_stats.m_n_deleted;
+			++stats().m_n_deleted;
 		} else {
-			++m_index->m_stats.m_n_rows;
+			++stats().m_n_rows;
 			m_rec_iter.next();
 		}
 	}
@@ -2047,6 +2111,12 @@ PageConverter::update_page(buf_block_t* block, uint16_t& page_type)
 	switch (page_type = fil_page_get_type(get_frame(block))) {
 	case FIL_PAGE_TYPE_FSP_HDR:
 		ut_a(block->page.id().page_no() == 0);
+		/* The first extent descriptor page is needed when
+		this is not the thread that invoked init(). */
+		err = set_current_xdes(0, get_frame(block));
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
 		/* Work directly on the uncompressed page headers. */
 		return(update_header(block));
 
@@ -3822,7 +3892,7 @@ static dberr_t fil_iterate(
 		return DB_OUT_OF_MEMORY;
 	}
 
-	uint32_t actual_space_id = 0;
+	uint32_t actual_space_id = iter.actual_space_id;
 	const bool full_crc32 = fil_space_t::full_crc32(
 		callback.get_space_flags());
 
@@ -4123,6 +4193,198 @@ static dberr_t fil_iterate(
 	return err;
 }
 
+/** Convert the pages of the chunks of a parallel run().
+@param iter   tablespace iterator, with own buffers
+@param block  block to use for IO
+@param next   start of the next chunk to convert
+@param chunk  size of a chunk, in bytes
+@param end    end of the file
+@return DB_SUCCESS or error code */
+dberr_t PageConverter::run_chunks(fil_iterator_t& iter, buf_block_t* block,
+				  std::atomic<os_offset_t>& next,
+				  os_offset_t chunk, os_offset_t end)
+	UNIV_NOTHROW
+{
+	while (!is_interrupted()) {
+		iter.start = next.fetch_add(chunk);
+		if (iter.start >= end) {
+			return DB_SUCCESS;
+		}
+		iter.end = std::min(iter.start + chunk, end);
+
+		/* The first page of each chunk is an extent
+		descriptor page, which will be passed to
+		set_current_xdes(). */
+		if (dberr_t err = fil_iterate(iter, block, *this)) {
+			return err;
+		}
+	}
+
+	return DB_INTERRUPTED;
+}
+
+/** A thread of a parallel PageConverter::run() */
+struct PageConverterThread
+{
+	/** the converter of this thread */
+	PageConverter		converter;
+	/** the iterator of this thread */
+	fil_iterator_t		iter;
+	/** the block of this thread */
+	buf_block_t*		block;
+	/** start of the next chunk to convert */
+	std::atomic<os_offset_t>& next;
+	/** size of a chunk, in bytes */
+	const os_offset_t	chunk;
+	/** set when a thread failed */
+	std::atomic<bool>&	abort;
+	/** the result of the thread */
+	dberr_t			err;
+	/** the task of the thread */
+	tpool::waitable_task	task;
+
+	PageConverterThread(const PageConverter& base,
+			    const fil_iterator_t& base_iter,
+			    std::atomic<os_offset_t>& next,
+			    os_offset_t chunk,
+			    std::atomic<bool>& abort)
+		:
+		converter(base, &abort), iter(base_iter), block(NULL),
+		next(next), chunk(chunk), abort(abort), err(DB_SUCCESS),
+		task(execute, this)
+	{
+		iter.io_buffer = NULL;
+		iter.crypt_io_buffer = NULL;
+	}
+
+	/** Convert chunks of the file
+	@param arg  PageConverterThread */
+	static void execute(void* arg)
+	{
+		PageConverterThread* t = static_cast<PageConverterThread*>(arg);
+		t->err = t->run();
+		if (t->err != DB_SUCCESS) {
+			t->abort.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	/** Allocate the buffers like fil_tablespace_iterate() and
+	convert chunks of the file.
+	@return DB_SUCCESS or error code */
+	dberr_t run()
+	{
+		const ulint buf_size = (1 + iter.n_io_buffers)
+			<< srv_page_size_shift;
+		iter.io_buffer = static_cast<byte*>(
+			aligned_malloc(buf_size, srv_page_size));
+		if (iter.crypt_data) {
+			iter.crypt_io_buffer = static_cast<byte*>(
+				aligned_malloc(buf_size, srv_page_size));
+		}
+
+		block = reinterpret_cast<buf_block_t*>(
+			ut_zalloc_nokey(sizeof *block));
+		block->page.init(buf_page_t::UNFIXED + 1,
+				 page_id_t(converter.get_space_id(), 0));
+		block->page.frame = iter.io_buffer;
+		if (ulint zip_size = converter.get_zip_size()) {
+			page_zip_set_size(&block->page.zip, zip_size);
+			block->page.zip.data = block->page.frame
+				+ srv_page_size;
+		}
+
+		return converter.run_chunks(iter, block, next, chunk,
+					    iter.file_size);
+	}
+
+	~PageConverterThread()
+	{
+		ut_free(block);
+		aligned_free(iter.crypt_io_buffer);
+		aligned_free(iter.io_buffer);
+	}
+};
+
+/** Convert the pages, in multiple threads if the file
+spans several extent descriptor pages.
+@param iter   tablespace iterator
+@param block  block to use for IO
+@return DB_SUCCESS or error code */
+dberr_t PageConverter::run(const fil_iterator_t& iter, buf_block_t* block)
+	UNIV_NOTHROW
+{
+	/* Each extent descriptor page describes the following
+	physical_size() pages. Each thread converts such chunks,
+	so that PageConverter::is_free() will work. */
+	const os_offset_t chunk = os_offset_t{physical_size()}
+		* physical_size();
+	const os_offset_t n_chunks = (iter.end - iter.start + chunk - 1)
+		/ chunk;
+	const ulint n_threads = ulint(std::min<os_offset_t>(
+		srv_import_threads, n_chunks));
+
+	if (n_threads <= 1) {
+		return fil_iterate(iter, block, *this);
+	}
+
+	ut_ad(!iter.start);
+	ut_ad(iter.end == iter.file_size);
+
+	/* Every thread reads and writes an equal share of
+	IMPORT_IO_BUFFER_TOTAL at a time, but not more than a
+	serial run. The share of an encrypted file or a
+	ROW_FORMAT=COMPRESSED file is reduced like iter.n_io_buffers. */
+	fil_iterator_t	thread_iter = iter;
+	thread_iter.n_io_buffers = std::max<ulint>(
+		1, std::min<ulint>(iter.n_io_buffers,
+				   iter.n_io_buffers
+				   * (IMPORT_IO_BUFFER_TOTAL
+				      / IO_BUFFER_SIZE(1)) / n_threads));
+
+	ib::info() << "Converting " << n_chunks << " chunks of "
+		   << filename() << " in " << n_threads << " threads";
+
+	std::atomic<os_offset_t>	next{iter.start};
+	std::atomic<bool>		abort{false};
+	std::vector<std::unique_ptr<PageConverterThread>> threads;
+
+	for (ulint i = 1; i < n_threads; i++) {
+		threads.emplace_back(new PageConverterThread(
+					     *this, thread_iter, next, chunk,
+					     abort));
+		srv_thread_pool->submit_task(&threads.back()->task);
+	}
+
+	m_abort = &abort;
+	dberr_t	err = run_chunks(thread_iter, block, next, chunk, iter.end);
+	if (err != DB_SUCCESS) {
+		abort.store(true, std::memory_order_relaxed);
+	}
+
+	for (auto& t : threads) {
+		t->task.wait();
+
+		/* Report the error that caused the other threads
+		to stop. */
+		if (t->err != DB_SUCCESS
+		    && (err == DB_SUCCESS || err == DB_INTERRUPTED)) {
+			err = t->err;
+		}
+
+		for (ulint i = 0; i < m_cfg->m_n_indexes; i++) {
+			row_stats_t&		s = m_cfg->m_indexes[i].m_stats;
+			const row_stats_t&	ts = t->converter.m_stats[i];
+			s.m_n_deleted += ts.m_n_deleted;
+			s.m_n_purged += ts.m_n_purged;
+			s.m_n_rows += ts.m_n_rows;
+			s.m_n_purge_failed += ts.m_n_purge_failed;
+		}
+	}
+
+	m_abort = NULL;
+	return err;
+}
+
 /********************************************************************//**
 Iterate over all the pages in the tablespace.
 @param table - the table definiton in the server
@@ -4235,6 +4497,8 @@ fil_tablespace_iterate(
 		iter.filepath = filepath;
 		iter.file_size = file_size;
 		iter.n_io_buffers = n_io_buffers;
+		iter.actual_space_id = mach_read_from_4(
+			page + FIL_PAGE_SPACE_ID);
 
 		/* Add an extra page for compressed page scratch area. */
 		iter.io_buffer = static_cast<byte*>(
@@ -4273,6 +4537,10 @@ fil_tablespace_iterate(
 			err = DB_IO_ERROR;
 		} else {
 			ib::info() << "Sync to disk - done!";
+			/* The pages were written bypassing the buffer pool. */
+			log_online_track_pages(
+				table->space_id, 0,
+				uint32_t(file_size / callback.physical_size()));
 		}
 	}
 
@@ -41,6 +41,7 @@ Created 2011-05-26 Marko Makela
 #include <sql_class.h>
 #include <algorithm>
 #include <map>
+#include <vector>
 
 Atomic_counter<ulint> onlineddl_rowlog_rows;
 ulint onlineddl_rowlog_pct_used;
@@ -3122,7 +3123,8 @@ row_log_apply_op_low(
 					BTR_MODIFY_TREE, &cursor, 0, &mtr);
 
 				/* No other thread than the current one
-				is allowed to modify the index tree.
+				is allowed to modify records with this
+				key (see row_log_apply_batch()).
 				Thus, the record should still exist. */
 				ut_ad(cursor.low_match
 				      >= dict_index_get_n_fields(index));
@@ -3227,7 +3229,7 @@ row_log_apply_op_low(
 			/* We already determined that the
 			record did not exist. No other thread
 			than the current one is allowed to
-			modify the index tree. Thus, the
+			modify records with this key. Thus, the
 			record should still not exist. */
 
 			*error = btr_cur_pessimistic_insert(
@@ -3255,44 +3257,27 @@ row_log_apply_op_low(
 }
 
 /******************************************************//**
-Applies an operation to a secondary index that was being created.
+Parses an operation on a secondary index that was being created.
 @return NULL on failure (mrec corruption) or when out of data;
 pointer to next record on success */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 const mrec_t*
-row_log_apply_op(
+row_log_parse_op(
 /*=============*/
-	dict_index_t*	index,		/*!< in/out: index */
-	row_merge_dup_t*dup,		/*!< in/out: for reporting
-					duplicate key errors */
+	dict_index_t*	index,		/*!< in: index */
 	dberr_t*	error,		/*!< out: DB_SUCCESS or error code */
-	mem_heap_t*	offsets_heap,	/*!< in/out: memory heap for
-					allocating offsets; can be emptied */
 	mem_heap_t*	heap,		/*!< in/out: memory heap for
 					allocating data tuples */
-	bool		has_index_lock, /*!< in: true if holding index->lock
-					in exclusive mode */
 	const mrec_t*	mrec,		/*!< in: merge record */
 	const mrec_t*	mrec_end,	/*!< in: end of buffer */
-	rec_offs*	offsets)	/*!< in/out: work area for
+	rec_offs*	offsets,	/*!< in/out: work area for
 					rec_init_offsets_temp() */
-
+	row_op*		op,		/*!< out: operation */
+	trx_id_t*	trx_id,		/*!< out: transaction identifier */
+	dtuple_t**	entry)		/*!< out: index entry */
 {
-	enum row_op	op;
 	ulint		extra_size;
 	ulint		data_size;
-	dtuple_t*	entry;
-	trx_id_t	trx_id;
-
-	/* Online index creation is only used for secondary indexes. */
-	ut_ad(!dict_index_is_clust(index));
-
-	ut_ad(index->lock.have_x() == has_index_lock);
-
-	if (index->is_corrupted()) {
-		*error = DB_INDEX_CORRUPT;
-		return(NULL);
-	}
 
 	*error = DB_SUCCESS;
 
@@ -3306,13 +3291,13 @@ row_log_apply_op(
 			return(NULL);
 		}
 
-		op = static_cast<enum row_op>(*mrec++);
-		trx_id = trx_read_trx_id(mrec);
+		*op = static_cast<enum row_op>(*mrec++);
+		*trx_id = trx_read_trx_id(mrec);
 		mrec += DATA_TRX_ID_LEN;
 		break;
 	case ROW_OP_DELETE:
-		op = static_cast<enum row_op>(*mrec++);
-		trx_id = 0;
+		*op = static_cast<enum row_op>(*mrec++);
+		*trx_id = 0;
 		break;
 	default:
 corrupted:
@@ -3356,17 +3341,272 @@ row_log_apply_op(
 		return(NULL);
 	}
 
-	entry = row_rec_to_index_entry_low(
+	*entry = row_rec_to_index_entry_low(
 		mrec - data_size, index, offsets, heap);
 	/* Online index creation is only implemented for secondary
 	indexes, which never contain off-page columns. */
-	ut_ad(dtuple_get_n_ext(entry) == 0);
+	ut_ad(dtuple_get_n_ext(*entry) == 0);
+	return(mrec);
+}
 
-	row_log_apply_op_low(index, dup, error, offsets_heap,
-			     has_index_lock, op, trx_id, entry);
+/******************************************************//**
+Applies an operation to a secondary index that was being created.
+@return NULL on failure (mrec corruption) or when out of data;
+pointer to next record on success */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+const mrec_t*
+row_log_apply_op(
+/*=============*/
+	dict_index_t*	index,		/*!< in/out: index */
+	row_merge_dup_t*dup,		/*!< in/out: for reporting
+					duplicate key errors */
+	dberr_t*	error,		/*!< out: DB_SUCCESS or error code */
+	mem_heap_t*	offsets_heap,	/*!< in/out: memory heap for
+					allocating offsets; can be emptied */
+	mem_heap_t*	heap,		/*!< in/out: memory heap for
+					allocating data tuples */
+	bool		has_index_lock, /*!< in: true if holding index->lock
+					in exclusive mode */
+	const mrec_t*	mrec,		/*!< in: merge record */
+	const mrec_t*	mrec_end,	/*!< in: end of buffer */
+	rec_offs*	offsets)	/*!< in/out: work area for
+					rec_init_offsets_temp() */
+
+{
+	row_op		op;
+	trx_id_t	trx_id;
+	dtuple_t*	entry;
+
+	/* Online index creation is only used for secondary indexes. */
+	ut_ad(!dict_index_is_clust(index));
+
+	ut_ad(index->lock.have_x() == has_index_lock);
+
+	if (index->is_corrupted()) {
+		*error = DB_INDEX_CORRUPT;
+		return(NULL);
+	}
+
+	mrec = row_log_parse_op(index, error, heap, mrec, mrec_end, offsets,
+				&op, &trx_id, &entry);
+	if (mrec) {
+		row_log_apply_op_low(index, dup, error, offsets_heap,
+				     has_index_lock, op, trx_id, entry);
+	}
 	return(mrec);
 }
 
+/** A parsed operation on a secondary index that is being created */
+struct row_log_op_t
+{
+	/** the index entry */
+	const dtuple_t*	entry;
+	/** transaction identifier, or 0 for ROW_OP_DELETE */
+	trx_id_t	trx_id;
+	/** position in the log */
+	ulint		seq;
+	/** the operation */
+	row_op		op;
+};
+
+/** A range of a row_log_batch_t that is applied by one thread */
+struct row_log_range_t
+{
+	/** the batch */
+	struct row_log_batch_t*	batch;
+	/** first operation */
+	const row_log_op_t*	first;
+	/** end of the operations */
+	const row_log_op_t*	last;
+	/** the operation that failed, or NULL */
+	const row_log_op_t*	failed;
+	/** the error of failed */
+	dberr_t			error;
+};
+
+static void row_log_apply_range(void *arg);
+
+/** Operations parsed from a block of row_log_t, to be sorted by key
+and applied in multiple threads */
+struct row_log_batch_t
+{
+	/** transaction (for checking if the operation was interrupted) */
+	const trx_t*			trx;
+	/** the index that is being created */
+	dict_index_t*			index;
+	/** the operations in log order */
+	std::vector<row_log_op_t>	ops;
+	/** set when the apply should be stopped */
+	std::atomic<bool>		abort;
+	/** ranges of ops; ranges[0] is applied by the ALTER thread
+	and ranges[i] by tasks[i - 1] */
+	std::vector<row_log_range_t>	ranges;
+	/** the worker tasks, which are submitted again for every block */
+	std::vector<std::unique_ptr<tpool::waitable_task>> tasks;
+
+	/** Create the workers.
+	@param trx        transaction
+	@param index      the index that is being created
+	@param n_threads  number of threads, including the ALTER thread */
+	row_log_batch_t(const trx_t *trx, dict_index_t *index,
+			ulint n_threads) :
+		trx(trx), index(index), abort(false), ranges(n_threads)
+	{
+		for (ulint i = 1; i < n_threads; i++) {
+			ranges[i].batch = this;
+			tasks.emplace_back(new tpool::waitable_task(
+						   row_log_apply_range,
+						   &ranges[i]));
+		}
+		ranges[0].batch = this;
+	}
+};
+
+/** Compare the unique fields of two parsed operations.
+@param index  secondary index
+@param a      index entry
+@param b      index entry
+@return negative, 0, positive if a is less, equal, greater than b */
+static int row_log_op_cmp(const dict_index_t *index,
+			  const dtuple_t *a, const dtuple_t *b)
+{
+	const ulint n_uniq = dict_index_get_n_unique(index);
+	for (ulint i = 0; i < n_uniq; i++) {
+		if (int cmp = cmp_dfield_dfield(
+			    dtuple_get_nth_field(a, i),
+			    dtuple_get_nth_field(b, i),
+			    index->fields[i].descending)) {
+			return cmp;
+		}
+	}
+	return 0;
+}
+
+/** Apply a range of a batch of operations.
+@param arg  row_log_range_t */
+static void row_log_apply_range(void *arg)
+{
+	row_log_range_t* r = static_cast<row_log_range_t*>(arg);
+	row_log_batch_t* b = r->batch;
+	/* Only the first duplicate will be reported,
+	by row_log_apply_batch(). */
+	row_merge_dup_t	dup = { b->index, NULL, NULL, 0 };
+	mem_heap_t*	offsets_heap = mem_heap_create(srv_page_size);
+
+	for (const row_log_op_t* o = r->first; o != r->last; o++) {
+		if (b->abort.load(std::memory_order_relaxed)) {
+			break;
+		}
+
+		if (trx_is_interrupted(b->trx)) {
+			b->abort.store(true, std::memory_order_relaxed);
+			break;
+		}
+
+		if (b->index->is_corrupted()) {
+			r->error = DB_INDEX_CORRUPT;
+			r->failed = o;
+			b->abort.store(true, std::memory_order_relaxed);
+			break;
+		}
+
+		log_free_check();
+
+		r->error = DB_SUCCESS;
+		row_log_apply_op_low(b->index, &dup, &r->error, offsets_heap,
+				     false, o->op, o->trx_id, o->entry);
+		if (r->error != DB_SUCCESS) {
+			r->failed = o;
+			b->abort.store(true, std::memory_order_relaxed);
+			break;
+		}
+	}
+
+	mem_heap_free(offsets_heap);
+}
+
+/** Apply a batch of operations to a secondary index that is being created.
+The operations are sorted by the unique fields of the index, which improves
+the locality of the B-tree accesses, and the sorted array is split into
+ranges of distinct keys that are applied by the tasks of the batch
+in srv_thread_pool. The operations on any given key remain in the log order.
+@param b    batch of operations
+@param dup  for reporting duplicate key errors
+@return DB_SUCCESS, or error code on failure */
+static dberr_t row_log_apply_batch(row_log_batch_t &b, row_merge_dup_t *dup)
+{
+	ut_ad(!b.index->lock.have_any());
+
+	if (b.ops.empty()) {
+		return DB_SUCCESS;
+	}
+
+	DEBUG_SYNC_C("row_log_apply_batch");
+
+	const dict_index_t* index = b.index;
+	std::stable_sort(b.ops.begin(), b.ops.end(),
+			 [index](const row_log_op_t &x, const row_log_op_t &y)
+			 {
+				 return row_log_op_cmp(index, x.entry,
+						       y.entry) < 0;
+			 });
+
+	const row_log_op_t* const ops = b.ops.data();
+	const ulint n_ops = b.ops.size();
+	/* Let each thread apply at least 64 operations. */
+	const ulint n_ranges = std::max<ulint>(
+		1, std::min<ulint>(b.ranges.size(), n_ops / 64));
+	row_log_range_t* const ranges = b.ranges.data();
+
+	b.abort.store(false, std::memory_order_relaxed);
+
+	ulint start = 0;
+	for (ulint i = 0; i < n_ranges; i++) {
+		ulint end = i + 1 == n_ranges ? n_ops : std::max(
+			start, (i + 1) * n_ops / n_ranges);
+		/* Keep all operations on a key in the same range. */
+		while (end > start && end < n_ops
+		       && !row_log_op_cmp(index, ops[end - 1].entry,
+					  ops[end].entry)) {
+			end++;
+		}
+
+		ranges[i] = { &b, ops + start, ops + end, NULL, DB_SUCCESS };
+		start = end;
+	}
+
+	for (ulint i = 1; i < n_ranges; i++) {
+		if (ranges[i].first != ranges[i].last) {
+			srv_thread_pool->submit_task(b.tasks[i - 1].get());
+		}
+	}
+
+	row_log_apply_range(&ranges[0]);
+
+	for (ulint i = 1; i < n_ranges; i++) {
+		b.tasks[i - 1]->wait();
+	}
+
+	/* Report the failure that is earliest in the log. */
+	const row_log_range_t* failed = NULL;
+	for (ulint i = 0; i < n_ranges; i++) {
+		const row_log_range_t& r = ranges[i];
+		if (r.failed && (!failed || r.failed->seq < failed->failed->seq)) {
+			failed = &r;
+		}
+	}
+
+	if (!failed) {
+		return DB_SUCCESS;
+	}
+
+	if (failed->error == DB_DUPLICATE_KEY) {
+		row_merge_dup_report(dup, failed->failed->entry->fields);
+	}
+
+	return failed->error;
+}
+
 /** Applies operations to a secondary index that was being created.
 @param[in]	trx	transaction (for checking if the operation was
 interrupted)
@@ -3394,6 +3634,7 @@ row_log_apply_ops(
 	mem_heap_t*	heap;
 	rec_offs*	offsets;
 	bool		has_index_lock;
+	row_log_batch_t*batch	= NULL;
 	const ulint	i	= 1 + REC_OFFS_HEADER_SIZE
 		+ dict_index_get_n_fields(index);
 
@@ -3414,6 +3655,14 @@ row_log_apply_ops(
 	heap = mem_heap_create(srv_page_size);
 	has_index_lock = true;
 
+	if (stage && srv_online_apply_threads > 1) {
+		/* Apply the blocks that were written to the file
+		in multiple threads. The last block will be applied
+		while holding index->lock, in this thread. */
+		batch = new row_log_batch_t(trx, index,
+					    srv_online_apply_threads);
+	}
+
 next_block:
 	ut_ad(has_index_lock);
 	ut_ad(index->lock.have_x());
@@ -3599,6 +3848,57 @@ row_log_apply_ops(
 
 	mrec_end = next_mrec_end;
 
+	if (batch && !has_index_lock) {
+		ut_ad(mrec_end == index->online_log->head.block
+		      + srv_sort_buf_size);
+		batch->ops.clear();
+
+		for (;;) {
+			row_log_op_t	o;
+			dtuple_t*	entry;
+
+			mrec = next_mrec;
+			ut_ad(mrec < mrec_end);
+
+			next_mrec = row_log_parse_op(
+				index, &error, heap, mrec, mrec_end, offsets,
+				&o.op, &o.trx_id, &entry);
+
+			if (error != DB_SUCCESS) {
+				goto func_exit;
+			} else if (next_mrec == NULL) {
+				break;
+			}
+
+			o.entry = entry;
+			o.seq = batch->ops.size();
+			batch->ops.push_back(o);
+
+			if (next_mrec == next_mrec_end) {
+				break;
+			}
+		}
+
+		error = row_log_apply_batch(*batch, dup);
+		mem_heap_empty(heap);
+
+		if (error != DB_SUCCESS) {
+			goto func_exit;
+		} else if (trx_is_interrupted(trx)) {
+			goto interrupted;
+		} else if (next_mrec == next_mrec_end) {
+			mrec = NULL;
+		} else {
+			/* The last record continues in the next block. */
+			memcpy(index->online_log->head.buf, mrec,
+			       ulint(mrec_end - mrec));
+			mrec_end += ulint(index->online_log->head.buf - mrec);
+			mrec = index->online_log->head.buf;
+		}
+
+		goto process_next_block;
+	}
+
 	while (!trx_is_interrupted(trx)) {
 		mrec = next_mrec;
 		ut_ad(mrec < mrec_end);
@@ -3698,6 +3998,7 @@ row_log_apply_ops(
 		index->type |= DICT_CORRUPT;
 	}
 
+	delete batch;
 	mem_heap_free(heap);
 	mem_heap_free(offsets_heap);
 	row_log_block_free(index->online_log->head);
@@ -51,6 +51,7 @@ Created 10/8/1995 Heikki Tuuri
 #include "ibuf0ibuf.h"
 #include "lock0lock.h"
 #include "log0recv.h"
+#include "log0online.h"
 #include "mem0mem.h"
 #include "pars0pars.h"
 #include "que0que.h"
@@ -119,6 +120,12 @@ my_bool	srv_undo_log_truncate;
 /** Maximum size of undo tablespace. */
 unsigned long long	srv_max_undo_log_size;
 
+/** Whether written pages are recorded for incremental backups
+(innodb_track_changed_pages) */
+my_bool	srv_track_changed_pages;
+/** Size of a changed page bitmap file after which a new one is started */
+unsigned long long	srv_max_bitmap_file_size;
+
 /** Set if InnoDB must operate in read-only mode. We don't do any
 recovery and open all tables in RO mode instead of RW mode. We don't
 sync the max trx id to disk either. */
@@ -134,6 +141,10 @@ my_bool	high_level_read_only;
 ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
+/** innodb_online_alter_log_apply_threads */
+uint	srv_online_apply_threads;
+/** innodb_import_threads */
+uint	srv_import_threads;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -274,6 +285,10 @@ by SELECT or mysqldump. When this is nonzero, we do not allow any user
 modifications to the data. */
 ulong	srv_force_recovery;
 
+/** innodb_recovery_parallel_init: whether crash recovery initializes
+the pages that are not read in srv_n_read_io_threads tasks */
+my_bool	srv_recovery_parallel_init = TRUE;
+
 /** innodb_print_all_deadlocks; whether to print all user-level
 transactions deadlocks to the error log */
 my_bool	srv_print_all_deadlocks;
@@ -1566,6 +1581,12 @@ void srv_master_callback(void*)
   MONITOR_INC_TIME_IN_MICRO_SECS(MONITOR_SRV_LOG_FLUSH_MICROSECOND,
 				 counter_time);
 
+  if (srv_track_changed_pages)
+  {
+    srv_main_thread_op_info= "writing changed page bitmap";
+    log_online_write_run(false);
+  }
+
   if (srv_check_activity(&old_activity_count))
     srv_master_do_active_tasks(counter_time);
   else
@@ -62,6 +62,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "mtr0mtr.h"
 #include "log0crypt.h"
 #include "log0recv.h"
+#include "log0online.h"
 #include "page0page.h"
 #include "page0cur.h"
 #include "trx0trx.h"
@@ -1044,6 +1045,8 @@ dberr_t srv_start(bool create_new_db)
 
 	srv_startup_is_before_trx_rollback_phase = true;
 
+	log_online_init();
+
 	if (!srv_read_only_mode) {
 		buf_flush_page_cleaner_init();
 		ut_ad(buf_page_cleaner_is_active);
@@ -1168,6 +1171,7 @@ dberr_t srv_start(bool create_new_db)
 		}
 
 		buf_flush_sync();
+		log_online_start(log_sys.get_lsn());
 
 		ut_ad(!srv_log_file_created);
 		ut_d(srv_log_file_created= true);
@@ -1193,6 +1197,12 @@ dberr_t srv_start(bool create_new_db)
 			return(srv_init_abort(err));
 		}
 
+		/* After a crash, pages that were modified after the
+		checkpoint may have been written without being recorded. */
+		log_online_start(recv_needed_recovery
+				 ? log_sys.get_lsn()
+				 : log_sys.last_checkpoint_lsn.load());
+
 		switch (srv_operation) {
 		case SRV_OPERATION_NORMAL:
 		case SRV_OPERATION_RESTORE_EXPORT:
@@ -1678,6 +1688,7 @@ void innodb_shutdown()
 	case SRV_OPERATION_NORMAL:
 		/* Shut down the persistent files. */
 		logs_empty_and_mark_files_at_shutdown();
+		log_online_close();
 	}
 
 	os_aio_free();
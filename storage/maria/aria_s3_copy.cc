@@ -43,7 +43,7 @@ static my_bool opt_compression, opt_verbose, opt_force, opt_s3_debug;
 static my_bool opt_s3_use_http;
 static ulong opt_operation= OP_IMPOSSIBLE, opt_protocol_version= 1;
 static ulong opt_block_size;
-static ulong opt_s3_port;
+static ulong opt_s3_port, opt_parallel;
 static char **default_argv=0;
 static ms3_st *global_s3_client= 0;
 
@@ -90,6 +90,10 @@ static struct my_option my_long_options[] =
    "Protocol used to communication with S3. One of \"Auto\", \"Amazon\" or \"Original\".",
    &opt_protocol_version, &opt_protocol_version, &s3_protocol_typelib,
    GET_ENUM, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"parallel", 'j', "Number of blocks to copy in parallel. Each block is "
+   "copied by its own thread with its own connection to S3",
+   &opt_parallel, &opt_parallel, 0, GET_ULONG, REQUIRED_ARG,
+   1, 1, 64, 0, 1, 0 },
   {"force", 'f', "Force copy even if target exists",
    &opt_force, &opt_force, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
   {"verbose", 'v', "Write more information", &opt_verbose, &opt_verbose,
@@ -202,10 +206,22 @@ static void get_options(int *argc, char ***argv)
 
 int main(int argc, char** argv)
 {
+  S3_INFO s3_info;
   MY_INIT(argv[0]);
   get_options(&argc,(char***) &argv);
   size_t block_size= opt_block_size;
 
+  /* Used to open the extra connections for --parallel */
+  bzero(&s3_info, sizeof(s3_info));
+  lex_string_set(&s3_info.access_key, opt_s3_access_key);
+  lex_string_set(&s3_info.secret_key, opt_s3_secret_key);
+  lex_string_set(&s3_info.region,     opt_s3_region);
+  lex_string_set(&s3_info.host_name,  opt_s3_host_name);
+  lex_string_set(&s3_info.bucket,     opt_s3_bucket);
+  s3_info.port=             (int) opt_s3_port;
+  s3_info.use_http=         opt_s3_use_http;
+  s3_info.protocol_version= (uint8_t) opt_protocol_version;
+
   s3_init_library();
   if (!(global_s3_client= ms3_init(opt_s3_access_key,
                                    opt_s3_secret_key,
@@ -258,7 +274,8 @@ int main(int argc, char** argv)
       /* Don't copy .frm file for partioned table */
       if (aria_copy_to_s3(global_s3_client, opt_s3_bucket, path,
                           db, table_name, opt_block_size, opt_compression,
-                          opt_force, opt_verbose, !strstr(table_name, "#P#")))
+                          opt_force, opt_verbose, !strstr(table_name, "#P#"),
+                          &s3_info, (uint) opt_parallel))
       {
         fprintf(stderr, "Aborting copying of %s\n", path);
         my_exit(-1);
@@ -266,7 +283,8 @@ int main(int argc, char** argv)
       break;
     case 1:
       if (aria_copy_from_s3(global_s3_client, opt_s3_bucket, path,
-                          db, opt_compression, opt_force, opt_verbose))
+                          db, opt_compression, opt_force, opt_verbose,
+                          &s3_info, (uint) opt_parallel))
       {
         fprintf(stderr, "Aborting copying of %s\n", path);
         my_exit(-1);
@@ -60,6 +60,7 @@ C_MODE_END
 #define THD_TRN (TRN*) thd_get_ha_data(thd, maria_hton)
 
 ulong pagecache_division_limit, pagecache_age_threshold, pagecache_file_hash_size;
+ulong pagecache_segments;
 ulonglong pagecache_buffer_size;
 const char *zerofill_error_msg=
   "Table is probably from another system and must be zerofilled or repaired ('REPAIR TABLE table_name') to be usable on this system";
@@ -256,6 +257,16 @@ static MYSQL_SYSVAR_ULONG(pagecache_file_hash_size, pagecache_file_hash_size,
        "value is probably 1/10 of number of possible open Aria files.", 0,0,
        512, 128, 16384, 1);
 
+static MYSQL_SYSVAR_ULONG(pagecache_segments, pagecache_segments,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of partitions the page cache is split into. Each partition "
+       "has its own lock and LRU chain, and caches all the pages of the "
+       "files mapped to it. Use more than 1 to reduce contention when many "
+       "threads use different Aria tables, like internal temporary tables. "
+       "aria_pagecache_buffer_size is divided evenly between the "
+       "partitions.", 0, 0,
+       1, 1, 64, 1);
+
 static MYSQL_SYSVAR_SET(recover_options, maria_recover_options, PLUGIN_VAR_OPCMDARG,
        "Specifies how corrupted tables should be automatically repaired",
        NULL, NULL, HA_RECOVER_BACKUP|HA_RECOVER_QUICK, &maria_recover_typelib);
@@ -265,6 +276,13 @@ static MYSQL_THDVAR_ULONG(repair_threads, PLUGIN_VAR_RQCMDARG,
        "disables parallel repair.",
        0, 0, 1, 1, 128, 1);
 
+static MYSQL_THDVAR_BOOL(row_locking, PLUGIN_VAR_OPCMDARG,
+       "Let UPDATE statements on the same transactional Aria table run at "
+       "the same time and lock the rows they read instead. An UPDATE that "
+       "changes a key or moves a row still waits until it is alone in the "
+       "table",
+       0, 0, 0);
+
 static MYSQL_THDVAR_ULONGLONG(sort_buffer_size, PLUGIN_VAR_RQCMDARG,
        "The buffer that is allocated when sorting the index when doing a "
        "REPAIR or when creating indexes with CREATE INDEX or ALTER TABLE.",
@@ -316,6 +334,7 @@ static PSI_mutex_info all_aria_mutexes[]=
   { &key_SHARE_intern_lock, "SHARE::intern_lock", 0},
   { &key_SHARE_key_del_lock, "SHARE::key_del_lock", 0},
   { &key_SHARE_close_lock, "SHARE::close_lock", 0},
+  { &key_SHARE_row_lock_mutex, "SHARE::row_lock_mutex", 0},
   { &key_SERVICE_THREAD_CONTROL_lock, "SERVICE_THREAD_CONTROL::LOCK_control", 0},
   { &key_TRN_state_lock, "TRN::state_lock", 0},
   { &key_PAGECACHE_cache_lock, "PAGECACHE::cache_lock", 0}
@@ -325,6 +344,7 @@ static PSI_cond_info all_aria_conds[]=
 {
   { &key_COND_soft_sync, "COND_soft_sync", PSI_FLAG_GLOBAL},
   { &key_SHARE_key_del_cond, "SHARE::key_del_cond", 0},
+  { &key_SHARE_row_lock_cond, "SHARE::row_lock_cond", 0},
   { &key_SERVICE_THREAD_CONTROL_cond, "SERVICE_THREAD_CONTROL::COND_control", 0},
   { &key_SORT_INFO_cond, "SORT_INFO::cond", 0},
   { &key_SHARE_BITMAP_cond, "BITMAP::bitmap_cond", 0},
@@ -2438,7 +2458,7 @@ int ha_maria::index_read_map(uchar * buf, const uchar * key,
   DBUG_ASSERT(inited == INDEX);
   register_handler(file);
   int error= maria_rkey(file, buf, active_index, key, keypart_map, find_flag);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2457,7 +2477,7 @@ int ha_maria::index_read_idx_map(uchar * buf, uint index, const uchar * key,
   error= maria_rkey(file, buf, index, key, keypart_map, find_flag);
 
   ma_set_index_cond_func(file, NULL, 0);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2469,7 +2489,7 @@ int ha_maria::index_read_last_map(uchar * buf, const uchar * key,
   register_handler(file);
   int error= maria_rkey(file, buf, active_index, key, keypart_map,
                         HA_READ_PREFIX_LAST);
-  DBUG_RETURN(error);
+  DBUG_RETURN(lock_row(buf, error));
 }
 
 
@@ -2478,7 +2498,7 @@ int ha_maria::index_next(uchar * buf)
   DBUG_ASSERT(inited == INDEX);
   register_handler(file);
   int error= maria_rnext(file, buf, active_index);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2487,7 +2507,7 @@ int ha_maria::index_prev(uchar * buf)
   DBUG_ASSERT(inited == INDEX);
   register_handler(file);
   int error= maria_rprev(file, buf, active_index);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2496,7 +2516,7 @@ int ha_maria::index_first(uchar * buf)
   DBUG_ASSERT(inited == INDEX);
   register_handler(file);
   int error= maria_rfirst(file, buf, active_index);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2505,7 +2525,7 @@ int ha_maria::index_last(uchar * buf)
   DBUG_ASSERT(inited == INDEX);
   register_handler(file);
   int error= maria_rlast(file, buf, active_index);
-  return error;
+  return lock_row(buf, error);
 }
 
 
@@ -2522,7 +2542,7 @@ int ha_maria::index_next_same(uchar * buf,
   */
   do
   {
-    error= maria_rnext_same(file,buf);
+    error= lock_row(buf, maria_rnext_same(file,buf));
   } while (error == HA_ERR_RECORD_DELETED);
   return error;
 }
@@ -2567,7 +2587,7 @@ int ha_maria::rnd_end()
 int ha_maria::rnd_next(uchar *buf)
 {
   register_handler(file);
-  return maria_scan(file, buf);
+  return lock_row(buf, maria_scan(file, buf), 1);
 }
 
 
@@ -2592,10 +2612,41 @@ int ha_maria::rnd_pos(uchar *buf, uchar *pos)
 {
   register_handler(file);
   int error= maria_rrnd(file, buf, my_get_ptr(pos, ref_length));
+  return lock_row(buf, error);
+}
+
+
+/**
+   Lock the row just read by an UPDATE that uses row locks
+
+   If we had to wait for the lock or did not have it before, the row may
+   have been changed by another transaction since it was read, so it is
+   read again. After a wait, a table scan must also read its page again.
+*/
+
+int ha_maria::lock_row(uchar *buf, int error, bool scan)
+{
+  my_bool waited;
+  if (error || !file->row_locking)
+    return error;
+  if ((error= _ma_row_lock(file, file->cur_row.lastpos, &waited)))
+    return error;
+  if (waited && scan &&
+      (error= _ma_scan_reread_page_block_record(file)))
+    return error;
+  if (waited || file->row_lock_new)
+    error= (*file->read_record)(file, buf, file->cur_row.lastpos);
   return error;
 }
 
 
+void ha_maria::unlock_row()
+{
+  if (file->row_locking)
+    _ma_row_unlock(file, file->cur_row.lastpos);
+}
+
+
 void ha_maria::position(const uchar *record)
 {
   my_off_t row_position= maria_position(file);
@@ -2841,6 +2892,20 @@ int ha_maria::external_lock(THD *thd, int lock_type)
     /* Transactional table */
     if (lock_type != F_UNLCK)
     {
+      if (file->s->have_versioning && !table->s->tmp_table &&
+          (lock_type != F_WRLCK || file->row_locking))
+      {
+        /*
+          Let an UPDATE that uses row locks know about the readers and
+          writers of the table, as they are not all excluded by thr_lock.
+        */
+        uint user= (lock_type == F_WRLCK ? MARIA_ROW_LOCK_WRITER :
+                    file->lock.type == TL_READ_NO_INSERT ?
+                    MARIA_ROW_LOCK_STRONG_READER : MARIA_ROW_LOCK_READER);
+        if ((result= _ma_row_lock_enter(file, user,
+                                        thd->variables.lock_wait_timeout)))
+          DBUG_RETURN(result);
+      }
       if (file->trn)
       {
         /* This can only happen with tables created with clone() */
@@ -2893,6 +2958,8 @@ int ha_maria::external_lock(THD *thd, int lock_type)
       */
       if (_ma_reenable_logging_for_table(file, TRUE))
         DBUG_RETURN(1);
+      _ma_row_lock_leave(file);
+      file->row_locking= 0;
       _ma_reset_trn_for_table(file);
       /*
         Ensure that file->state points to the current number of rows. This
@@ -2935,7 +3002,11 @@ int ha_maria::external_lock(THD *thd, int lock_type)
   if ((result2= maria_lock_database(file, !table->s->tmp_table ?
                                     lock_type : ((lock_type == F_UNLCK) ?
                                                  F_UNLCK : F_EXTRA_LCK))))
+  {
     result= result2;
+    if (lock_type != F_UNLCK)
+      _ma_row_lock_leave(file);
+  }
   if (!file->s->base.born_transactional)
     file->state= &file->s->state.state;         // Restore state if clone
 
@@ -3161,6 +3232,24 @@ THR_LOCK_DATA **ha_maria::store_lock(THD *thd,
           (sql_command == SQLCOM_LOAD && duplicates == DUP_REPLACE))
         lock_type= TL_WRITE;
     }
+    /*
+      With aria_row_locking, UPDATE of different rows of the table can run
+      at the same time. Rows are then locked when read, see ma_rowlock.c.
+      Statement based logging needs the statements in commit order, so
+      this is not done then.
+    */
+    file->row_locking= 0;
+    if (lock_type == TL_WRITE && sql_command == SQLCOM_UPDATE &&
+        THDVAR(thd, row_locking) && file->s->have_versioning &&
+        !thd->locked_tables_mode &&
+        table->pos_in_table_list == thd->lex->query_tables &&
+        (thd->is_current_stmt_binlog_format_row() ||
+         !(thd->variables.option_bits & OPTION_BIN_LOG) ||
+         !mysql_bin_log.is_open()))
+    {
+      lock_type= TL_WRITE_ALLOW_WRITE;
+      file->row_locking= 1;
+    }
     file->lock.type= lock_type;
   }
   *to++= &file->lock;
@@ -3836,10 +3925,11 @@ static int ha_maria_init(void *p)
   res= res ||
     ((force_start_after_recovery_failures != 0 && !aria_readonly) &&
      mark_recovery_start(log_dir)) ||
-    !init_pagecache(maria_pagecache,
-                    (size_t) pagecache_buffer_size, pagecache_division_limit,
-                    pagecache_age_threshold, maria_block_size, pagecache_file_hash_size,
-                    0) ||
+    !init_partitioned_pagecache(maria_pagecache, (uint) pagecache_segments,
+                                (size_t) pagecache_buffer_size,
+                                pagecache_division_limit,
+                                pagecache_age_threshold, maria_block_size,
+                                pagecache_file_hash_size, 0) ||
     !init_pagecache(maria_log_pagecache,
                     TRANSLOG_PAGECACHE_SIZE, 0, 0,
                     TRANSLOG_PAGE_SIZE, 0, 0) ||
@@ -3857,6 +3947,7 @@ static int ha_maria_init(void *p)
   maria_multi_threaded= maria_in_ha_maria= TRUE;
   maria_create_trn_hook= maria_create_trn_for_mysql;
   maria_pagecache->extra_debug= 1;
+  pagecache_set_partition_params(maria_pagecache);
   maria_assert_if_crashed_table= debug_assert_if_crashed_table;
 
   if (res)
@@ -3964,8 +4055,10 @@ static struct st_mysql_sys_var *system_variables[]= {
   MYSQL_SYSVAR(pagecache_buffer_size),
   MYSQL_SYSVAR(pagecache_division_limit),
   MYSQL_SYSVAR(pagecache_file_hash_size),
+  MYSQL_SYSVAR(pagecache_segments),
   MYSQL_SYSVAR(recover_options),
   MYSQL_SYSVAR(repair_threads),
+  MYSQL_SYSVAR(row_locking),
   MYSQL_SYSVAR(sort_buffer_size),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(sync_log_dir),
@@ -4088,14 +4181,40 @@ static void update_log_file_size(MYSQL_THD thd,
 }
 
 
+/*
+  The counters of a partitioned page cache are summed up when shown.
+  The sums and the variables pointing to them are stored in buff.
+*/
+static int show_pagecache_vars(THD *thd, SHOW_VAR *var, char *buff)
+{
+  struct pagecache_status
+  {
+    PAGECACHE_STATS stats;
+    SHOW_VAR vars[8];
+  } *status= (struct pagecache_status*) buff;
+  PAGECACHE_STATS *stats= &status->stats;
+  compile_time_assert(sizeof(*status) <= SHOW_VAR_FUNC_BUFF_SIZE);
+  pagecache_get_stats(maria_pagecache, stats);
+  SHOW_VAR vars[]= {
+    {"blocks_not_flushed", (char*) &stats->global_blocks_changed, SHOW_LONG},
+    {"blocks_unused",      (char*) &stats->blocks_unused, SHOW_LONG},
+    {"blocks_used",        (char*) &stats->blocks_used, SHOW_LONG},
+    {"read_requests",      (char*) &stats->global_cache_r_requests, SHOW_LONGLONG},
+    {"reads",              (char*) &stats->global_cache_read, SHOW_LONGLONG},
+    {"write_requests",     (char*) &stats->global_cache_w_requests, SHOW_LONGLONG},
+    {"writes",             (char*) &stats->global_cache_write, SHOW_LONGLONG},
+    {NullS, NullS, SHOW_LONG}
+  };
+  memcpy(status->vars, vars, sizeof(vars));
+  var->type= SHOW_ARRAY;
+  var->value= (char*) status->vars;
+  return 0;
+}
+
 static SHOW_VAR status_variables[]= {
-  {"pagecache_blocks_not_flushed", (char*) &maria_pagecache_var.global_blocks_changed, SHOW_LONG},
-  {"pagecache_blocks_unused",      (char*) &maria_pagecache_var.blocks_unused, SHOW_LONG},
-  {"pagecache_blocks_used",        (char*) &maria_pagecache_var.blocks_used, SHOW_LONG},
-  {"pagecache_read_requests",      (char*) &maria_pagecache_var.global_cache_r_requests, SHOW_LONGLONG},
-  {"pagecache_reads",              (char*) &maria_pagecache_var.global_cache_read, SHOW_LONGLONG},
-  {"pagecache_write_requests",     (char*) &maria_pagecache_var.global_cache_w_requests, SHOW_LONGLONG},
-  {"pagecache_writes",             (char*) &maria_pagecache_var.global_cache_write, SHOW_LONGLONG},
+  {"pagecache",                    (char*) &show_pagecache_vars, SHOW_FUNC},
+  {"transaction_log_flush_waits",  (char*) &translog_flush_waits, SHOW_LONGLONG},
+  {"transaction_log_flushes",      (char*) &translog_flushes, SHOW_LONGLONG},
   {"transaction_log_syncs",        (char*) &translog_syncs, SHOW_LONGLONG},
   {NullS, NullS, SHOW_LONG}
 };
@@ -61,6 +61,7 @@ class __attribute__((visibility("default"))) ha_maria :public handler
   uint8 bulk_insert_single_undo;
   int repair(THD * thd, HA_CHECK *param, bool optimize);
   int zerofill(THD * thd, HA_CHECK_OPT *check_opt);
+  int lock_row(uchar *buf, int error, bool scan= 0);
 
 public:
   ha_maria(handlerton *hton, TABLE_SHARE * table_arg);
@@ -80,7 +81,7 @@ class __attribute__((visibility("default"))) ha_maria :public handler
   virtual double scan_time() override final;
 
   int open(const char *name, int mode, uint test_if_locked) override;
-  int close(void) override final;
+  int close(void) override;
   int write_row(const uchar * buf) override;
   int update_row(const uchar * old_data, const uchar * new_data) override;
   int delete_row(const uchar * buf) override;
@@ -107,18 +108,19 @@ class __attribute__((visibility("default"))) ha_maria :public handler
   int ft_read(uchar * buf) override final;
   int index_init(uint idx, bool sorted) override final;
   int index_end() override final;
-  int rnd_init(bool scan) override final;
-  int rnd_end(void) override final;
+  int rnd_init(bool scan) override;
+  int rnd_end(void) override;
   int rnd_next(uchar * buf) override final;
   int rnd_pos(uchar * buf, uchar * pos) override final;
   int remember_rnd_pos() override final;
   int restart_rnd_next(uchar * buf) override final;
+  void unlock_row() override final;
   void position(const uchar * record) override final;
   int info(uint) override final;
   int info(uint, my_bool);
   int extra(enum ha_extra_function operation) override final;
   int extra_opt(enum ha_extra_function operation, ulong cache_size) override final;
-  int reset(void) override final;
+  int reset(void) override;
   int external_lock(THD * thd, int lock_type) override;
   int start_stmt(THD *thd, thr_lock_type lock_type) override final;
   int delete_all_rows(void) override final;
@@ -80,7 +80,8 @@
 static PAGECACHE s3_pagecache;
 static ulong s3_block_size, s3_protocol_version;
 static ulong s3_pagecache_division_limit, s3_pagecache_age_threshold;
-static ulong s3_pagecache_file_hash_size;
+static ulong s3_pagecache_file_hash_size, s3_pagecache_segments;
+static ulong s3_read_ahead_blocks, s3_copy_threads;
 static ulonglong s3_pagecache_buffer_size;
 static char *s3_bucket, *s3_access_key=0, *s3_secret_key=0, *s3_region;
 static char *s3_host_name;
@@ -179,6 +180,50 @@ static MYSQL_SYSVAR_ULONG(pagecache_file_hash_size,
        "changes. A good value is probably 1/10 of number of possible open "
        "S3 files.", 0,0, 512, 32, 16384, 1);
 
+static MYSQL_SYSVAR_ULONG(pagecache_segments,
+                          s3_pagecache_segments,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of partitions the S3 page cache is split into. Each "
+       "partition has its own lock and LRU chain, and caches all the pages "
+       "of the files mapped to it. s3_pagecache_buffer_size is divided "
+       "evenly between the partitions.", 0, 0, 1, 1, 64, 1);
+
+static MYSQL_SYSVAR_ULONG(read_ahead_blocks, s3_read_ahead_blocks,
+       PLUGIN_VAR_RQCMDARG,
+       "Number of data blocks to read ahead in parallel when scanning a S3 "
+       "table. Each block is fetched by its own thread with its own "
+       "connection to S3. The threads are started at the first scan of a "
+       "table in a statement and stopped at the end of the statement. 0 "
+       "disables read ahead", 0, 0, 0, 0, 32, 1);
+
+static MYSQL_SYSVAR_ULONG(copy_threads, s3_copy_threads,
+       PLUGIN_VAR_RQCMDARG,
+       "Number of blocks to upload in parallel when a table is moved to S3 "
+       "with ALTER TABLE. Each block is uploaded by its own thread with its "
+       "own connection to S3", 0, 0, 1, 1, 64, 1);
+
+static MYSQL_SYSVAR_STR(block_cache_dir, s3_block_cache_dir,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Directory on local disk where blocks read from S3 are stored. "
+       "Later reads of the same blocks are done from disk. The blocks of a "
+       "table are removed when it's dropped or renamed. Empty (default) "
+       "means that blocks are not stored locally",
+       0, 0, "");
+
+static void update_block_cache_size(MYSQL_THD thd,
+                                    struct st_mysql_sys_var *var,
+                                    void *var_ptr, const void *save)
+{
+  s3_block_cache_resize(*(ulonglong*) save);
+}
+
+static MYSQL_SYSVAR_ULONGLONG(block_cache_size, s3_block_cache_size,
+       PLUGIN_VAR_RQCMDARG,
+       "Maximum size of the blocks stored in s3_block_cache_dir. When it's "
+       "reached, the least recently used blocks are removed. 0 means no "
+       "limit", 0, update_block_cache_size, 1024*1024*1024ULL, 0,
+       ULONGLONG_MAX, 8192);
+
 static MYSQL_SYSVAR_STR(bucket, s3_bucket,
        PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
       "AWS bucket",
@@ -233,7 +278,8 @@ ha_create_table_option s3_table_option_list[]=
 
 
 ha_s3::ha_s3(handlerton *hton, TABLE_SHARE *table_arg)
-  :ha_maria(hton, table_arg), in_alter_table(S3_NO_ALTER)
+  :ha_maria(hton, table_arg), in_alter_table(S3_NO_ALTER), read_ahead(0),
+   read_ahead_blocks(0)
 {
   /* Remove things that S3 doesn't support */
   int_table_flags&= ~(HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE |
@@ -379,6 +425,8 @@ int ha_s3::delete_table(const char *name)
   error= aria_delete_from_s3(s3_client, s3_info.bucket.str,
                              s3_info.database.str,
                              s3_info.table.str,0);
+  s3_block_cache_delete_table(s3_info.bucket.str, s3_info.database.str,
+                              s3_info.table.str);
   s3_deinit(s3_client);
   DBUG_RETURN(error);
 }
@@ -400,7 +448,8 @@ static int move_table_to_s3(ms3_st *s3_client,
   if (!(error= aria_copy_to_s3(s3_client, to_s3_info->bucket.str, local_name,
                                to_s3_info->database.str,
                                to_s3_info->table.str,
-                               0, 0, 1, 0, !is_partition)))
+                               0, 0, 1, 0, !is_partition,
+                               to_s3_info, (uint) s3_copy_threads)))
   {
     /* Table now in S3. Remove original files table files, keep .frm */
     error= maria_delete_table_files(local_name, 1, 0);
@@ -475,6 +524,9 @@ int ha_s3::rename_table(const char *from, const char *to)
                           to_s3_info.table.str,
                           !is_partition &&
                           !current_thd->lex->alter_info.partition_flags);
+    s3_block_cache_delete_table(from_s3_info.bucket.str,
+                                from_s3_info.database.str,
+                                from_s3_info.table.str);
   }
   s3_deinit(s3_client);
   DBUG_RETURN(error);
@@ -647,6 +699,85 @@ int ha_s3::open(const char *name, int mode, uint open_flags)
 }
 
 
+int ha_s3::close(void)
+{
+  end_read_ahead();
+  return ha_maria::close();
+}
+
+
+/**
+   Stop the read ahead threads of the handler
+*/
+
+void ha_s3::end_read_ahead()
+{
+  if (read_ahead)
+  {
+    s3_read_ahead_end(read_ahead);
+    read_ahead= 0;
+  }
+  if (file)
+    file->s3_read_ahead= 0;
+}
+
+
+/**
+   Start a table scan
+
+   If the table is in S3, read ahead the data blocks that follow the ones
+   read by the scan. The read ahead threads are started at the first scan
+   and are reused by the following scans of the handler in the same
+   statement, like the rescans of the inner table of a join. They are
+   stopped in reset(), so that the handlers in the table cache don't keep
+   idle threads and S3 connections.
+*/
+
+int ha_s3::rnd_init(bool scan)
+{
+  if (read_ahead && read_ahead_blocks != s3_read_ahead_blocks)
+  {
+    /* s3_read_ahead_blocks was changed */
+    end_read_ahead();
+  }
+  if (scan && s3_read_ahead_blocks && file->s->s3_path)
+  {
+    if (read_ahead)
+      s3_read_ahead_reset(read_ahead);
+    else
+    {
+      read_ahead_blocks= (uint) s3_read_ahead_blocks;
+      read_ahead= s3_read_ahead_start(file, read_ahead_blocks);
+    }
+    file->s3_read_ahead= read_ahead;
+  }
+  return ha_maria::rnd_init(scan);
+}
+
+
+int ha_s3::rnd_end()
+{
+  if (file->s3_read_ahead)
+  {
+    /* Free the blocks that were read ahead but not used */
+    s3_read_ahead_reset(file->s3_read_ahead);
+    file->s3_read_ahead= 0;
+  }
+  return ha_maria::rnd_end();
+}
+
+
+/**
+   End of statement: stop the read ahead threads
+*/
+
+int ha_s3::reset(void)
+{
+  end_read_ahead();
+  return ha_maria::reset();
+}
+
+
 int ha_s3::external_lock(THD * thd, int lock_type)
 {
   int error;
@@ -725,6 +856,7 @@ static int s3_hton_panic(handlerton *hton, ha_panic_function flag)
   if (flag == HA_PANIC_CLOSE && s3_hton)
   {
     end_pagecache(&s3_pagecache, TRUE);
+    s3_block_cache_end();
     s3_deinit_library();
     my_free(s3_access_key);
     my_free(s3_secret_key);
@@ -1037,15 +1169,19 @@ static int ha_s3_init(void *p)
   update_access_key(0,0,0,0);
   update_secret_key(0,0,0,0);
 
-  if ((res= !init_pagecache(&s3_pagecache,
-                            (size_t) s3_pagecache_buffer_size,
-                            s3_pagecache_division_limit,
-                            s3_pagecache_age_threshold, maria_block_size,
-                            s3_pagecache_file_hash_size, 0)))
+  if ((res= !init_partitioned_pagecache(&s3_pagecache,
+                                        (uint) s3_pagecache_segments,
+                                        (size_t) s3_pagecache_buffer_size,
+                                        s3_pagecache_division_limit,
+                                        s3_pagecache_age_threshold,
+                                        maria_block_size,
+                                        s3_pagecache_file_hash_size, 0)))
     s3_hton= 0;
   s3_pagecache.big_block_read= s3_block_read;
   s3_pagecache.big_block_free= s3_free;
+  pagecache_set_partition_params(&s3_pagecache);
   s3_init_library();
+  s3_block_cache_init();
   if (s3_debug)
     ms3_debug();
 
@@ -1066,29 +1202,55 @@ static int ha_s3_deinit(void*)
   return 0;
 }
 
+/*
+  The counters of a partitioned page cache are summed up when shown.
+  The sums and the variables pointing to them are stored in buff.
+*/
+static int show_pagecache_vars(THD *thd, SHOW_VAR *var, char *buff)
+{
+  struct pagecache_status
+  {
+    PAGECACHE_STATS stats;
+    SHOW_VAR vars[6];
+  } *status= (struct pagecache_status*) buff;
+  PAGECACHE_STATS *stats= &status->stats;
+  compile_time_assert(sizeof(*status) <= SHOW_VAR_FUNC_BUFF_SIZE);
+  pagecache_get_stats(&s3_pagecache, stats);
+  SHOW_VAR vars[]= {
+    {"blocks_not_flushed", (char*) &stats->global_blocks_changed, SHOW_LONG},
+    {"blocks_unused",      (char*) &stats->blocks_unused, SHOW_LONG},
+    {"blocks_used",        (char*) &stats->blocks_used, SHOW_LONG},
+    {"read_requests",      (char*) &stats->global_cache_r_requests, SHOW_LONGLONG},
+    {"reads",              (char*) &stats->global_cache_read, SHOW_LONGLONG},
+    {NullS, NullS, SHOW_LONG}
+  };
+  memcpy(status->vars, vars, sizeof(vars));
+  var->type= SHOW_ARRAY;
+  var->value= (char*) status->vars;
+  return 0;
+}
+
 static SHOW_VAR status_variables[]= {
-  {"pagecache_blocks_not_flushed",
-   (char*) &s3_pagecache.global_blocks_changed, SHOW_LONG},
-  {"pagecache_blocks_unused",
-   (char*) &s3_pagecache.blocks_unused, SHOW_LONG},
-  {"pagecache_blocks_used",
-   (char*) &s3_pagecache.blocks_used, SHOW_LONG},
-  {"pagecache_read_requests",
-   (char*) &s3_pagecache.global_cache_r_requests, SHOW_LONGLONG},
-  {"pagecache_reads",
-   (char*) &s3_pagecache.global_cache_read, SHOW_LONGLONG},
+  {"block_cache_hits", (char*) &s3_block_cache_hits, SHOW_LONGLONG},
+  {"pagecache", (char*) &show_pagecache_vars, SHOW_FUNC},
+  {"read_ahead_hits", (char*) &s3_read_ahead_hits, SHOW_LONGLONG},
   {NullS, NullS, SHOW_LONG}
 };
 
 
 static struct st_mysql_sys_var* system_variables[]= {
   MYSQL_SYSVAR(block_size),
+  MYSQL_SYSVAR(copy_threads),
   MYSQL_SYSVAR(debug),
   MYSQL_SYSVAR(protocol_version),
   MYSQL_SYSVAR(pagecache_age_threshold),
   MYSQL_SYSVAR(pagecache_buffer_size),
   MYSQL_SYSVAR(pagecache_division_limit),
   MYSQL_SYSVAR(pagecache_file_hash_size),
+  MYSQL_SYSVAR(pagecache_segments),
+  MYSQL_SYSVAR(read_ahead_blocks),
+  MYSQL_SYSVAR(block_cache_dir),
+  MYSQL_SYSVAR(block_cache_size),
   MYSQL_SYSVAR(host_name),
   MYSQL_SYSVAR(port),
   MYSQL_SYSVAR(use_http),
@@ -25,6 +25,9 @@ class ha_s3 final :public ha_maria
   { S3_NO_ALTER, S3_ALTER_TABLE, S3_ADD_PARTITION, S3_ADD_TMP_PARTITION };
   alter_table_op in_alter_table;
   S3_INFO *open_args;
+  struct st_s3_read_ahead *read_ahead;  /* Kept until end of statement */
+  uint read_ahead_blocks;
+  void end_read_ahead();
 
 public:
   ha_s3(handlerton *hton, TABLE_SHARE * table_arg);
@@ -33,6 +36,10 @@ class ha_s3 final :public ha_maria
   int create(const char *name, TABLE *table_arg,
              HA_CREATE_INFO *ha_create_info) override;
   int open(const char *name, int mode, uint open_flags) override;
+  int close(void) override;
+  int rnd_init(bool scan) override;
+  int rnd_end(void) override;
+  int reset(void) override;
   int write_row(const uchar *buf) override;
   int update_row(const uchar *, const uchar *) override
   {
@@ -3750,6 +3750,7 @@ static my_bool _ma_update_block_record2(MARIA_HA *info,
   calc_record_size(info, record, new_row);
   page= ma_recordpos_to_page(record_pos);
 
+restart:
   _ma_bitmap_flushable(info, 1);
   buff= pagecache_read(share->pagecache,
                        &info->dfile, (pgcache_page_no_t) page, 0, 0,
@@ -3771,6 +3772,24 @@ static my_bool _ma_update_block_record2(MARIA_HA *info,
   */
   head_length= uint2korr(dir + 2);
 
+  if (info->row_locking && undo_lsn == LSN_ERROR &&
+      ((org_empty_size + head_length) < new_row->total_length ||
+       *cur_row->tail_positions || cur_row->extents_count) &&
+      share->row_lock_exclusive != info->trn->trid)
+  {
+    /*
+      The row will use other pages than its head page, which other UPDATE
+      statements may be reading. Wait until we are alone in the table.
+    */
+    dynamic_element(&info->pinned_pages, info->pinned_pages.elements - 1,
+                    MARIA_PINNED_PAGE*)->changed= 0;
+    _ma_unpin_all_pages(info, LSN_IMPOSSIBLE);
+    _ma_bitmap_flushable(info, -1);
+    if (_ma_row_lock_exclusive(info))
+      DBUG_RETURN(1);
+    goto restart;
+  }
+
   if ((org_empty_size + head_length) >= new_row->total_length)
   {
     uint rec_offset, length;
@@ -5390,23 +5409,42 @@ int _ma_scan_restore_block_record(MARIA_HA *info,
       Table has been changed. We have to re-read the current page block as
       data may have changed on it that we have to see.
     */
-    if (!(pagecache_read(info->s->pagecache,
-                         &info->dfile,
-                         ma_recordpos_to_page(info->scan.row_base_page),
-                         0, info->scan.page_buff,
-                         info->s->page_type,
-                         PAGECACHE_LOCK_LEFT_UNLOCKED, 0)))
-      DBUG_RETURN(my_errno);
-    info->scan.number_of_rows=
-      (uint) (uchar) info->scan.page_buff[DIR_COUNT_OFFSET];
-    info->scan.dir_end= (info->scan.page_buff + info->s->block_size -
-                         PAGE_SUFFIX_SIZE -
-                         info->scan.number_of_rows * DIR_ENTRY_SIZE);
+    DBUG_RETURN(_ma_scan_reread_page_block_record(info));
   }
   DBUG_RETURN(0);
 }
 
 
+/**
+   @brief Re-read the head page of the current scan position
+
+   @note Used when the page may have been changed by another thread,
+   like after waiting for a row lock.
+
+   @return
+   0 ok
+   # error
+*/
+
+int _ma_scan_reread_page_block_record(MARIA_HA *info)
+{
+  DBUG_ENTER("_ma_scan_reread_page_block_record");
+  if (!(pagecache_read(info->s->pagecache,
+                       &info->dfile,
+                       ma_recordpos_to_page(info->scan.row_base_page),
+                       0, info->scan.page_buff,
+                       info->s->page_type,
+                       PAGECACHE_LOCK_LEFT_UNLOCKED, 0)))
+    DBUG_RETURN(my_errno);
+  info->scan.number_of_rows=
+    (uint) (uchar) info->scan.page_buff[DIR_COUNT_OFFSET];
+  info->scan.dir_end= (info->scan.page_buff + info->s->block_size -
+                       PAGE_SUFFIX_SIZE -
+                       info->scan.number_of_rows * DIR_ENTRY_SIZE);
+  DBUG_RETURN(0);
+}
+
+
 /*
   Read next record while scanning table
 
@@ -6395,16 +6433,19 @@ uint _ma_apply_redo_insert_row_head_or_tail(MARIA_HA *info, LSN lsn,
   }
   else
   {
+    /* The read flags are those of the partition holding the file */
+    PAGECACHE *pagecache= pagecache_file_partition(share->pagecache,
+                                                   &info->dfile);
     lock_method= PAGECACHE_LOCK_LEFT_WRITELOCKED;
     pin_method=  PAGECACHE_PIN_LEFT_PINNED;
 
-    share->pagecache->readwrite_flags&= ~MY_WME;
+    pagecache->readwrite_flags&= ~MY_WME;
     share->silence_encryption_errors= 1;
     buff= pagecache_read(share->pagecache, &info->dfile,
                          page, 0, 0,
                          PAGECACHE_PLAIN_PAGE, PAGECACHE_LOCK_WRITE,
                          &page_link.link);
-    share->pagecache->readwrite_flags= share->pagecache->org_readwrite_flags;
+    pagecache->readwrite_flags= pagecache->org_readwrite_flags;
     share->silence_encryption_errors= 0;
     if (!buff)
     {
@@ -6902,15 +6943,16 @@ uint _ma_apply_redo_insert_row_blobs(MARIA_HA *info,
         }
         else
         {
-          share->pagecache->readwrite_flags&= ~MY_WME;
+          PAGECACHE *pagecache= pagecache_file_partition(share->pagecache,
+                                                         &info->dfile);
+          pagecache->readwrite_flags&= ~MY_WME;
           share->silence_encryption_errors= 1;
           buff= pagecache_read(share->pagecache,
                                &info->dfile,
                                page, 0, 0,
                                PAGECACHE_PLAIN_PAGE,
                                PAGECACHE_LOCK_WRITE, &page_link.link);
-          share->pagecache->readwrite_flags= share->pagecache->
-            org_readwrite_flags;
+          pagecache->readwrite_flags= pagecache->org_readwrite_flags;
           share->silence_encryption_errors= 0;
           if (!buff)
           {
@@ -185,6 +185,7 @@ int _ma_scan_remember_block_record(MARIA_HA *info,
                                    MARIA_RECORD_POS *lastpos);
 int _ma_scan_restore_block_record(MARIA_HA *info,
                                   MARIA_RECORD_POS lastpos);
+int _ma_scan_reread_page_block_record(MARIA_HA *info);
 
 MARIA_RECORD_POS _ma_write_init_block_record(MARIA_HA *info,
                                              const uchar *record);
@@ -569,8 +569,8 @@ pthread_handler_t ma_checkpoint_background(void *arg)
   size_t sleeps, sleep_time;
   TRANSLOG_ADDRESS log_horizon_at_last_checkpoint=
     translog_get_horizon();
-  ulonglong pagecache_flushes_at_last_checkpoint=
-    maria_pagecache->global_cache_write;
+  ulonglong pagecache_flushes_at_last_checkpoint;
+  PAGECACHE_STATS pagecache_stats;
   uint UNINIT_VAR(pages_bunch_size);
   struct st_filter_param filter_param;
   PAGECACHE_FILE *UNINIT_VAR(dfile); /**< data file currently being flushed */
@@ -578,6 +578,8 @@ pthread_handler_t ma_checkpoint_background(void *arg)
 
   my_thread_init();
   DBUG_PRINT("info",("Maria background checkpoint thread starts"));
+  pagecache_get_stats(maria_pagecache, &pagecache_stats);
+  pagecache_flushes_at_last_checkpoint= pagecache_stats.global_cache_write;
   DBUG_ASSERT(interval > 0);
 
   PSI_CALL_set_thread_account(0,0,0,0);
@@ -606,6 +608,7 @@ pthread_handler_t ma_checkpoint_background(void *arg)
       }
       {
         TRANSLOG_ADDRESS horizon= translog_get_horizon();
+        pagecache_get_stats(maria_pagecache, &pagecache_stats);
 
         /*
           With background flushing evenly distributed over the time
@@ -623,7 +626,7 @@ pthread_handler_t ma_checkpoint_background(void *arg)
         */
         if ((ulonglong) (horizon - log_horizon_at_last_checkpoint) <=
             maria_checkpoint_min_log_activity &&
-            ((ulonglong) (maria_pagecache->global_cache_write -
+            ((ulonglong) (pagecache_stats.global_cache_write -
                           pagecache_flushes_at_last_checkpoint) *
              maria_pagecache->block_size) <=
             maria_checkpoint_min_cache_activity)
@@ -642,8 +645,9 @@ pthread_handler_t ma_checkpoint_background(void *arg)
           below is possibly greater than last_checkpoint_lsn.
         */
         log_horizon_at_last_checkpoint= translog_get_horizon();
+        pagecache_get_stats(maria_pagecache, &pagecache_stats);
         pagecache_flushes_at_last_checkpoint=
-          maria_pagecache->global_cache_write;
+          pagecache_stats.global_cache_write;
         /*
           If the checkpoint above succeeded it has set d|kfiles and
           d|kfiles_end. If is has failed, it has set
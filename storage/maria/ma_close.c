@@ -291,6 +291,7 @@ void free_maria_share(MARIA_SHARE *share)
     (void) mysql_mutex_destroy(&share->intern_lock);
     (void) mysql_mutex_destroy(&share->close_lock);
     (void) mysql_cond_destroy(&share->key_del_cond);
+    _ma_row_lock_destroy(share);
     my_free(share);
     return;
   }
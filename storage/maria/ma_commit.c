@@ -36,7 +36,10 @@ int ma_commit(TRN *trn)
 
   DBUG_ASSERT(trn->rec_lsn == LSN_IMPOSSIBLE);
   if (trn->undo_lsn == 0) /* no work done, rollback (cheaper than commit) */
+  {
+    _ma_row_locks_release(trn);
     DBUG_RETURN(trnman_rollback_trn(trn));
+  }
   /*
     - if COMMIT record is written before trnman_commit_trn():
     if Checkpoint comes in the middle it will see trn is not committed,
@@ -70,6 +73,11 @@ int ma_commit(TRN *trn)
                     DBUG_PRINT("info", ("maria_sleep_in_commit"));
                     sleep(3);
                   });
+  /*
+    Row locks are released before the transaction ends, so that the
+    threads woken up by trnman_end_trn() find the rows unlocked.
+  */
+  _ma_row_locks_release(trn);
   res|= trnman_commit_trn(trn);
 
 
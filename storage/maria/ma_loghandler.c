@@ -453,6 +453,9 @@ static uint32 group_commit_wait= 0;
 
 enum enum_translog_status translog_status= TRANSLOG_UNINITED;
 ulonglong translog_syncs= 0; /* Number of sync()s */
+ulonglong translog_flushes= 0; /* Number of flush passes */
+/* Number of flush requests satisfied by a pass of another thread */
+ulonglong translog_flush_waits= 0;
 
 /* time of last flush */
 static ulonglong flush_start= 0;
@@ -3623,6 +3626,7 @@ my_bool translog_init_with_table(const char *directory,
   DBUG_ENTER("translog_init_with_table");
 
   translog_syncs= 0;
+  translog_flushes= translog_flush_waits= 0;
   flush_start= 0;
   id_to_share= NULL;
   log_purge_disabled= 0;
@@ -8145,12 +8149,25 @@ my_bool translog_flush(TRANSLOG_ADDRESS lsn)
         waiting then acquire it again
       */
       translog_flush_wait_for_end(lsn);
+      translog_flush_waits++;
       mysql_mutex_unlock(&log_descriptor.log_flush_lock);
       DBUG_RETURN(0);
     }
     log_descriptor.next_pass_max_lsn= LSN_IMPOSSIBLE;
+    if (!log_descriptor.flush_in_progress &&
+        cmp_translog_addr(log_descriptor.flushed, lsn) >= 0)
+    {
+      /*
+        The pass we have waited for sent the whole buffer with our LSN
+        to disk, so there is no need to start one more pass (and sync).
+      */
+      translog_flush_waits++;
+      mysql_mutex_unlock(&log_descriptor.log_flush_lock);
+      DBUG_RETURN(0);
+    }
   }
   log_descriptor.flush_in_progress= 1;
+  translog_flushes++;
   flush_horizon= log_descriptor.previous_flush_horizon;
   DBUG_PRINT("info", ("flush_in_progress is set, flush_horizon: " LSN_FMT,
                       LSN_IN_PARTS(flush_horizon)));
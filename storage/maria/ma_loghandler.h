@@ -379,6 +379,7 @@ enum enum_translog_status
 };
 extern enum enum_translog_status translog_status;
 extern ulonglong translog_syncs; /* Number of sync()s */
+extern ulonglong translog_flushes, translog_flush_waits;
 
 void translog_soft_sync(my_bool mode);
 void translog_hard_group_commit(my_bool mode);
@@ -392,6 +392,9 @@ MARIA_HA *maria_open(const char *name, int mode, uint open_flags,
         my_errno=HA_ERR_NOT_A_TABLE;
         goto err;
       }
+      /* Used to find blocks of this version of the table in the disk cache */
+      share_s3->header_checksum= my_checksum(0, index_header.str,
+                                             index_header.length);
       memcpy(share->state.header.file_version, index_header.str,
              head_length);
       kfile= s3f.unique_file_number();
@@ -1060,6 +1063,7 @@ MARIA_HA *maria_open(const char *name, int mode, uint open_flags,
     mysql_cond_init(key_SHARE_key_del_cond, &share->key_del_cond, 0);
     mysql_mutex_init(key_SHARE_close_lock,
                      &share->close_lock, MY_MUTEX_INIT_FAST);
+    _ma_row_lock_init(share);
     for (i=0; i<keys; i++)
       mysql_rwlock_init(key_KEYINFO_root_lock,
                         &share->keyinfo[i].root_lock);
@@ -1765,6 +1769,7 @@ uint _ma_base_info_write(File file, MARIA_BASE_INFO *base)
   *ptr++= base->keys;
   *ptr++= base->auto_key;
   *ptr++= base->born_transactional;
+  DBUG_ASSERT(ptr - buff == MARIA_BASE_INFO_COMPRESSION_POS);
   *ptr++= base->compression_algorithm;
   mi_int2store(ptr,base->pack_bytes);			ptr+= 2;
   mi_int2store(ptr,base->blobs);			ptr+= 2;
@@ -1772,6 +1777,7 @@ uint _ma_base_info_write(File file, MARIA_BASE_INFO *base)
   mi_int2store(ptr,base->max_key_length);		ptr+= 2;
   mi_int2store(ptr,base->extra_alloc_bytes);		ptr+= 2;
   *ptr++= base->extra_alloc_procent;
+  DBUG_ASSERT(ptr - buff == MARIA_BASE_INFO_S3_BLOCK_SIZE_POS);
   mi_int3store(ptr, base->s3_block_size);               ptr+= 3;
   bzero(ptr,13);					ptr+= 13; /* extra */
   DBUG_ASSERT((ptr - buff) == MARIA_BASE_INFO_SIZE);
@@ -941,6 +941,171 @@ size_t init_pagecache(PAGECACHE *pagecache, size_t use_mem,
 }
 
 
+/*
+  Initialize a partitioned page cache
+
+  SYNOPSIS
+    init_partitioned_pagecache()
+    pagecache			pointer to a page cache data structure
+    partitions                  number of partitions (0 or 1 for none)
+    use_mem                     total memory to use for all partitions
+    division_limit		division limit (may be zero)
+    age_threshold		age threshold (may be zero)
+    block_size                  size of block (should be power of 2)
+    changed_blocks_hash_size    size of the changed blocks hash of
+                                every partition
+    my_read_flags		Flags used for all pread/pwrite calls
+
+  DESCRIPTION
+    The memory is split evenly between the partitions, each of them being
+    a page cache of its own. Pages of a file always go to the same
+    partition (chosen by the file descriptor), so operations on different
+    files mostly don't contend on the same cache_lock, while flushing a
+    file still only has to look into one partition.
+
+  RETURN VALUE
+    total number of blocks in the partitions, if successful,
+    0 - otherwise.
+*/
+
+size_t init_partitioned_pagecache(PAGECACHE *pagecache, uint partitions,
+                                  size_t use_mem, uint division_limit,
+                                  uint age_threshold, uint block_size,
+                                  uint changed_blocks_hash_size,
+                                  myf my_readwrite_flags)
+{
+  size_t blocks= 0, partition_blocks;
+  uint i;
+  DBUG_ENTER("init_partitioned_pagecache");
+
+  if (partitions <= 1)
+    DBUG_RETURN(init_pagecache(pagecache, use_mem, division_limit,
+                               age_threshold, block_size,
+                               changed_blocks_hash_size,
+                               my_readwrite_flags));
+
+  if (pagecache->inited && pagecache->disk_blocks > 0)
+  {
+    DBUG_PRINT("warning",("key cache already in use"));
+    DBUG_RETURN(0);
+  }
+
+  if (!(pagecache->partition_array= (PAGECACHE*)
+        my_malloc(PSI_INSTRUMENT_ME, sizeof(PAGECACHE) * partitions,
+                  MYF(MY_WME | MY_ZEROFILL))))
+    DBUG_RETURN(0);
+
+  for (i= 0; i < partitions; i++)
+  {
+    if (!(partition_blocks= init_pagecache(pagecache->partition_array + i,
+                                           use_mem / partitions,
+                                           division_limit, age_threshold,
+                                           block_size,
+                                           changed_blocks_hash_size,
+                                           my_readwrite_flags)))
+    {
+      while (i-- > 0)
+        end_pagecache(pagecache->partition_array + i, 1);
+      my_free(pagecache->partition_array);
+      pagecache->partition_array= NULL;
+      pagecache->can_be_used= 0;
+      DBUG_RETURN(0);
+    }
+    blocks+= partition_blocks;
+  }
+
+  pagecache->partitions= partitions;
+  pagecache->big_block_read= NULL;
+  pagecache->big_block_free= NULL;
+  pagecache->mem_size= use_mem;
+  pagecache->block_size= block_size;
+  pagecache->shift= my_bit_log2_uint64(block_size);
+  pagecache->readwrite_flags= pagecache->partition_array[0].readwrite_flags;
+  pagecache->org_readwrite_flags= pagecache->readwrite_flags;
+  pagecache->disk_blocks= pagecache->blocks= blocks;
+  pagecache->blocks_unused= blocks;
+  pagecache->blocks_used= pagecache->blocks_changed= 0;
+  pagecache->global_blocks_changed= 0;
+  pagecache->global_cache_w_requests= pagecache->global_cache_r_requests= 0;
+  pagecache->global_cache_read= pagecache->global_cache_write= 0;
+  pagecache->inited= pagecache->can_be_used= 1;
+  DBUG_PRINT("exit", ("partitions: %u  blocks: %zu", partitions, blocks));
+  DBUG_RETURN(blocks);
+}
+
+
+/*
+  Get the partition of a partitioned page cache holding the pages of a file
+
+  NOTES
+    For a page cache which is not partitioned, this is the page cache
+    itself.
+*/
+
+PAGECACHE *pagecache_file_partition(PAGECACHE *pagecache,
+                                    PAGECACHE_FILE *file)
+{
+  if (likely(!pagecache->partitions))
+    return pagecache;
+  return (pagecache->partition_array +
+          (uint) file->file % pagecache->partitions);
+}
+
+
+/*
+  Give the partitions of a partitioned page cache the settings changed
+  in the page cache after its initialization
+
+  SYNOPSIS
+    pagecache_set_partition_params()
+    pagecache			pointer to a page cache data structure
+
+  DESCRIPTION
+    The users of a page cache set big_block_read, big_block_free and
+    extra_debug after init_partitioned_pagecache(). This copies them to
+    the partitions, which handle all the requests. It must be called
+    once after the settings are changed, before the page cache is used.
+*/
+
+void pagecache_set_partition_params(PAGECACHE *pagecache)
+{
+  uint i;
+  DBUG_ENTER("pagecache_set_partition_params");
+  for (i= 0; i < pagecache->partitions; i++)
+  {
+    PAGECACHE *partition= pagecache->partition_array + i;
+    pagecache_pthread_mutex_lock(&partition->cache_lock);
+    partition->big_block_read= pagecache->big_block_read;
+    partition->big_block_free= pagecache->big_block_free;
+    partition->extra_debug= pagecache->extra_debug;
+    pagecache_pthread_mutex_unlock(&partition->cache_lock);
+  }
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Get the partition of a partitioned page cache a block belongs to
+*/
+
+static PAGECACHE *pagecache_block_partition(PAGECACHE *pagecache,
+                                            PAGECACHE_BLOCK_LINK *block)
+{
+  uint i;
+  if (likely(!pagecache->partitions))
+    return pagecache;
+  for (i= 0; i < pagecache->partitions; i++)
+  {
+    PAGECACHE *partition= pagecache->partition_array + i;
+    if (block >= partition->block_root &&
+        block < partition->block_root + partition->disk_blocks)
+      return partition;
+  }
+  DBUG_ASSERT(0);
+  return pagecache->partition_array;
+}
+
+
 /*
   Flush all blocks in the key cache to disk
 */
@@ -1002,6 +1167,10 @@ static int flush_all_key_blocks(PAGECACHE *pagecache)
     performing operations with the key cache let her to proceed
     (when cnt_for_resize=0).
 
+    A partitioned page cache is resized one partition at a time, the
+    memory being split evenly between the partitions as in
+    init_partitioned_pagecache().
+
      Before being usable, this function needs:
      - to receive fixes for BUG#17332 "changing key_buffer_size on a running
      server can crash under load" similar to those done to the key cache
@@ -1022,6 +1191,22 @@ size_t resize_pagecache(PAGECACHE *pagecache,
   if (!pagecache->inited)
     DBUG_RETURN(pagecache->disk_blocks);
 
+  if (pagecache->partitions)
+  {
+    uint i;
+    blocks= 0;
+    for (i= 0; i < pagecache->partitions; i++)
+      blocks+= resize_pagecache(pagecache->partition_array + i,
+                                use_mem / pagecache->partitions,
+                                division_limit, age_threshold,
+                                changed_blocks_hash_size);
+    /* init_pagecache() has reset the settings of the partitions */
+    pagecache_set_partition_params(pagecache);
+    pagecache->mem_size= use_mem;
+    pagecache->disk_blocks= pagecache->blocks= blocks;
+    DBUG_RETURN(blocks);
+  }
+
   if(use_mem == pagecache->mem_size)
   {
     change_pagecache_param(pagecache, division_limit, age_threshold);
@@ -1130,6 +1315,15 @@ void change_pagecache_param(PAGECACHE *pagecache, uint division_limit,
 {
   DBUG_ENTER("change_pagecache_param");
 
+  if (pagecache->partitions)
+  {
+    uint i;
+    for (i= 0; i < pagecache->partitions; i++)
+      change_pagecache_param(pagecache->partition_array + i,
+                             division_limit, age_threshold);
+    DBUG_VOID_RETURN;
+  }
+
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   if (division_limit)
     pagecache->min_warm_blocks= (pagecache->disk_blocks *
@@ -1193,6 +1387,22 @@ void end_pagecache(PAGECACHE *pagecache, my_bool cleanup)
   if (!pagecache->inited)
     DBUG_VOID_RETURN;
 
+  if (pagecache->partitions)
+  {
+    uint i;
+    for (i= 0; i < pagecache->partitions; i++)
+      end_pagecache(pagecache->partition_array + i, cleanup);
+    pagecache->disk_blocks= -1;
+    if (cleanup)
+    {
+      my_free(pagecache->partition_array);
+      pagecache->partition_array= NULL;
+      pagecache->partitions= 0;
+      pagecache->inited= pagecache->can_be_used= 0;
+    }
+    DBUG_VOID_RETURN;
+  }
+
   if (pagecache->disk_blocks > 0)
   {
 #ifndef DBUG_OFF
@@ -3207,6 +3417,7 @@ void pagecache_unlock(PAGECACHE *pagecache,
   PAGECACHE_BLOCK_LINK *block;
   int page_st;
   DBUG_ENTER("pagecache_unlock");
+  pagecache= pagecache_file_partition(pagecache, file);
   DBUG_PRINT("enter", ("fd: %u  page: %lu  %s  %s",
                        (uint) file->file, (ulong) pageno,
                        page_cache_page_lock_str[lock],
@@ -3301,6 +3512,7 @@ void pagecache_unpin(PAGECACHE *pagecache,
   PAGECACHE_BLOCK_LINK *block;
   int page_st;
   DBUG_ENTER("pagecache_unpin");
+  pagecache= pagecache_file_partition(pagecache, file);
   DBUG_PRINT("enter", ("fd: %u  page: %lu",
                        (uint) file->file, (ulong) pageno));
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
@@ -3378,6 +3590,7 @@ void pagecache_unlock_by_link(PAGECACHE *pagecache,
                               my_bool any)
 {
   DBUG_ENTER("pagecache_unlock_by_link");
+  pagecache= pagecache_block_partition(pagecache, block);
   DBUG_PRINT("enter", ("block: %p  fd: %u  page: %lu  changed: %d  %s  %s",
                        block, (uint) block->hash_link->file.file,
                        (ulong) block->hash_link->pageno, was_changed,
@@ -3489,6 +3702,7 @@ void pagecache_unpin_by_link(PAGECACHE *pagecache,
                              LSN lsn)
 {
   DBUG_ENTER("pagecache_unpin_by_link");
+  pagecache= pagecache_block_partition(pagecache, block);
   DBUG_PRINT("enter", ("block: %p  fd: %u page: %lu",
                        block, (uint) block->hash_link->file.file,
                        (ulong) block->hash_link->pageno));
@@ -3728,6 +3942,8 @@ uchar *pagecache_read(PAGECACHE *pagecache,
   DBUG_ASSERT(pageno < ((1ULL) << 40));
 #endif
 
+  pagecache= pagecache_file_partition(pagecache, file);
+
   if (!page_link)
     page_link= &fake_link;
   *page_link= 0;                                 /* Catch errors */
@@ -4079,6 +4295,7 @@ my_bool pagecache_delete_by_link(PAGECACHE *pagecache,
   my_bool error= 0;
   enum pagecache_page_pin pin= PAGECACHE_PIN_LEFT_PINNED;
   DBUG_ENTER("pagecache_delete_by_link");
+  pagecache= pagecache_block_partition(pagecache, block);
   DBUG_PRINT("enter", ("fd: %d block %p  %s  %s",
                        block->hash_link->file.file,
                        block,
@@ -4193,6 +4410,7 @@ my_bool pagecache_delete(PAGECACHE *pagecache,
   my_bool error= 0;
   enum pagecache_page_pin pin= lock_to_pin_one_phase[lock];
   DBUG_ENTER("pagecache_delete");
+  pagecache= pagecache_file_partition(pagecache, file);
   DBUG_PRINT("enter", ("fd: %u  page: %lu  %s  %s",
                        (uint) file->file, (ulong) pageno,
                        page_cache_page_lock_str[lock],
@@ -4389,6 +4607,8 @@ my_bool pagecache_write_part(PAGECACHE *pagecache,
   DBUG_ASSERT(pagecache->big_block_read == 0);
 #endif
 
+  pagecache= pagecache_file_partition(pagecache, file);
+
   if (!page_link)
     page_link= &fake_link;
   *page_link= 0;
@@ -5223,6 +5443,8 @@ int flush_pagecache_blocks_with_filter(PAGECACHE *pagecache,
   DBUG_ENTER("flush_pagecache_blocks_with_filter");
   DBUG_PRINT("enter", ("pagecache: %p", pagecache));
 
+  pagecache= pagecache_file_partition(pagecache, file);
+
   if (pagecache->disk_blocks <= 0)
     DBUG_RETURN(0);
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
@@ -5261,6 +5483,12 @@ int reset_pagecache_counters(const char *name __attribute__((unused)),
   }
   DBUG_PRINT("info", ("Resetting counters for key cache %s.", name));
 
+  if (pagecache->partitions)
+  {
+    uint i;
+    for (i= 0; i < pagecache->partitions; i++)
+      reset_pagecache_counters(name, pagecache->partition_array + i);
+  }
   pagecache->global_blocks_changed= 0;   /* Key_blocks_not_flushed */
   pagecache->global_cache_r_requests= 0; /* Key_read_requests */
   pagecache->global_cache_read= 0;       /* Key_reads */
@@ -5270,43 +5498,66 @@ int reset_pagecache_counters(const char *name __attribute__((unused)),
 }
 
 
-/**
-   @brief Allocates a buffer and stores in it some info about all dirty pages
+/*
+  Get the counters of a page cache
 
-   Does the allocation because the caller cannot know the size itself.
-   Memory freeing is to be done by the caller (if the "str" member of the
-   LEX_STRING is not NULL).
-   Ignores all pages of another type than PAGECACHE_LSN_PAGE, because they
-   are not interesting for a checkpoint record.
-   The caller has the intention of doing checkpoints.
+  SYNOPSIS
+    pagecache_get_stats()
+    pagecache  pointer to the page cache
+    stats      where to store the counters
 
-   @param       pagecache   pointer to the page cache
-   @param[out]  str         pointer to where the allocated buffer, and
-                            its size, will be put
-   @param[out]  min_rec_lsn pointer to where the minimum rec_lsn of all
-                            relevant dirty pages will be put
-   @return Operation status
-     @retval 0      OK
-     @retval 1      Error
+  DESCRIPTION
+    The partitions of a partitioned page cache count their blocks and
+    requests themselves, so the counters of such a page cache are the
+    sums over the partitions. The page cache itself is not changed, so
+    this can be called by several threads at the same time.
+    The values are not read under the partition locks, as for a page
+    cache which is not partitioned.
 */
 
-my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
-                                                  LEX_STRING *str,
-                                                  LSN *min_rec_lsn)
+void pagecache_get_stats(PAGECACHE *pagecache, PAGECACHE_STATS *stats)
 {
-  my_bool error= 0;
-  size_t stored_list_size= 0;
-  uint file_hash;
-  char *ptr;
-  LSN minimum_rec_lsn= LSN_MAX;
-  DBUG_ENTER("pagecache_collect_changed_blocks_with_LSN");
+  PAGECACHE *caches= pagecache;
+  uint cache_count= 1, i;
 
-  DBUG_ASSERT(NULL == str->str);
-  /*
-    We lock the entire cache but will be quick, just reading/writing a few MBs
-    of memory at most.
-  */
-  pagecache_pthread_mutex_lock(&pagecache->cache_lock);
+  if (pagecache->partitions)
+  {
+    caches= pagecache->partition_array;
+    cache_count= pagecache->partitions;
+  }
+  bzero(stats, sizeof(*stats));
+  for (i= 0; i < cache_count; i++)
+  {
+    stats->blocks_used+= caches[i].blocks_used;
+    stats->blocks_unused+= caches[i].blocks_unused;
+    stats->blocks_changed+= caches[i].blocks_changed;
+    stats->global_blocks_changed+= caches[i].global_blocks_changed;
+    stats->global_cache_w_requests+= caches[i].global_cache_w_requests;
+    stats->global_cache_write+= caches[i].global_cache_write;
+    stats->global_cache_r_requests+= caches[i].global_cache_r_requests;
+    stats->global_cache_read+= caches[i].global_cache_read;
+  }
+}
+
+
+/**
+   @brief Waits until no flusher of the page cache hides dirty pages
+
+   Some thread may be flushing a file and have removed dirty blocks from
+   changed_blocks[] while they were still dirty (they were being evicted
+   (=>flushed) by yet another thread, which may not have flushed the block
+   yet so it may still be dirty). If Checkpoint proceeded then, it would
+   not see the page. If there is a crash right after writing the checkpoint
+   record, before the page is flushed, at recovery the page would be
+   wrongly ignored because it won't be in the dirty pages list in the
+   checkpoint record. So wait.
+
+   @param  pagecache   pointer to the page cache, cache_lock is held
+*/
+
+static void wait_for_flushers_in_switch(PAGECACHE *pagecache)
+{
+  uint file_hash;
   for (;;)
   {
     struct st_file_in_flush *other_flusher;
@@ -5318,16 +5569,6 @@ my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
     {}
     if (other_flusher == NULL)
       break;
-    /*
-      other_flusher.first_in_switch is true: some thread is flushing a file
-      and has removed dirty blocks from changed_blocks[] while they were still
-      dirty (they were being evicted (=>flushed) by yet another thread, which
-      may not have flushed the block yet so it may still be dirty).
-      If Checkpoint proceeds now, it will not see the page. If there is a
-      crash right after writing the checkpoint record, before the page is
-      flushed, at recovery the page will be wrongly ignored because it won't
-      be in the dirty pages list in the checkpoint record. So wait.
-    */
     {
       struct st_my_thread_var *thread= my_thread_var;
       wqueue_add_to_queue(&other_flusher->flush_queue, thread);
@@ -5342,8 +5583,19 @@ my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
       while (thread->next);
     }
   }
+}
 
-  /* Count how many dirty pages are interesting */
+
+/**
+   @brief Counts the dirty pages of a page cache a checkpoint must store
+
+   @param  pagecache   pointer to the page cache, cache_lock is held
+*/
+
+static size_t count_changed_lsn_blocks(PAGECACHE *pagecache)
+{
+  size_t stored_list_size= 0;
+  uint file_hash;
   for (file_hash= 0; file_hash < pagecache->changed_blocks_hash_size; file_hash++)
   {
     PAGECACHE_BLOCK_LINK *block;
@@ -5367,22 +5619,25 @@ my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
       stored_list_size++;
     }
   }
+  return stored_list_size;
+}
 
-  compile_time_assert(sizeof(pagecache->blocks) <= 8);
-  str->length= 8 + /* number of dirty pages */
-    (2 + /* table id */
-     1 + /* data or index file */
-     5 + /* pageno */
-     LSN_STORE_SIZE /* rec_lsn */
-     ) * stored_list_size;
-  if (NULL == (str->str= my_malloc(PSI_INSTRUMENT_ME, str->length, MYF(MY_WME))))
-    goto err;
-  ptr= str->str;
-  int8store(ptr, (ulonglong)stored_list_size);
-  ptr+= 8;
-  DBUG_PRINT("info", ("found %zu dirty pages", stored_list_size));
-  if (stored_list_size == 0)
-    goto end;
+
+/**
+   @brief Stores the dirty pages counted by count_changed_lsn_blocks()
+
+   @param  pagecache       pointer to the page cache, cache_lock is held
+   @param  ptr             where to store the pages
+   @param  minimum_rec_lsn minimum rec_lsn of the pages stored so far,
+                           updated
+
+   @return the end of the stored pages
+*/
+
+static char *store_changed_lsn_blocks(PAGECACHE *pagecache, char *ptr,
+                                      LSN *minimum_rec_lsn)
+{
+  uint file_hash;
   for (file_hash= 0; file_hash < pagecache->changed_blocks_hash_size; file_hash++)
   {
     PAGECACHE_BLOCK_LINK *block;
@@ -5408,13 +5663,94 @@ my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
       if (block->rec_lsn != LSN_MAX)
       {
         DBUG_ASSERT(LSN_VALID(block->rec_lsn));
-        if (cmp_translog_addr(block->rec_lsn, minimum_rec_lsn) < 0)
-          minimum_rec_lsn= block->rec_lsn;
+        if (cmp_translog_addr(block->rec_lsn, *minimum_rec_lsn) < 0)
+          *minimum_rec_lsn= block->rec_lsn;
       } /* otherwise, some trn->rec_lsn should hold the correct info */
     }
   }
+  return ptr;
+}
+
+
+/**
+   @brief Allocates a buffer and stores in it some info about all dirty pages
+
+   Does the allocation because the caller cannot know the size itself.
+   Memory freeing is to be done by the caller (if the "str" member of the
+   LEX_STRING is not NULL).
+   Ignores all pages of another type than PAGECACHE_LSN_PAGE, because they
+   are not interesting for a checkpoint record.
+   The caller has the intention of doing checkpoints.
+
+   @param       pagecache   pointer to the page cache
+   @param[out]  str         pointer to where the allocated buffer, and
+                            its size, will be put
+   @param[out]  min_rec_lsn pointer to where the minimum rec_lsn of all
+                            relevant dirty pages will be put
+   @return Operation status
+     @retval 0      OK
+     @retval 1      Error
+*/
+
+my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
+                                                  LEX_STRING *str,
+                                                  LSN *min_rec_lsn)
+{
+  my_bool error= 0;
+  size_t stored_list_size= 0;
+  PAGECACHE *caches;
+  uint cache_count, i;
+  char *ptr;
+  LSN minimum_rec_lsn= LSN_MAX;
+  DBUG_ENTER("pagecache_collect_changed_blocks_with_LSN");
+
+  DBUG_ASSERT(NULL == str->str);
+  if (pagecache->partitions)
+  {
+    caches= pagecache->partition_array;
+    cache_count= pagecache->partitions;
+  }
+  else
+  {
+    caches= pagecache;
+    cache_count= 1;
+  }
+  /*
+    We lock the entire cache (all the partitions, in order) but will be
+    quick, just reading/writing a few MBs of memory at most.
+    A file is flushed within one partition only, so waiting for the flushers
+    of a partition does not need the locks of the others.
+  */
+  for (i= 0; i < cache_count; i++)
+  {
+    pagecache_pthread_mutex_lock(&caches[i].cache_lock);
+    wait_for_flushers_in_switch(caches + i);
+  }
+
+  /* Count how many dirty pages are interesting */
+  for (i= 0; i < cache_count; i++)
+    stored_list_size+= count_changed_lsn_blocks(caches + i);
+
+  compile_time_assert(sizeof(pagecache->blocks) <= 8);
+  str->length= 8 + /* number of dirty pages */
+    (2 + /* table id */
+     1 + /* data or index file */
+     5 + /* pageno */
+     LSN_STORE_SIZE /* rec_lsn */
+     ) * stored_list_size;
+  if (NULL == (str->str= my_malloc(PSI_INSTRUMENT_ME, str->length, MYF(MY_WME))))
+    goto err;
+  ptr= str->str;
+  int8store(ptr, (ulonglong)stored_list_size);
+  ptr+= 8;
+  DBUG_PRINT("info", ("found %zu dirty pages", stored_list_size));
+  if (stored_list_size == 0)
+    goto end;
+  for (i= 0; i < cache_count; i++)
+    ptr= store_changed_lsn_blocks(caches + i, ptr, &minimum_rec_lsn);
 end:
-  pagecache_pthread_mutex_unlock(&pagecache->cache_lock);
+  for (i= cache_count; i-- > 0; )
+    pagecache_pthread_mutex_unlock(&caches[i].cache_lock);
   *min_rec_lsn= minimum_rec_lsn;
   DBUG_RETURN(error);
 
@@ -5434,6 +5770,7 @@ void pagecache_file_no_dirty_page(PAGECACHE *pagecache, PAGECACHE_FILE *file)
 {
   File fd= file->file;
   PAGECACHE_BLOCK_LINK *block;
+  pagecache= pagecache_file_partition(pagecache, file);
   for (block= pagecache->changed_blocks[FILE_HASH(*file, pagecache)];
        block != NULL;
        block= block->next_changed)
@@ -191,6 +191,13 @@ typedef struct st_pagecache
                             struct st_pagecache_file *file, S3_BLOCK *data);
   void (*big_block_free)(S3_BLOCK *data);
 
+  /*
+    A partitioned page cache only dispatches the requests to one of its
+    partitions, which are complete page caches with their own cache_lock.
+    All pages of a file are kept in the same partition.
+  */
+  struct st_pagecache *partition_array;
+  uint partitions;               /* 0 if the cache is not partitioned       */
 
   /*
     The following variables are and variables used to hold parameters for
@@ -220,6 +227,19 @@ typedef struct st_pagecache
   HASH    files_in_flush;       /**< files in flush_pagecache_blocks_int() */
 } PAGECACHE;
 
+/* The counters of a page cache, see pagecache_get_stats() */
+typedef struct st_pagecache_stats
+{
+  size_t blocks_used;
+  size_t blocks_unused;
+  size_t blocks_changed;
+  size_t global_blocks_changed;
+  ulonglong global_cache_w_requests;
+  ulonglong global_cache_write;
+  ulonglong global_cache_r_requests;
+  ulonglong global_cache_read;
+} PAGECACHE_STATS;
+
 /** @brief Return values for PAGECACHE_FLUSH_FILTER */
 enum pagecache_flush_filter_result
 {
@@ -240,6 +260,16 @@ extern size_t init_pagecache(PAGECACHE *pagecache, size_t use_mem,
                             uint division_limit, uint age_threshold,
                             uint block_size, uint changed_blocks_hash_size,
                             myf my_read_flags)__attribute__((visibility("default"))) ;
+extern size_t init_partitioned_pagecache(PAGECACHE *pagecache,
+                                         uint partitions, size_t use_mem,
+                                         uint division_limit,
+                                         uint age_threshold,
+                                         uint block_size,
+                                         uint changed_blocks_hash_size,
+                                         myf my_read_flags);
+extern PAGECACHE *pagecache_file_partition(PAGECACHE *pagecache,
+                                           PAGECACHE_FILE *file);
+extern void pagecache_set_partition_params(PAGECACHE *pagecache);
 extern size_t resize_pagecache(PAGECACHE *pagecache,
                               size_t use_mem, uint division_limit,
                               uint age_threshold, uint changed_blocks_hash_size);
@@ -340,6 +370,7 @@ extern my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
                                                          LEX_STRING *str,
                                                          LSN *min_lsn);
 extern int reset_pagecache_counters(const char *name, PAGECACHE *pagecache);
+extern void pagecache_get_stats(PAGECACHE *pagecache, PAGECACHE_STATS *stats);
 extern uchar *pagecache_block_link_to_buffer(PAGECACHE_BLOCK_LINK *block);
 
 extern uint pagecache_pagelevel(PAGECACHE_BLOCK_LINK *block);
@@ -0,0 +1,514 @@
+/* Copyright (C) 2026 MariaDB Corporation Ab
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/*
+  Row locks for UPDATE of BLOCK_RECORD tables
+
+  When aria_row_locking is set, ha_maria::store_lock() lets several
+  UPDATE statements on the same versioned table run at the same time
+  (TL_WRITE_ALLOW_WRITE) and serializes them on rows instead:
+
+  - Every row read by such a statement is locked by its position.
+    The lock is owned by the transaction (TrID) and kept until
+    ma_commit(), or until handler::unlock_row() for rows that did not
+    match the WHERE clause. A thread that finds a row locked by another
+    transaction waits for it with the waiting threads graph, the same
+    way ma_write.c waits for a conflicting unique key.
+
+  - A row can be changed in place while others hold row locks, as long
+    as only its head page changes. An update that changes a key or
+    needs other pages (tails, extents, a new head) first makes the
+    transaction exclusive owner of the table: it waits until all other
+    row locks are gone and all other readers and writers are either
+    waiting or done, and it blocks new ones until it commits. Key trees
+    and the bitmap are thus still only changed by one thread at a time.
+
+  - Readers and TL_READ_NO_INSERT readers (like CHECK TABLE) register
+    in a gate in external_lock(), which lets the exclusive owner wait for
+    them. TL_READ_NO_INSERT readers exclude row lock writers completely.
+
+  Aria can't roll back a statement (MARIA_CANNOT_ROLLBACK), so plain
+  readers may see rows changed by an update that is not yet committed,
+  as they can with concurrent inserts.
+*/
+
+#include "maria_def.h"
+#include "trnman.h"
+#include "ma_trnman.h"
+
+void _ma_row_lock_init(MARIA_SHARE *share)
+{
+  mysql_mutex_init(key_SHARE_row_lock_mutex, &share->row_lock_mutex,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_SHARE_row_lock_cond, &share->row_lock_cond, 0);
+}
+
+
+void _ma_row_lock_destroy(MARIA_SHARE *share)
+{
+  my_hash_free(&share->row_locks);
+  mysql_mutex_destroy(&share->row_lock_mutex);
+  mysql_cond_destroy(&share->row_lock_cond);
+}
+
+
+/**
+   Return the transaction that blocks trid from locking row pos
+
+   @note pos may be HA_OFFSET_ERROR to only check the exclusive owner.
+   share->row_lock_mutex must be locked.
+
+   @return TrID of the blocker, 0 if none
+*/
+
+static TrID row_lock_owner(MARIA_SHARE *share, MARIA_RECORD_POS pos,
+                           TrID trid)
+{
+  MARIA_ROW_LOCK *lock;
+  mysql_mutex_assert_owner(&share->row_lock_mutex);
+
+  if (share->row_lock_exclusive && share->row_lock_exclusive != trid)
+    return share->row_lock_exclusive;
+  if (pos != HA_OFFSET_ERROR && my_hash_inited(&share->row_locks) &&
+      (lock= (MARIA_ROW_LOCK*) my_hash_search(&share->row_locks,
+                                              (uchar*) &pos, sizeof(pos))) &&
+      lock->trid != trid)
+    return lock->trid;
+  return 0;
+}
+
+
+/**
+   Return a row lock held by another transaction than trid
+
+   @note share->row_lock_mutex must be locked.
+*/
+
+static MARIA_ROW_LOCK *foreign_row_lock(MARIA_SHARE *share, TrID trid)
+{
+  ulong i;
+  mysql_mutex_assert_owner(&share->row_lock_mutex);
+
+  if (!my_hash_inited(&share->row_locks))
+    return 0;
+  for (i= 0 ; i < share->row_locks.records ; i++)
+  {
+    MARIA_ROW_LOCK *lock= (MARIA_ROW_LOCK*) my_hash_element(&share->row_locks,
+                                                           i);
+    if (lock->trid != trid)
+      return lock;
+  }
+  return 0;
+}
+
+
+/**
+   Wait until the transaction blocker_trid has released the lock on pos
+
+   @note Called without locks. blocker->state_lock is taken before
+   share->row_lock_mutex, as in _ma_row_unlock().
+
+   @return 0 ok (retry the lock), # error
+*/
+
+static int row_lock_wait(MARIA_HA *info, MARIA_RECORD_POS pos,
+                         TrID blocker_trid)
+{
+  MARIA_SHARE *share= info->s;
+  TRN *blocker;
+  WT_RESOURCE_ID rc;
+  PSI_stage_info old_stage_info;
+  int res;
+  DBUG_ENTER("row_lock_wait");
+  DBUG_PRINT("enter", ("pos: %lu  blocker: %lu", (ulong) pos,
+                       (ulong) blocker_trid));
+
+  if (!info->trn->wt)
+    DBUG_RETURN(my_errno= HA_ERR_LOCK_WAIT_TIMEOUT);
+  if (!(blocker= trnman_trid_to_trn(info->trn, blocker_trid)))
+    DBUG_RETURN(0);                             /* Committed */
+
+  /*
+    The blocker releases its locks under its state_lock, so no release
+    can be missed between this check and the wait below.
+  */
+  mysql_mutex_lock(&share->row_lock_mutex);
+  if (blocker->commit_trid != ~(TrID)0 || !blocker->wt ||
+      row_lock_owner(share, pos, info->trn->trid) != blocker_trid)
+  {
+    mysql_mutex_unlock(&share->row_lock_mutex);
+    mysql_mutex_unlock(&blocker->state_lock);
+    DBUG_RETURN(0);
+  }
+  mysql_mutex_unlock(&share->row_lock_mutex);
+
+  rc.type= &ma_rc_dup_unique;
+  rc.value= (intptr)blocker;
+  res= wt_thd_will_wait_for(info->trn->wt, blocker->wt, & rc);
+  if (res != WT_OK)
+  {
+    mysql_mutex_unlock(& blocker->state_lock);
+    DBUG_RETURN(my_errno= HA_ERR_LOCK_DEADLOCK);
+  }
+  proc_info_hook(0, &stage_waiting_for_a_resource, &old_stage_info,
+                 __func__, __FILE__, __LINE__);
+  res= wt_thd_cond_timedwait(info->trn->wt, & blocker->state_lock);
+  proc_info_hook(0, &old_stage_info, 0, __func__, __FILE__, __LINE__);
+  mysql_mutex_unlock(& blocker->state_lock);
+  if (res != WT_OK)
+    DBUG_RETURN(my_errno= (res == WT_TIMEOUT ? HA_ERR_LOCK_WAIT_TIMEOUT :
+                           HA_ERR_LOCK_DEADLOCK));
+  DBUG_RETURN(0);
+}
+
+
+/**
+   Wake up the threads waiting for a lock of our transaction
+
+   @note Called when locks are released before the transaction ends.
+   Waiters are otherwise woken up by trnman_end_trn().
+*/
+
+static void row_lock_wake_waiters(TRN *trn)
+{
+  WT_RESOURCE_ID rc;
+  if (!trn->wt)
+    return;
+  mysql_mutex_assert_owner(&trn->state_lock);
+  rc.type= &ma_rc_dup_unique;
+  rc.value= (intptr)trn;
+  wt_thd_release(trn->wt, &rc);
+}
+
+
+/**
+   Register a table instance as a user of row locks
+
+   @param user     MARIA_ROW_LOCK_READER, MARIA_ROW_LOCK_STRONG_READER or
+                   MARIA_ROW_LOCK_WRITER
+   @param timeout  Max seconds to wait for an exclusive owner
+
+   @note Called from external_lock(), before the transaction of the
+   table instance is known.
+
+   @return 0 ok, # error
+*/
+
+int _ma_row_lock_enter(MARIA_HA *info, uint user, ulong timeout)
+{
+  MARIA_SHARE *share= info->s;
+  struct timespec abstime;
+  int error= 0;
+  DBUG_ENTER("_ma_row_lock_enter");
+  DBUG_PRINT("enter", ("user: %u", user));
+
+  if (info->row_lock_user)
+    DBUG_RETURN(0);                             /* Already registered */
+
+  set_timespec(abstime, timeout);
+  mysql_mutex_lock(&share->row_lock_mutex);
+  while (share->row_lock_exclusive ||
+         (user == MARIA_ROW_LOCK_STRONG_READER && share->row_lock_writers) ||
+         (user == MARIA_ROW_LOCK_WRITER && share->row_lock_strong_readers))
+  {
+    if (mysql_cond_timedwait(&share->row_lock_cond, &share->row_lock_mutex,
+                             &abstime) == ETIMEDOUT)
+    {
+      error= my_errno= HA_ERR_LOCK_WAIT_TIMEOUT;
+      goto end;
+    }
+  }
+  switch (user) {
+  case MARIA_ROW_LOCK_READER:        share->row_lock_readers++; break;
+  case MARIA_ROW_LOCK_STRONG_READER: share->row_lock_strong_readers++; break;
+  case MARIA_ROW_LOCK_WRITER:        share->row_lock_writers++; break;
+  }
+  info->row_lock_user= (uint8) user;
+  info->row_lock_timeout= timeout;
+
+end:
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  DBUG_RETURN(error);
+}
+
+
+/**
+   Unregister a table instance registered by _ma_row_lock_enter()
+
+   @note The row locks stay until the transaction ends
+*/
+
+void _ma_row_lock_leave(MARIA_HA *info)
+{
+  MARIA_SHARE *share= info->s;
+  DBUG_ENTER("_ma_row_lock_leave");
+
+  if (!info->row_lock_user)
+    DBUG_VOID_RETURN;
+  mysql_mutex_lock(&share->row_lock_mutex);
+  switch (info->row_lock_user) {
+  case MARIA_ROW_LOCK_READER:        share->row_lock_readers--; break;
+  case MARIA_ROW_LOCK_STRONG_READER: share->row_lock_strong_readers--; break;
+  case MARIA_ROW_LOCK_WRITER:        share->row_lock_writers--; break;
+  }
+  info->row_lock_user= 0;
+  mysql_cond_broadcast(&share->row_lock_cond);
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+   Lock a row for the transaction of the table instance
+
+   @param pos     Row position
+   @param waited  Set to 1 if we had to wait. The row must then be read
+                  again as it may have been changed.
+
+   @return 0 ok, # error (also in my_errno)
+*/
+
+int _ma_row_lock(MARIA_HA *info, MARIA_RECORD_POS pos, my_bool *waited)
+{
+  MARIA_SHARE *share= info->s;
+  TrID trid= info->trn->trid, blocker;
+  MARIA_ROW_LOCK *lock;
+  my_bool counted= 0;
+  int error= 0;
+  DBUG_ENTER("_ma_row_lock");
+  DBUG_PRINT("enter", ("pos: %lu", (ulong) pos));
+
+  *waited= 0;
+  info->row_lock_new= 0;
+  mysql_mutex_lock(&share->row_lock_mutex);
+  while ((blocker= row_lock_owner(share, pos, trid)))
+  {
+    if (!counted)
+    {
+      /* Let an exclusive owner know that we don't touch the table */
+      counted= 1;
+      share->row_lock_waiters++;
+      mysql_cond_broadcast(&share->row_lock_cond);
+    }
+    *waited= 1;
+    mysql_mutex_unlock(&share->row_lock_mutex);
+    error= row_lock_wait(info, pos, blocker);
+    mysql_mutex_lock(&share->row_lock_mutex);
+    if (error)
+      goto end;
+  }
+
+  if (my_hash_init_opt(PSI_INSTRUMENT_ME, &share->row_locks, &my_charset_bin,
+                       64, offsetof(MARIA_ROW_LOCK, pos),
+                       sizeof(MARIA_RECORD_POS), 0, my_free, HASH_UNIQUE))
+  {
+    error= my_errno= HA_ERR_OUT_OF_MEM;
+    goto end;
+  }
+  if (!my_hash_search(&share->row_locks, (uchar*) &pos, sizeof(pos)))
+  {
+    if (!(lock= (MARIA_ROW_LOCK*) my_malloc(PSI_INSTRUMENT_ME, sizeof(*lock),
+                                            MYF(MY_WME))))
+    {
+      error= my_errno= HA_ERR_OUT_OF_MEM;
+      goto end;
+    }
+    lock->pos= pos;
+    lock->trid= trid;
+    if (my_hash_insert(&share->row_locks, (uchar*) lock))
+    {
+      my_free(lock);
+      error= my_errno= HA_ERR_OUT_OF_MEM;
+      goto end;
+    }
+    lock->next= info->used_tables->row_locks;
+    info->used_tables->row_locks= lock;
+    info->row_lock_new= 1;
+  }
+
+end:
+  if (counted)
+    share->row_lock_waiters--;
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  DBUG_RETURN(error);
+}
+
+
+/**
+   Release the lock of a row that was not changed
+
+   @note Only the last lock taken by _ma_row_lock() can be released, and
+   only if the transaction did not have it before.
+*/
+
+void _ma_row_unlock(MARIA_HA *info, MARIA_RECORD_POS pos)
+{
+  MARIA_SHARE *share= info->s;
+  MARIA_ROW_LOCK *lock= info->used_tables->row_locks;
+  DBUG_ENTER("_ma_row_unlock");
+
+  if (!info->row_lock_new || !lock || lock->pos != pos)
+    DBUG_VOID_RETURN;
+  info->row_lock_new= 0;
+
+  mysql_mutex_lock(&info->trn->state_lock);
+  mysql_mutex_lock(&share->row_lock_mutex);
+  info->used_tables->row_locks= lock->next;
+  my_hash_delete(&share->row_locks, (uchar*) lock);
+  if (share->row_lock_waiters)
+    row_lock_wake_waiters(info->trn);
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  mysql_mutex_unlock(&info->trn->state_lock);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+   Make the transaction the only one that uses the table
+
+   @notes
+   Other transactions that want a row lock wait for us until we commit.
+   We wait until all row locks of other transactions are released and
+   until all other table instances either wait or are unlocked.
+
+   @return 0 ok, # error (also in my_errno)
+*/
+
+int _ma_row_lock_exclusive(MARIA_HA *info)
+{
+  MARIA_SHARE *share= info->s;
+  TRN *trn= info->trn;
+  TrID trid= trn->trid, blocker;
+  MARIA_HA *tbl;
+  MARIA_ROW_LOCK *lock;
+  struct timespec abstime;
+  PSI_stage_info old_stage_info;
+  uint own_writers= 0, own_readers= 0;
+  int error= 0;
+  DBUG_ENTER("_ma_row_lock_exclusive");
+
+  mysql_mutex_lock(&share->row_lock_mutex);
+  if (share->row_lock_exclusive == trid)
+    goto end;
+
+  /* Wait for another exclusive owner */
+  share->row_lock_waiters++;
+  mysql_cond_broadcast(&share->row_lock_cond);
+  while ((blocker= row_lock_owner(share, HA_OFFSET_ERROR, trid)))
+  {
+    mysql_mutex_unlock(&share->row_lock_mutex);
+    error= row_lock_wait(info, HA_OFFSET_ERROR, blocker);
+    mysql_mutex_lock(&share->row_lock_mutex);
+    if (error)
+    {
+      share->row_lock_waiters--;
+      goto end;
+    }
+  }
+  share->row_lock_waiters--;
+  share->row_lock_exclusive= trid;
+
+  /* Wait for the row locks of other transactions */
+  while ((lock= foreign_row_lock(share, trid)))
+  {
+    MARIA_RECORD_POS pos= lock->pos;
+    blocker= lock->trid;
+    mysql_mutex_unlock(&share->row_lock_mutex);
+    error= row_lock_wait(info, pos, blocker);
+    mysql_mutex_lock(&share->row_lock_mutex);
+    if (error)
+      goto err;
+  }
+
+  /* Wait for the table instances that don't wait for a lock */
+  for (tbl= (MARIA_HA*) trn->used_instances ; tbl ; tbl= tbl->trn_next)
+  {
+    if (tbl->s != share)
+      continue;
+    if (tbl->row_lock_user == MARIA_ROW_LOCK_WRITER)
+      own_writers++;
+    else if (tbl->row_lock_user)
+      own_readers++;
+  }
+  set_timespec(abstime, info->row_lock_timeout);
+  proc_info_hook(0, &stage_waiting_for_a_resource, &old_stage_info,
+                 __func__, __FILE__, __LINE__);
+  while (share->row_lock_writers - share->row_lock_waiters > own_writers ||
+         share->row_lock_readers + share->row_lock_strong_readers >
+         own_readers)
+  {
+    if (mysql_cond_timedwait(&share->row_lock_cond, &share->row_lock_mutex,
+                             &abstime) == ETIMEDOUT)
+    {
+      error= my_errno= HA_ERR_LOCK_WAIT_TIMEOUT;
+      break;
+    }
+  }
+  proc_info_hook(0, &old_stage_info, 0, __func__, __FILE__, __LINE__);
+  if (!error)
+    goto end;
+
+err:
+  share->row_lock_exclusive= 0;
+  mysql_cond_broadcast(&share->row_lock_cond);
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  mysql_mutex_lock(&trn->state_lock);
+  row_lock_wake_waiters(trn);
+  mysql_mutex_unlock(&trn->state_lock);
+  DBUG_RETURN(error);
+
+end:
+  mysql_mutex_unlock(&share->row_lock_mutex);
+  DBUG_RETURN(error);
+}
+
+
+/**
+   Release all row locks of a transaction
+
+   @note Called at commit, before the transaction ends. The threads that
+   wait for our locks are woken up by trnman_end_trn().
+*/
+
+void _ma_row_locks_release(TRN *trn)
+{
+  MARIA_USED_TABLES *tables;
+  DBUG_ENTER("_ma_row_locks_release");
+
+  for (tables= (MARIA_USED_TABLES*) trn->used_tables;
+       tables;
+       tables= tables->next)
+  {
+    MARIA_SHARE *share= tables->share;
+    MARIA_ROW_LOCK *lock, *next;
+    if (!tables->row_locks && share->row_lock_exclusive != trn->trid)
+      continue;
+
+    mysql_mutex_lock(&share->row_lock_mutex);
+    for (lock= tables->row_locks; lock; lock= next)
+    {
+      next= lock->next;
+      my_hash_delete(&share->row_locks, (uchar*) lock);
+    }
+    tables->row_locks= 0;
+    if (share->row_lock_exclusive == trn->trid)
+    {
+      share->row_lock_exclusive= 0;
+      mysql_cond_broadcast(&share->row_lock_cond);
+    }
+    mysql_mutex_unlock(&share->row_lock_mutex);
+  }
+  DBUG_VOID_RETURN;
+}
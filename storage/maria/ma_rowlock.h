@@ -0,0 +1,41 @@
+/* Copyright (C) 2026 MariaDB Corporation Ab
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/* Row locks for UPDATE on BLOCK_RECORD tables, see ma_rowlock.c */
+
+C_MODE_START
+
+typedef struct st_maria_row_lock
+{
+  struct st_maria_row_lock *next;       /* Next lock of the transaction */
+  MARIA_RECORD_POS pos;
+  TrID trid;                            /* Owner */
+} MARIA_ROW_LOCK;
+
+/* How a table instance takes part in row locking (MARIA_HA::row_lock_user) */
+#define MARIA_ROW_LOCK_READER         1
+#define MARIA_ROW_LOCK_STRONG_READER  2
+#define MARIA_ROW_LOCK_WRITER         3
+
+void _ma_row_lock_init(MARIA_SHARE *share);
+void _ma_row_lock_destroy(MARIA_SHARE *share);
+int _ma_row_lock_enter(MARIA_HA *info, uint user, ulong timeout);
+void _ma_row_lock_leave(MARIA_HA *info);
+int _ma_row_lock(MARIA_HA *info, MARIA_RECORD_POS pos, my_bool *waited);
+void _ma_row_unlock(MARIA_HA *info, MARIA_RECORD_POS pos);
+int _ma_row_lock_exclusive(MARIA_HA *info);
+void _ma_row_locks_release(TRN *trn);
+
+C_MODE_END
@@ -458,6 +458,9 @@ my_bool _ma_trnman_end_trans_hook(TRN *trn, my_bool commit,
   DBUG_ENTER("_ma_trnman_end_trans_hook");
   DBUG_PRINT("enter", ("trn: %p  used_tables: %p", trn, trn->used_tables));
 
+  /* In case the transaction did not end through ma_commit() */
+  _ma_row_locks_release(trn);
+
   for (tables= (MARIA_USED_TABLES*) trn->used_tables;
        tables;
        tables= next)
@@ -38,6 +38,7 @@ typedef struct st_used_tables {
   struct st_maria_share *share;
   MARIA_STATUS_INFO state_current;
   MARIA_STATUS_INFO state_start;
+  struct st_maria_row_lock *row_locks;  /* Row locks taken in the table */
   uint use_count;
 } MARIA_USED_TABLES;
 
@@ -126,11 +126,13 @@ PSI_mutex_key key_SHARE_BITMAP_lock, key_SORT_INFO_mutex,
               key_TRANSLOG_DESCRIPTOR_unfinished_files_lock,
               key_TRANSLOG_DESCRIPTOR_purger_lock,
               key_SHARE_intern_lock, key_SHARE_key_del_lock,
-              key_SHARE_close_lock, key_PAGECACHE_cache_lock,
+              key_SHARE_close_lock, key_SHARE_row_lock_mutex,
+              key_PAGECACHE_cache_lock,
               key_SERVICE_THREAD_CONTROL_lock,
               key_LOCK_trn_list, key_TRN_state_lock;
 
-PSI_cond_key key_SHARE_key_del_cond, key_SERVICE_THREAD_CONTROL_cond,
+PSI_cond_key key_SHARE_key_del_cond, key_SHARE_row_lock_cond,
+             key_SERVICE_THREAD_CONTROL_cond,
              key_SORT_INFO_cond, key_SHARE_BITMAP_cond,
              key_COND_soft_sync, key_TRANSLOG_BUFFER_waiting_filling_buffer,
              key_TRANSLOG_BUFFER_prev_sent_to_disk_cond,
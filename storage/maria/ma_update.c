@@ -95,6 +95,9 @@ int maria_update(register MARIA_HA *info, const uchar *oldrec,
       {
 	if (_ma_ft_cmp(info,i,oldrec, newrec))
 	{
+          /* Other UPDATE statements must not use the key trees now */
+          if (info->row_locking && _ma_row_lock_exclusive(info))
+            goto err;
 	  if ((int) i == info->lastinx)
 	  {
 	  /*
@@ -124,6 +127,8 @@ int maria_update(register MARIA_HA *info, const uchar *oldrec,
 	if (new_key.data_length != old_key.data_length ||
 	    memcmp(old_key.data, new_key.data, new_key.data_length))
 	{
+          if (info->row_locking && _ma_row_lock_exclusive(info))
+            goto err;
 	  if ((int) i == info->lastinx)
 	    key_changed|=HA_STATE_WRITTEN;	/* Mark that keyfile changed */
 	  changed|=((ulonglong) 1 << i);
@@ -158,7 +163,13 @@ int maria_update(register MARIA_HA *info, const uchar *oldrec,
   }
 
   if ((*share->update_record)(info, pos, oldrec, newrec))
+  {
+    /* The row was not changed if we could not get the table for us */
+    if (share->calc_checksum && (my_errno == HA_ERR_LOCK_WAIT_TIMEOUT ||
+                                 my_errno == HA_ERR_LOCK_DEADLOCK))
+      info->state->checksum-= info->cur_row.checksum - info->new_row.checksum;
     goto err;
+  }
 
   if (auto_key_changed & !share->now_transactional)
   {
@@ -204,7 +215,8 @@ int maria_update(register MARIA_HA *info, const uchar *oldrec,
     save_errno= HA_ERR_INTERNAL_ERROR;          /* Should never happen */
 
   if (my_errno == HA_ERR_FOUND_DUPP_KEY || my_errno == HA_ERR_OUT_OF_MEM ||
-      my_errno == HA_ERR_RECORD_FILE_FULL)
+      my_errno == HA_ERR_RECORD_FILE_FULL ||
+      my_errno == HA_ERR_LOCK_WAIT_TIMEOUT || my_errno == HA_ERR_LOCK_DEADLOCK)
   {
     info->errkey= (int) i;
     flag=0;
@@ -524,6 +524,9 @@ typedef struct st_maria_state_info
 #define HA_KEYSEG_SIZE		(6+ 2*2 + 4*2)
 #define MARIA_COLUMNDEF_SIZE	(2*7+1+1+4)
 #define MARIA_BASE_INFO_SIZE	(MY_UUID_SIZE + 5*8 + 6*4 + 11*2 + 6 + 5*2 + 1 + 16)
+/* Positions in MARIA_BASE_INFO changed for S3, see _ma_base_info_write() */
+#define MARIA_BASE_INFO_COMPRESSION_POS (MY_UUID_SIZE + 5*8 + 6*4 + 11*2 + 5)
+#define MARIA_BASE_INFO_S3_BLOCK_SIZE_POS (MY_UUID_SIZE + 5*8 + 6*4 + 11*2 + 6 + 5*2 + 1)
 #define MARIA_INDEX_BLOCK_MARGIN 16	/* Safety margin for .MYI tables */
 #define MARIA_MAX_POINTER_LENGTH 7	/* Node pointer */
 /* Internal management bytes needed to store 2 transid/key on an index page */
@@ -820,6 +823,13 @@ typedef struct st_maria_share
     intern_lock, lock them in this order.
   */
   mysql_mutex_t close_lock;
+  /* Row locks of UPDATE with aria_row_locking, see ma_rowlock.c */
+  mysql_mutex_t row_lock_mutex;
+  mysql_cond_t row_lock_cond;
+  HASH row_locks;                       /* MARIA_ROW_LOCK by position */
+  TrID row_lock_exclusive;              /* Trn that may change the trees */
+  uint row_lock_writers, row_lock_waiters;
+  uint row_lock_readers, row_lock_strong_readers;
   my_off_t mmaped_length;
   uint nonmmaped_inserts;		/* counter of writing in
 						   non-mmaped area */
@@ -913,6 +923,7 @@ struct st_maria_handler
   MARIA_STATUS_INFO *state_start;       /* State at start of transaction */
   MARIA_USED_TABLES *used_tables;
   struct ms3_st *s3;
+  struct st_s3_read_ahead *s3_read_ahead; /* Set during S3 table scans */
   void **stack_end_ptr;
   MARIA_ROW cur_row;                    /* The active row that we just read */
   MARIA_ROW new_row;			/* Storage for a row during update */
@@ -1020,6 +1031,10 @@ struct st_maria_handler
   my_bool create_unique_index_by_sort;
   index_cond_func_t index_cond_func;   /* Index condition function */
   void *index_cond_func_arg;           /* parameter for the func */
+  ulong row_lock_timeout;               /* Seconds, for _ma_row_lock_*() */
+  uint8 row_lock_user;                  /* MARIA_ROW_LOCK_READER... */
+  my_bool row_locking;                  /* Lock rows read for update */
+  my_bool row_lock_new;                 /* Last _ma_row_lock() got a lock */
 };
 
 /* Table options for the Aria and S3 storage engine */
@@ -1262,13 +1277,14 @@ extern PSI_mutex_key key_SHARE_BITMAP_lock, key_SORT_INFO_mutex,
                      key_TRANSLOG_DESCRIPTOR_unfinished_files_lock,
                      key_TRANSLOG_DESCRIPTOR_purger_lock,
                      key_SHARE_intern_lock, key_SHARE_key_del_lock,
-                     key_SHARE_close_lock,
+                     key_SHARE_close_lock, key_SHARE_row_lock_mutex,
                      key_SERVICE_THREAD_CONTROL_lock,
                      key_PAGECACHE_cache_lock;
 
 extern PSI_mutex_key key_CRYPT_DATA_lock;
 
-extern PSI_cond_key key_SHARE_key_del_cond, key_SERVICE_THREAD_CONTROL_cond,
+extern PSI_cond_key key_SHARE_key_del_cond, key_SHARE_row_lock_cond,
+                    key_SERVICE_THREAD_CONTROL_cond,
                     key_SORT_INFO_cond, key_SHARE_BITMAP_cond,
                     key_COND_soft_sync, key_TRANSLOG_BUFFER_waiting_filling_buffer,
                     key_TRANSLOG_BUFFER_prev_sent_to_disk_cond,
@@ -1653,6 +1669,7 @@ int _ma_def_scan_remember_pos(MARIA_HA *info, MARIA_RECORD_POS *lastpos);
 int _ma_def_scan_restore_pos(MARIA_HA *info, MARIA_RECORD_POS lastpos);
 
 #include "ma_commit.h"
+#include "ma_rowlock.h"
 
 extern MARIA_HA *_ma_test_if_reopen(const char *filename);
 my_bool _ma_check_table_is_closed(const char *name, const char *where);
@@ -23,6 +23,7 @@
 #include <mysqld_error.h>
 #include <sql_const.h>
 #include <mysys_err.h>
+#include <my_dir.h>
 #include <mysql_com.h>
 #include <zlib.h>
 
@@ -153,6 +154,7 @@ ms3_st *s3_open_connection(S3_INFO *s3)
                     "Can't open connection to S3, error: %d %s", MYF(0),
                     errno, ms3_error(errno));
     my_errno= HA_ERR_NO_SUCH_TABLE;
+    return 0;
   }
   if (s3->protocol_version)
     ms3_set_option(s3_client, MS3_OPT_FORCE_PROTOCOL_VERSION,
@@ -198,67 +200,237 @@ static void fix_suffix(char *to_end, ulong nr)
   strmov(to_end - length, buff);
 }
 
-/**
-   Copy file to 'aws_path' in blocks of block_size
+/******************************************************************************
+ Copy of index and data blocks between a local file and S3
 
-   @return 0   ok
-   @return 1   error. Error message is printed to stderr
+ The blocks of a file are independent objects in S3, so they can be copied
+ in any order. With threads > 1 the blocks are distributed over the calling
+ thread and threads-1 helper threads. Each helper has its own connection to
+ S3, opened with the connection information in S3_INFO.
+******************************************************************************/
 
-   Notes:
-   file is always closed before return
+typedef struct st_s3_copy
+{
+  mysql_mutex_t lock;
+  const char *aws_bucket;
+  const char *aws_path;                 /* Path ending with 000000 */
+  size_t aws_path_length, block_size;
+  File file;
+  my_off_t start, file_end;
+  ulong next_block, blocks, blocks_done;
+  int error;
+  my_bool to_s3, compression, display, print_done;
+  my_bool error_in_thread;              /* Error message not yet given */
+} S3_COPY;
+
+typedef struct st_s3_copy_thread
+{
+  S3_COPY *copy;
+  ms3_st *client;
+  pthread_t thread;
+} S3_COPY_THREAD;
+
+
+/**
+   Copy blocks until all blocks are copied or some thread got an error
+
+   @param block  Buffer of block_size + ALIGN_SIZE(1) bytes, used when
+                 copying to S3
 */
 
-static my_bool copy_from_file(ms3_st *s3_client, const char *aws_bucket,
-                              char *aws_path,
-                              File file, my_off_t start, my_off_t file_end,
-                              uchar *block, size_t block_size,
-                              my_bool compression, my_bool display)
+static void s3_copy_blocks(S3_COPY *copy, ms3_st *client, uchar *block,
+                           my_bool in_thread)
 {
-  my_off_t pos;
-  char *path_end= strend(aws_path);
-  ulong bnr;
-  my_bool print_done= 0;
-  size_t length;
+  char aws_path[FN_REFLEN+100];
+  memcpy(aws_path, copy->aws_path, copy->aws_path_length + 1);
 
-  for (pos= start, bnr=1 ; pos < file_end ; pos+= length, bnr++)
+  for (;;)
   {
-    if ((length= my_pread(file, block, block_size, pos, MYF(MY_WME))) ==
-        MY_FILE_ERROR)
-      goto err;
-    if (length == 0)
+    ulong bnr;
+    my_off_t pos;
+    size_t length;
+    int error= 0;
+
+    mysql_mutex_lock(&copy->lock);
+    if (copy->error || copy->next_block > copy->blocks)
     {
-      my_error(EE_EOFERR, MYF(0), my_filename(file), my_errno);
-      goto err;
+      mysql_mutex_unlock(&copy->lock);
+      break;
     }
+    bnr= copy->next_block++;
+    mysql_mutex_unlock(&copy->lock);
 
-    fix_suffix(path_end, bnr);
-    if (s3_put_object(s3_client, aws_bucket, aws_path, block, length,
-                      compression))
-      goto err;
+    pos= copy->start + (my_off_t) (bnr - 1) * copy->block_size;
+    length= (size_t) MY_MIN(copy->block_size, copy->file_end - pos);
+    fix_suffix(aws_path + copy->aws_path_length, bnr);
 
+    if (copy->to_s3)
+    {
+      /* Read data after the prefix space for the compression header */
+      uchar *data= block + ALIGN_SIZE(1);
+      if (my_pread(copy->file, data, length, pos, MYF(MY_WME | MY_FNABP)))
+        error= my_errno ? my_errno : EE_READ;
+      else
+        error= s3_put_object(client, copy->aws_bucket, aws_path, data,
+                             length, copy->compression);
+    }
+    else
+    {
+      S3_BLOCK s3_block;
+      if (!(error= s3_get_object(client, copy->aws_bucket, aws_path,
+                                 &s3_block, copy->compression, 1)))
+      {
+        if (s3_block.length != length)
+        {
+          my_printf_error(HA_ERR_NOT_A_TABLE,
+                          "Block '%s' has wrong length %lu. Expected %lu",
+                          MYF(0), aws_path, (ulong) s3_block.length,
+                          (ulong) length);
+          error= HA_ERR_NOT_A_TABLE;
+        }
+        else if (my_pwrite(copy->file, s3_block.str, length, pos,
+                           MYF(MY_WME | MY_FNABP)))
+          error= my_errno ? my_errno : EE_WRITE;
+        s3_free(&s3_block);
+      }
+    }
+
+    mysql_mutex_lock(&copy->lock);
+    if (error)
+    {
+      if (!copy->error)
+      {
+        copy->error= error;
+        copy->error_in_thread= in_thread;
+      }
+      mysql_mutex_unlock(&copy->lock);
+      break;
+    }
+    copy->blocks_done++;
     /* Write up to DISPLAY_WITH number of '.' during copy */
-    if (display &&
-        ((pos + block_size) * DISPLAY_WITH / file_end) >
-        (pos * DISPLAY_WITH/file_end))
+    if (copy->display &&
+        (copy->blocks_done * DISPLAY_WITH / copy->blocks) >
+        ((copy->blocks_done - 1) * DISPLAY_WITH / copy->blocks))
     {
       fputc('.', stdout); fflush(stdout);
-      print_done= 1;
+      copy->print_done= 1;
+    }
+    mysql_mutex_unlock(&copy->lock);
+  }
+}
+
+
+static void *s3_copy_thread(void *arg)
+{
+  S3_COPY_THREAD *thread= (S3_COPY_THREAD*) arg;
+  S3_COPY *copy= thread->copy;
+  uchar *block= 0;
+  my_thread_init();
+
+  if (!copy->to_s3 ||
+      (block= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                 copy->block_size + ALIGN_SIZE(1),
+                                 MYF(MY_WME))))
+    s3_copy_blocks(copy, thread->client, block, 1);
+  my_free(block);
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+   Copy blocks between a file and 'aws_path'
+
+   @param aws_path  Path for the blocks, ending with 000000. This is
+                    replaced with the block number, starting from 1
+   @param block     Buffer of block_size + ALIGN_SIZE(1) bytes. Only used
+                    when copying to S3
+   @param s3_info   Connection information for helper threads
+   @param threads   Number of blocks to copy in parallel
+
+   @return 0   ok
+   @return 1   error. An error message has been given
+
+   Notes:
+   file is always closed before return
+*/
+
+static my_bool copy_blocks(ms3_st *s3_client, const char *aws_bucket,
+                           const char *aws_path, File file, my_off_t start,
+                           my_off_t file_end, uchar *block,
+                           size_t block_size, my_bool to_s3,
+                           my_bool compression, my_bool display,
+                           S3_INFO *s3_info, uint threads)
+{
+  S3_COPY copy;
+  S3_COPY_THREAD *thread= 0;
+  uint i, started= 0;
+  DBUG_ENTER("copy_blocks");
+  DBUG_PRINT("enter", ("path: %s  start: %llu  end: %llu  threads: %u",
+                       aws_path, (ulonglong) start, (ulonglong) file_end,
+                       threads));
+
+  bzero(&copy, sizeof(copy));
+  copy.aws_bucket=      aws_bucket;
+  copy.aws_path=        aws_path;
+  copy.aws_path_length= strlen(aws_path);
+  copy.block_size=      block_size;
+  copy.file=            file;
+  copy.start=           start;
+  copy.file_end=        file_end;
+  copy.to_s3=           to_s3;
+  copy.compression=     compression;
+  copy.display=         display;
+  copy.next_block=      1;
+  copy.blocks= (ulong) ((file_end - MY_MIN(start, file_end) + block_size - 1) /
+                        block_size);
+  mysql_mutex_init(PSI_NOT_INSTRUMENTED, &copy.lock, MY_MUTEX_INIT_FAST);
+
+  set_if_smaller(threads, copy.blocks);
+  if (threads > 1 && s3_info &&
+      (thread= (S3_COPY_THREAD*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                           sizeof(*thread) * (threads - 1),
+                                           MYF(MY_WME))))
+  {
+    for (i= 0; i < threads - 1; i++)
+    {
+      thread[i].copy= &copy;
+      if (!(thread[i].client= s3_open_connection(s3_info)))
+        break;
+      ms3_set_option(thread[i].client, MS3_OPT_BUFFER_CHUNK_SIZE,
+                     &block_size);
+      if (mysql_thread_create(PSI_NOT_INSTRUMENTED, &thread[i].thread, NULL,
+                              s3_copy_thread, thread + i))
+      {
+        s3_deinit(thread[i].client);
+        break;
+      }
+      started++;
     }
   }
-  if (print_done)
+
+  s3_copy_blocks(&copy, s3_client, block, 0);
+
+  for (i= 0; i < started; i++)
   {
-    fputc('\n', stdout); fflush(stdout);
+    pthread_join(thread[i].thread, NULL);
+    s3_deinit(thread[i].client);
   }
-  my_close(file, MYF(MY_WME));
-  return 0;
+  my_free(thread);
+  mysql_mutex_destroy(&copy.lock);
 
-err:
-  my_close(file, MYF(MY_WME));
-  if (print_done)
+  if (copy.error_in_thread)
+  {
+    /* The message was not given in this thread */
+    my_printf_error(copy.error, "Got error %d when copying %s %s S3",
+                    MYF(0), copy.error, aws_path, to_s3 ? "to" : "from");
+  }
+  if (copy.print_done)
   {
     fputc('\n', stdout); fflush(stdout);
   }
-  return 1;
+  my_close(file, MYF(MY_WME));
+  DBUG_RETURN(copy.error != 0);
 }
 
 
@@ -274,6 +446,9 @@ static my_bool copy_from_file(ms3_st *s3_client, const char *aws_bucket,
                        specified as part of open.
    @param compression  Compression algorithm (0 = none, 1 = zip)
                        If block size is 0 then use .MAI file.
+   @param s3_info      Connection information for extra connections.
+                       Only used if threads > 1
+   @param threads      Number of blocks to upload in parallel
    @return 0  ok
    @return 1  error
 
@@ -305,7 +480,8 @@ int aria_copy_to_s3(ms3_st *s3_client, const char *aws_bucket,
                     const char *path,
                     const char *database, const char *table_name,
                     ulong block_size, my_bool compression,
-                    my_bool force, my_bool display, my_bool copy_frm)
+                    my_bool force, my_bool display, my_bool copy_frm,
+                    S3_INFO *s3_info, uint threads)
 {
   ARIA_TABLE_CAPABILITIES cap;
   char aws_path[FN_REFLEN+100];
@@ -438,8 +614,9 @@ int aria_copy_to_s3(ms3_st *s3_client, const char *aws_bucket,
   /* The 000000 will be update with block number by fix_suffix() */
   end= strmov(end, "/000000");
 
-  error= copy_from_file(s3_client, aws_bucket, aws_path, file, cap.header_size,
-                        file_size, block, block_size, compression, display);
+  error= copy_blocks(s3_client, aws_bucket, aws_path, file, cap.header_size,
+                     file_size, alloc_block, block_size, 1, compression,
+                     display, s3_info, threads);
   file= -1;
   if (error)
     goto err;
@@ -461,8 +638,9 @@ int aria_copy_to_s3(ms3_st *s3_client, const char *aws_bucket,
   /* The 000000 will be update with block number by fix_suffix() */
   end= strmov(end, "/000000");
 
-  error= copy_from_file(s3_client, aws_bucket, aws_path, file, 0, file_size,
-                        block, block_size, compression, display);
+  error= copy_blocks(s3_client, aws_bucket, aws_path, file, 0, file_size,
+                     alloc_block, block_size, 1, compression, display,
+                     s3_info, threads);
   file= -1;
   if (error)
     goto err;
@@ -483,75 +661,18 @@ int aria_copy_to_s3(ms3_st *s3_client, const char *aws_bucket,
 }
 
 
-/**
-   Copy file to 'aws_path' in blocks of block_size
-
-   @return 0   ok
-   @return 1   error. Error message is printed to stderr
-
-   Notes:
-   file is always closed before return
-*/
-
-static my_bool copy_to_file(ms3_st *s3_client, const char *aws_bucket,
-                            char *aws_path, File file, my_off_t start,
-                            my_off_t file_end, my_bool compression,
-                            my_bool display)
-{
-  my_off_t pos;
-  char *path_end= strend(aws_path);
-  size_t error;
-  ulong bnr;
-  my_bool print_done= 0;
-  S3_BLOCK block;
-  DBUG_ENTER("copy_to_file");
-  DBUG_PRINT("enter", ("path: %s  start: %llu  end: %llu",
-                       aws_path, (ulonglong) start, (ulonglong) file_end));
-
-  for (pos= start, bnr=1 ; pos < file_end ; pos+= block.length, bnr++)
-  {
-    fix_suffix(path_end, bnr);
-    if (s3_get_object(s3_client, aws_bucket, aws_path, &block, compression, 1))
-      goto err;
-
-    error= my_write(file, block.str, block.length, MYF(MY_WME | MY_FNABP));
-    s3_free(&block);
-    if (error == MY_FILE_ERROR)
-      goto err;
-
-    /* Write up to DISPLAY_WITH number of '.' during copy */
-    if (display &&
-        ((pos + block.length) * DISPLAY_WITH /file_end) >
-        (pos * DISPLAY_WITH/file_end))
-    {
-      fputc('.', stdout); fflush(stdout);
-      print_done= 1;
-    }
-  }
-  if (print_done)
-  {
-    fputc('\n', stdout); fflush(stdout);
-  }
-  my_close(file, MYF(MY_WME));
-  DBUG_RETURN(0);
-
-err:
-  my_close(file, MYF(MY_WME));
-  if (print_done)
-  {
-    fputc('\n', stdout); fflush(stdout);
-  }
-  DBUG_RETURN(1);
-}
-
-
 /**
    Copy a table from S3 to current directory
+
+   @param s3_info      Connection information for extra connections.
+                       Only used if threads > 1
+   @param threads      Number of blocks to download in parallel
 */
 
 int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
                       const char *path, const char *database,
-                      my_bool compression, my_bool force, my_bool display)
+                      my_bool compression, my_bool force, my_bool display,
+                      S3_INFO *s3_info, uint threads)
 
 {
   MARIA_STATE_INFO state;
@@ -562,6 +683,7 @@ int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
   File file= -1;
   S3_BLOCK block;
   my_off_t index_file_size, data_file_size;
+  size_t block_size;
   uint offset;
   int error;
   DBUG_ENTER("aria_copy_from_s3");
@@ -602,6 +724,17 @@ int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
   index_file_size= mi_sizekorr(block.str + offset);
   data_file_size=  mi_sizekorr(block.str + offset+8);
 
+  /* Block size in S3, as stored by convert_index_to_s3_format() */
+  memcpy(state.header.file_version, block.str, sizeof(state.header));
+  offset= mi_uint2korr(state.header.base_pos);
+  if (offset + MARIA_BASE_INFO_S3_BLOCK_SIZE_POS + 3 > block.length ||
+      !(block_size= mi_uint3korr(block.str + offset +
+                                 MARIA_BASE_INFO_S3_BLOCK_SIZE_POS)))
+  {
+    fprintf(stderr, "Wrong S3 block size in first block\n");
+    goto err_with_free;
+  }
+
   if ((file= my_create(filename, 0,
                        O_WRONLY | O_TRUNC | O_NOFOLLOW, MYF(MY_WME))) < 0)
     goto err_with_free;
@@ -616,8 +749,9 @@ int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
 
   end= strmov(aws_path_end,"/index/000000");
 
-  error= copy_to_file(s3_client, aws_bucket, aws_path, file, block.length,
-                      index_file_size, compression, display);
+  error= copy_blocks(s3_client, aws_bucket, aws_path, file, block.length,
+                     index_file_size, 0, block_size, 0, compression, display,
+                     s3_info, threads);
   file= -1;
   if (error)
     goto err_with_free;
@@ -636,8 +770,9 @@ int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
   /* The 000000 will be update with block number by fix_suffix() */
   strmov(end, "/000000");
 
-  error= copy_to_file(s3_client, aws_bucket, aws_path, file, 0, data_file_size,
-                      compression, display);
+  error= copy_blocks(s3_client, aws_bucket, aws_path, file, 0, data_file_size,
+                     0, block_size, 0, compression, display, s3_info,
+                     threads);
   file= -1;
   s3_free(&block);
   block.str= 0;
@@ -966,6 +1101,67 @@ int s3_put_object(ms3_st *s3_client, const char *aws_bucket,
 }
 
 
+/**
+   Uncompress a block that was stored with compression
+
+   The block is freed in case of errors
+*/
+
+static int s3_uncompress_block(S3_BLOCK *block, const char *name)
+{
+  ulong length;
+  uchar *data;
+  DBUG_ENTER("s3_uncompress_block");
+
+  /* If not compressed */
+  if (!block->str[0])
+  {
+    block->length-= COMPRESS_HEADER;
+    block->str+=    COMPRESS_HEADER;
+
+    /* Simple check to ensure that it's a correct block */
+    if (block->length % 1024)
+    {
+      s3_free(block);
+      my_printf_error(HA_ERR_NOT_A_TABLE,
+                      "Block '%s' is not compressed", MYF(0), name);
+      DBUG_RETURN(HA_ERR_NOT_A_TABLE);
+    }
+    DBUG_RETURN(0);
+  }
+
+  if (((uchar*)block->str)[0] > 1)
+  {
+    s3_free(block);
+    my_printf_error(HA_ERR_NOT_A_TABLE,
+                    "Block '%s' is not compressed", MYF(0), name);
+    DBUG_RETURN(HA_ERR_NOT_A_TABLE);
+  }
+
+  length= uint3korr(block->str+1);
+
+  if (!(data= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                 length, MYF(MY_WME | MY_THREAD_SPECIFIC))))
+  {
+    s3_free(block);
+    DBUG_RETURN(EE_OUTOFMEMORY);
+  }
+  if (uncompress(data, &length, block->str + COMPRESS_HEADER,
+                 block->length - COMPRESS_HEADER))
+  {
+    my_printf_error(ER_NET_UNCOMPRESS_ERROR,
+                    "Got error uncompressing s3 packet", MYF(0));
+    s3_free(block);
+    my_free(data);
+    DBUG_RETURN(ER_NET_UNCOMPRESS_ERROR);
+  }
+  s3_free(block);
+  block->str= block->alloc_ptr= data;
+  block->length= length;
+  DBUG_RETURN(0);
+}
+
+
 /**
    Read an object for index or data information
 
@@ -980,7 +1176,6 @@ int s3_get_object(ms3_st *s3_client, const char *aws_bucket,
 {
   uint8_t error;
   int result= 0;
-  uchar *data;
   DBUG_ENTER("s3_get_object");
   DBUG_PRINT("enter", ("name: %s  compression: %d", name, compression));
 
@@ -991,55 +1186,7 @@ int s3_get_object(ms3_st *s3_client, const char *aws_bucket,
   {
     block->str= block->alloc_ptr;
     if (compression)
-    {
-      ulong length;
-
-      /* If not compressed */
-      if (!block->str[0])
-      {
-        block->length-= COMPRESS_HEADER;
-        block->str+=    COMPRESS_HEADER;
-
-        /* Simple check to ensure that it's a correct block */
-        if (block->length % 1024)
-        {
-          s3_free(block);
-          my_printf_error(HA_ERR_NOT_A_TABLE,
-                          "Block '%s' is not compressed", MYF(0), name);
-          DBUG_RETURN(HA_ERR_NOT_A_TABLE);
-        }
-        DBUG_RETURN(0);
-      }
-
-      if (((uchar*)block->str)[0] > 1)
-      {
-        s3_free(block);
-        my_printf_error(HA_ERR_NOT_A_TABLE,
-                        "Block '%s' is not compressed", MYF(0), name);
-        DBUG_RETURN(HA_ERR_NOT_A_TABLE);
-      }
-
-      length= uint3korr(block->str+1);
-
-      if (!(data= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED,
-                                     length, MYF(MY_WME | MY_THREAD_SPECIFIC))))
-      {
-        s3_free(block);
-        DBUG_RETURN(EE_OUTOFMEMORY);
-      }
-      if (uncompress(data, &length, block->str + COMPRESS_HEADER,
-                     block->length - COMPRESS_HEADER))
-      {
-        my_printf_error(ER_NET_UNCOMPRESS_ERROR,
-                        "Got error uncompressing s3 packet", MYF(0));
-        s3_free(block);
-        my_free(data);
-        DBUG_RETURN(ER_NET_UNCOMPRESS_ERROR);
-      }
-      s3_free(block);
-      block->str= block->alloc_ptr= data;
-      block->length= length;
-    }
+      DBUG_RETURN(s3_uncompress_block(block, name));
     DBUG_RETURN(0);
   }
 
@@ -1236,8 +1383,8 @@ static void convert_index_to_s3_format(uchar *header, ulong block_size,
   base_offset= mi_uint2korr(state.header.base_pos);
   base_pos= header + base_offset;
 
-  base_pos[107]= (uchar) compression;
-  mi_int3store(base_pos+119, block_size);
+  base_pos[MARIA_BASE_INFO_COMPRESSION_POS]= (uchar) compression;
+  mi_int3store(base_pos + MARIA_BASE_INFO_S3_BLOCK_SIZE_POS, block_size);
 }
 
 
@@ -1255,8 +1402,8 @@ static void convert_index_to_disk_format(uchar *header)
   base_offset= mi_uint2korr(state.header.base_pos);
   base_pos= header + base_offset;
 
-  base_pos[107]= 0;
-  mi_int3store(base_pos+119, 0);
+  base_pos[MARIA_BASE_INFO_COMPRESSION_POS]= 0;
+  mi_int3store(base_pos + MARIA_BASE_INFO_S3_BLOCK_SIZE_POS, 0);
 }
 
 /**
@@ -1576,6 +1723,681 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
 #endif
 
 
+/******************************************************************************
+ Local disk copy of S3 blocks
+
+ Blocks are stored as they are in S3, in
+ s3_block_cache_dir/bucket/database/table/{data,index}/block-checksum
+ where checksum is the checksum of the index header of the table. A table
+ that is recreated in S3 will thus not use blocks of an older version.
+
+ The blocks on disk are kept in a LRU list. When the size of the blocks
+ gets bigger than s3_block_cache_size, the least recently used blocks are
+ removed.
+******************************************************************************/
+
+typedef struct st_s3_cached_block
+{
+  struct st_s3_cached_block *next, *prev;   /* LRU list, newest first */
+  size_t length;                            /* Size of the file */
+  size_t path_length;
+  char path[1];                             /* Allocated with the struct */
+} S3_CACHED_BLOCK;
+
+char *s3_block_cache_dir= 0;
+ulonglong s3_block_cache_size= 0;
+ulonglong s3_block_cache_hits= 0, s3_read_ahead_hits= 0;
+
+static mysql_mutex_t s3_block_cache_lock;
+static HASH s3_block_cache_hash;
+static S3_CACHED_BLOCK *s3_block_cache_first, *s3_block_cache_last;
+static ulonglong s3_block_cache_used;
+static my_bool s3_block_cache_inited= 0;
+
+
+static uchar *s3_cached_block_get_key(const uchar *ptr, size_t *length,
+                                      my_bool not_used __attribute__((unused)))
+{
+  S3_CACHED_BLOCK *entry= (S3_CACHED_BLOCK*) ptr;
+  *length= entry->path_length;
+  return (uchar*) entry->path;
+}
+
+
+static void s3_block_cache_unlink(S3_CACHED_BLOCK *entry)
+{
+  if (entry->prev)
+    entry->prev->next= entry->next;
+  else
+    s3_block_cache_first= entry->next;
+  if (entry->next)
+    entry->next->prev= entry->prev;
+  else
+    s3_block_cache_last= entry->prev;
+}
+
+
+static void s3_block_cache_link_first(S3_CACHED_BLOCK *entry)
+{
+  entry->prev= 0;
+  if ((entry->next= s3_block_cache_first))
+    s3_block_cache_first->prev= entry;
+  else
+    s3_block_cache_last= entry;
+  s3_block_cache_first= entry;
+}
+
+
+/**
+   Forget a block and optionally remove its file. Called with
+   s3_block_cache_lock locked
+*/
+
+static void s3_block_cache_remove(S3_CACHED_BLOCK *entry, my_bool delete_file)
+{
+  s3_block_cache_unlink(entry);
+  s3_block_cache_used-= entry->length;
+  my_hash_delete(&s3_block_cache_hash, (uchar*) entry);
+  if (delete_file)
+    (void) my_delete(entry->path, MYF(0));
+  my_free(entry);
+}
+
+
+/**
+   Remove the least recently used blocks until the cache fits in
+   s3_block_cache_size. Called with s3_block_cache_lock locked
+*/
+
+static void s3_block_cache_evict(void)
+{
+  while (s3_block_cache_size && s3_block_cache_used > s3_block_cache_size &&
+         s3_block_cache_last)
+    s3_block_cache_remove(s3_block_cache_last, 1);
+}
+
+
+/**
+   Register a block file as the most recently used one
+*/
+
+static void s3_block_cache_add(const char *path, size_t length)
+{
+  S3_CACHED_BLOCK *entry;
+  size_t path_length= strlen(path);
+
+  mysql_mutex_lock(&s3_block_cache_lock);
+  if ((entry= (S3_CACHED_BLOCK*) my_hash_search(&s3_block_cache_hash,
+                                                (uchar*) path, path_length)))
+  {
+    /* Another thread stored the same block */
+    s3_block_cache_unlink(entry);
+    s3_block_cache_used-= entry->length;
+  }
+  else
+  {
+    if (!(entry= (S3_CACHED_BLOCK*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                              sizeof(*entry) + path_length,
+                                              MYF(0))))
+      goto err;
+    entry->path_length= path_length;
+    memcpy(entry->path, path, path_length + 1);
+    if (my_hash_insert(&s3_block_cache_hash, (uchar*) entry))
+    {
+      my_free(entry);
+      goto err;
+    }
+  }
+  entry->length= length;
+  s3_block_cache_used+= length;
+  s3_block_cache_link_first(entry);
+  s3_block_cache_evict();
+  mysql_mutex_unlock(&s3_block_cache_lock);
+  return;
+
+err:
+  /* A block that is not in the LRU list would never be removed */
+  mysql_mutex_unlock(&s3_block_cache_lock);
+  (void) my_delete(path, MYF(0));
+}
+
+
+/**
+   Mark a block as the most recently used one
+*/
+
+static void s3_block_cache_touch(const char *path)
+{
+  S3_CACHED_BLOCK *entry;
+  mysql_mutex_lock(&s3_block_cache_lock);
+  if ((entry= (S3_CACHED_BLOCK*) my_hash_search(&s3_block_cache_hash,
+                                                (uchar*) path, strlen(path))))
+  {
+    s3_block_cache_unlink(entry);
+    s3_block_cache_link_first(entry);
+  }
+  mysql_mutex_unlock(&s3_block_cache_lock);
+}
+
+
+/**
+   Register the blocks that are on disk from an earlier run of the server
+
+   Partly written blocks (*.tmp*) are removed.
+*/
+
+static void s3_block_cache_scan(const char *dir, uint level)
+{
+  MY_DIR *dir_info;
+  char path[FN_REFLEN];
+  size_t i;
+
+  if (!(dir_info= my_dir(dir, MYF(MY_WANT_STAT))))
+    return;
+  for (i= 0; i < dir_info->number_of_files; i++)
+  {
+    FILEINFO *file= dir_info->dir_entry + i;
+    if (my_snprintf(path, sizeof(path), "%s/%s", dir, file->name) >=
+        sizeof(path) - 1)
+      continue;
+    if (MY_S_ISDIR(file->mystat->st_mode))
+    {
+      /* bucket/database/table/{data,index} */
+      if (level < 4)
+        s3_block_cache_scan(path, level + 1);
+    }
+    else if (level == 4)
+    {
+      if (strstr(file->name, ".tmp"))
+        (void) my_delete(path, MYF(0));
+      else
+        s3_block_cache_add(path, (size_t) file->mystat->st_size);
+    }
+  }
+  my_dirend(dir_info);
+}
+
+
+/**
+   Start using the local block cache if s3_block_cache_dir is set
+*/
+
+void s3_block_cache_init(void)
+{
+  if (!s3_block_cache_dir || !s3_block_cache_dir[0])
+    return;
+  mysql_mutex_init(PSI_NOT_INSTRUMENTED, &s3_block_cache_lock,
+                   MY_MUTEX_INIT_FAST);
+  if (my_hash_init(PSI_INSTRUMENT_ME, &s3_block_cache_hash,
+                   &my_charset_bin, 1024, 0, 0, s3_cached_block_get_key,
+                   0, 0))
+  {
+    mysql_mutex_destroy(&s3_block_cache_lock);
+    return;
+  }
+  s3_block_cache_first= s3_block_cache_last= 0;
+  s3_block_cache_used= 0;
+  s3_block_cache_scan(s3_block_cache_dir, 0);
+  s3_block_cache_inited= 1;
+}
+
+
+void s3_block_cache_end(void)
+{
+  S3_CACHED_BLOCK *entry, *next;
+  if (!s3_block_cache_inited)
+    return;
+  s3_block_cache_inited= 0;
+  for (entry= s3_block_cache_first; entry; entry= next)
+  {
+    next= entry->next;
+    my_free(entry);
+  }
+  s3_block_cache_first= s3_block_cache_last= 0;
+  my_hash_free(&s3_block_cache_hash);
+  mysql_mutex_destroy(&s3_block_cache_lock);
+}
+
+
+/**
+   Remove blocks until the cache fits in a new s3_block_cache_size
+*/
+
+void s3_block_cache_resize(ulonglong size)
+{
+  if (!s3_block_cache_inited)
+  {
+    s3_block_cache_size= size;
+    return;
+  }
+  mysql_mutex_lock(&s3_block_cache_lock);
+  s3_block_cache_size= size;
+  s3_block_cache_evict();
+  mysql_mutex_unlock(&s3_block_cache_lock);
+}
+
+
+/**
+   Get the name of the local copy of a block
+
+   @return 0  ok
+   @return 1  the block is not to be cached
+*/
+
+static my_bool s3_block_cache_path(char *to, S3_INFO *s3,
+                                   const char *aws_path)
+{
+  size_t length;
+  if (!s3_block_cache_inited)
+    return 1;
+  length= my_snprintf(to, FN_REFLEN, "%s/%s/%s-%08x", s3_block_cache_dir,
+                      s3->bucket.str, aws_path, (uint) s3->header_checksum);
+  return length >= FN_REFLEN - 1;
+}
+
+
+/**
+   Store a block in the local block cache
+
+   Errors are ignored; the block will just be read from S3 the next time.
+   The block is written to a temporary file that is renamed, so that
+   other threads never see a partly written block.
+*/
+
+static void s3_block_cache_write(const char *cache_path, S3_BLOCK *block)
+{
+  char dir[FN_REFLEN], tmp_path[FN_REFLEN], *pos;
+  File file;
+  size_t dir_length= strlen(s3_block_cache_dir);
+
+  /* A block bigger than the whole cache would be removed at once */
+  if (s3_block_cache_size && block->length > s3_block_cache_size)
+    return;
+
+  /* Create the directories for bucket, database, table and file type */
+  strmake(dir, cache_path, sizeof(dir)-1);
+  for (pos= dir + dir_length + 1; (pos= strchr(pos, '/')); pos++)
+  {
+    *pos= 0;
+    (void) my_mkdir(dir, 0777, MYF(0));
+    *pos= '/';
+  }
+
+  my_snprintf(tmp_path, sizeof(tmp_path), "%s.tmp%llu", cache_path,
+              (ulonglong) my_thread_dbug_id());
+  if ((file= my_create(tmp_path, 0, O_WRONLY | O_TRUNC | O_NOFOLLOW,
+                       MYF(0))) < 0)
+    return;
+  if (my_write(file, block->str, block->length, MYF(MY_NABP)) |
+      my_close(file, MYF(0)) ||
+      my_rename(tmp_path, cache_path, MYF(0)))
+  {
+    (void) my_delete(tmp_path, MYF(0));
+    return;
+  }
+  s3_block_cache_add(cache_path, block->length);
+}
+
+
+/**
+   Remove all local blocks of a table
+*/
+
+void s3_block_cache_delete_table(const char *bucket, const char *database,
+                                 const char *table)
+{
+  char path[FN_REFLEN];
+  size_t length;
+  S3_CACHED_BLOCK *entry, *next;
+
+  if (!s3_block_cache_inited)
+    return;
+  if ((length= my_snprintf(path, sizeof(path), "%s/%s/%s/%s/",
+                           s3_block_cache_dir, bucket, database, table)) >=
+      sizeof(path) - 1)
+    return;
+
+  mysql_mutex_lock(&s3_block_cache_lock);
+  for (entry= s3_block_cache_first; entry; entry= next)
+  {
+    next= entry->next;
+    if (entry->path_length > length && !memcmp(entry->path, path, length))
+      s3_block_cache_remove(entry, 0);
+  }
+  path[length - 1]= 0;                          /* Remove last '/' */
+  (void) my_rmtree(path, MYF(0));
+  mysql_mutex_unlock(&s3_block_cache_lock);
+}
+
+
+/**
+   Read a data or index block, from the local block cache if possible
+
+   The block is returned as it's stored in S3 (it may be compressed)
+*/
+
+static int s3_get_block(ms3_st *client, S3_INFO *s3, const char *aws_path,
+                        S3_BLOCK *block, int print_error)
+{
+  char cache_path[FN_REFLEN];
+  my_bool use_cache= !s3_block_cache_path(cache_path, s3, aws_path);
+  int error;
+
+  if (use_cache &&
+      !s3_read_file_from_disk(cache_path, &block->alloc_ptr, &block->length,
+                              0))
+  {
+    block->str= block->alloc_ptr;
+    s3_block_cache_touch(cache_path);
+    my_atomic_add64_explicit((volatile int64*) &s3_block_cache_hits, 1,
+                             MY_MEMORY_ORDER_RELAXED);
+    return 0;
+  }
+  if ((error= s3_get_object(client, s3->bucket.str, aws_path, block, 0,
+                            print_error)))
+    return error;
+  if (use_cache)
+    s3_block_cache_write(cache_path, block);
+  return 0;
+}
+
+
+/******************************************************************************
+ Read ahead of data blocks during table scans
+
+ When a data block is read during a scan, the blocks following it are
+ queued. Worker threads, each with its own connection to S3, fetch the
+ queued blocks in parallel. s3_block_read() takes the block from here if
+ it has been read ahead. The workers are started at the first scan of a
+ handler and are used by all its scans until the end of the statement.
+******************************************************************************/
+
+enum s3_read_ahead_state
+{
+  S3_READ_AHEAD_EMPTY, S3_READ_AHEAD_QUEUED, S3_READ_AHEAD_LOADING,
+  S3_READ_AHEAD_DONE
+};
+
+typedef struct st_s3_read_ahead_slot
+{
+  S3_BLOCK block;
+  ulong block_number;
+  int error;
+  enum s3_read_ahead_state state;
+} S3_READ_AHEAD_SLOT;
+
+typedef struct st_s3_read_ahead_worker
+{
+  struct st_s3_read_ahead *read_ahead;
+  ms3_st *client;
+  pthread_t thread;
+} S3_READ_AHEAD_WORKER;
+
+struct st_s3_read_ahead
+{
+  mysql_mutex_t lock;
+  mysql_cond_t cond;                    /* Signaled when slots change */
+  S3_INFO *s3;
+  S3_READ_AHEAD_SLOT *slot;
+  S3_READ_AHEAD_WORKER *worker;
+  char aws_path[AWS_PATH_LENGTH];       /* database/table/data/000000 */
+  size_t aws_path_length;
+  ulong last_block;                     /* Last data block of the table */
+  ulong position;                       /* Highest block read by the scan */
+  uint blocks, workers;
+  my_bool stop;
+};
+
+
+static void *s3_read_ahead_worker(void *arg)
+{
+  S3_READ_AHEAD_WORKER *worker= (S3_READ_AHEAD_WORKER*) arg;
+  S3_READ_AHEAD *read_ahead= worker->read_ahead;
+  S3_READ_AHEAD_SLOT *end= read_ahead->slot + read_ahead->blocks;
+  char aws_path[AWS_PATH_LENGTH];
+  my_thread_init();
+
+  mysql_mutex_lock(&read_ahead->lock);
+  while (!read_ahead->stop)
+  {
+    S3_READ_AHEAD_SLOT *slot= 0, *pos;
+    S3_BLOCK block;
+    int error;
+
+    /* Fetch the queued block that is closest to the scan first */
+    for (pos= read_ahead->slot; pos < end; pos++)
+      if (pos->state == S3_READ_AHEAD_QUEUED &&
+          (!slot || pos->block_number < slot->block_number))
+        slot= pos;
+    if (!slot)
+    {
+      mysql_cond_wait(&read_ahead->cond, &read_ahead->lock);
+      continue;
+    }
+    slot->state= S3_READ_AHEAD_LOADING;
+    memcpy(aws_path, read_ahead->aws_path, read_ahead->aws_path_length + 1);
+    fix_suffix(aws_path + read_ahead->aws_path_length, slot->block_number);
+    mysql_mutex_unlock(&read_ahead->lock);
+
+    error= s3_get_block(worker->client, read_ahead->s3, aws_path, &block, 0);
+
+    mysql_mutex_lock(&read_ahead->lock);
+    slot->block= block;
+    slot->error= error;
+    slot->state= S3_READ_AHEAD_DONE;
+    mysql_cond_broadcast(&read_ahead->cond);
+  }
+  mysql_mutex_unlock(&read_ahead->lock);
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+   Start read ahead for a scan of a S3 table
+
+   @param info    Handler that is scanning the table
+   @param blocks  Number of blocks to read ahead
+
+   @return 0   read ahead is not used
+   @return #   read ahead object to be given to s3_read_ahead_end()
+*/
+
+S3_READ_AHEAD *s3_read_ahead_start(MARIA_HA *info, uint blocks)
+{
+  MARIA_SHARE *share= info->s;
+  S3_INFO *s3= share->s3_path;
+  S3_READ_AHEAD *read_ahead;
+  S3_READ_AHEAD_SLOT *slot;
+  S3_READ_AHEAD_WORKER *worker;
+  size_t block_size= share->base.s3_block_size;
+  ulong last_block;
+  uint i;
+  DBUG_ENTER("s3_read_ahead_start");
+
+  last_block= (ulong) ((share->state.state.data_file_length + block_size - 1) /
+                       block_size);
+  if (!blocks || last_block <= 1)
+    DBUG_RETURN(0);
+  set_if_smaller(blocks, last_block - 1);
+
+  if (!my_multi_malloc(PSI_NOT_INSTRUMENTED, MYF(MY_WME | MY_ZEROFILL),
+                       &read_ahead, sizeof(*read_ahead),
+                       &slot, sizeof(*slot) * blocks,
+                       &worker, sizeof(*worker) * blocks,
+                       NullS))
+    DBUG_RETURN(0);
+  read_ahead->s3= s3;
+  read_ahead->slot= slot;
+  read_ahead->worker= worker;
+  read_ahead->blocks= blocks;
+  read_ahead->last_block= last_block;
+  read_ahead->aws_path_length=
+    (size_t) (strxnmov(read_ahead->aws_path,
+                       sizeof(read_ahead->aws_path) - 12,
+                       s3->database.str, "/", s3->table.str, "/data/",
+                       "000000", NullS) - read_ahead->aws_path);
+  mysql_mutex_init(PSI_NOT_INSTRUMENTED, &read_ahead->lock,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(PSI_NOT_INSTRUMENTED, &read_ahead->cond, 0);
+
+  for (i= 0; i < blocks; i++, worker++)
+  {
+    worker->read_ahead= read_ahead;
+    if (!(worker->client= s3_open_connection(s3)))
+      break;
+    ms3_set_option(worker->client, MS3_OPT_BUFFER_CHUNK_SIZE, &block_size);
+    if (mysql_thread_create(PSI_NOT_INSTRUMENTED, &worker->thread, NULL,
+                            s3_read_ahead_worker, worker))
+    {
+      s3_deinit(worker->client);
+      break;
+    }
+    read_ahead->workers++;
+  }
+  if (!read_ahead->workers)
+  {
+    s3_read_ahead_end(read_ahead);
+    DBUG_RETURN(0);
+  }
+  DBUG_RETURN(read_ahead);
+}
+
+
+/**
+   Stop the read ahead workers and free all blocks that were not used
+*/
+
+void s3_read_ahead_end(S3_READ_AHEAD *read_ahead)
+{
+  uint i;
+  DBUG_ENTER("s3_read_ahead_end");
+
+  mysql_mutex_lock(&read_ahead->lock);
+  read_ahead->stop= 1;
+  mysql_cond_broadcast(&read_ahead->cond);
+  mysql_mutex_unlock(&read_ahead->lock);
+
+  for (i= 0; i < read_ahead->workers; i++)
+  {
+    pthread_join(read_ahead->worker[i].thread, NULL);
+    s3_deinit(read_ahead->worker[i].client);
+  }
+  for (i= 0; i < read_ahead->blocks; i++)
+  {
+    S3_READ_AHEAD_SLOT *slot= read_ahead->slot + i;
+    if (slot->state == S3_READ_AHEAD_DONE && !slot->error)
+      s3_free(&slot->block);
+  }
+  mysql_cond_destroy(&read_ahead->cond);
+  mysql_mutex_destroy(&read_ahead->lock);
+  my_free(read_ahead);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+   Prepare read ahead for a new scan of the table
+
+   The worker threads and their connections are kept. Queued blocks and
+   blocks that were read but not used are dropped.
+*/
+
+void s3_read_ahead_reset(S3_READ_AHEAD *read_ahead)
+{
+  S3_READ_AHEAD_SLOT *pos, *end= read_ahead->slot + read_ahead->blocks;
+  DBUG_ENTER("s3_read_ahead_reset");
+
+  mysql_mutex_lock(&read_ahead->lock);
+  for (pos= read_ahead->slot; pos < end; pos++)
+  {
+    /* A block that is being read is freed when the next scan passes it */
+    if (pos->state == S3_READ_AHEAD_LOADING)
+      continue;
+    if (pos->state == S3_READ_AHEAD_DONE && !pos->error)
+      s3_free(&pos->block);
+    pos->state= S3_READ_AHEAD_EMPTY;
+  }
+  read_ahead->position= 0;
+  mysql_mutex_unlock(&read_ahead->lock);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+   Take a data block from the read ahead and queue the blocks after it
+
+   @return 0  The block was read ahead and is returned in block
+   @return 1  The block has to be read by the caller
+*/
+
+static my_bool s3_read_ahead_get(S3_READ_AHEAD *read_ahead,
+                                 ulong block_number, S3_BLOCK *block)
+{
+  S3_READ_AHEAD_SLOT *pos, *end= read_ahead->slot + read_ahead->blocks;
+  my_bool forward= block_number >= read_ahead->position;
+  my_bool res= 1;
+
+  mysql_mutex_lock(&read_ahead->lock);
+  for (pos= read_ahead->slot; pos < end; pos++)
+  {
+    if (pos->state == S3_READ_AHEAD_EMPTY)
+      continue;
+    if (pos->block_number == block_number)
+    {
+      /* If the read has not started yet, it's faster to do it ourselves */
+      while (pos->state == S3_READ_AHEAD_LOADING)
+        mysql_cond_wait(&read_ahead->cond, &read_ahead->lock);
+      if (pos->state == S3_READ_AHEAD_DONE && !pos->error)
+      {
+        *block= pos->block;
+        res= 0;
+      }
+      pos->state= S3_READ_AHEAD_EMPTY;
+    }
+    else if (forward && pos->block_number < block_number &&
+             pos->state != S3_READ_AHEAD_LOADING)
+    {
+      /* The scan has passed this block; its pages were in the page cache */
+      if (pos->state == S3_READ_AHEAD_DONE && !pos->error)
+        s3_free(&pos->block);
+      pos->state= S3_READ_AHEAD_EMPTY;
+    }
+  }
+
+  if (forward)
+  {
+    ulong next, last= MY_MIN(block_number + read_ahead->blocks,
+                             read_ahead->last_block);
+    read_ahead->position= block_number;
+    for (next= block_number + 1; next <= last; next++)
+    {
+      S3_READ_AHEAD_SLOT *free_slot= 0;
+      for (pos= read_ahead->slot; pos < end; pos++)
+      {
+        if (pos->state == S3_READ_AHEAD_EMPTY)
+        {
+          if (!free_slot)
+            free_slot= pos;
+        }
+        else if (pos->block_number == next)
+          break;
+      }
+      if (pos != end)
+        continue;                               /* Already queued */
+      if (!free_slot)
+        break;
+      free_slot->block_number= next;
+      free_slot->error= 0;
+      free_slot->state= S3_READ_AHEAD_QUEUED;
+    }
+    mysql_cond_broadcast(&read_ahead->cond);
+  }
+  mysql_mutex_unlock(&read_ahead->lock);
+  return res;
+}
+
+
 /**
    Read a block from S3 to page cache
 */
@@ -1608,8 +2430,17 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
                 s3->table.str, path_suffix, "000000", NullS);
   fix_suffix(end, block_number);
 
-  DBUG_RETURN(s3_get_object(client, s3->bucket.str, aws_path, block,
-                            share->base.compression_algorithm, 1));
+  if (datafile && info->s3_read_ahead &&
+      !s3_read_ahead_get(info->s3_read_ahead, block_number, block))
+    my_atomic_add64_explicit((volatile int64*) &s3_read_ahead_hits, 1,
+                             MY_MEMORY_ORDER_RELAXED);
+  else if (s3_get_block(client, s3, aws_path, block, 1))
+    DBUG_RETURN(TRUE);
+
+  if (share->base.compression_algorithm &&
+      s3_uncompress_block(block, aws_path))
+    DBUG_RETURN(TRUE);
+  DBUG_RETURN(FALSE);
 }
 
 /*
@@ -63,6 +63,9 @@ struct s3_info
 
   /* Protocol for the list bucket API call. 1 for Amazon, 2 for some others */
   uint8_t protocol_version;
+
+  /* Checksum of the index header stored in S3. Set by ma_open() */
+  uint32 header_checksum;
 };
 
 
@@ -78,10 +81,12 @@ int aria_copy_to_s3(ms3_st *s3_client, const char *aws_bucket,
                     const char *path,
                     const char *database, const char *table_name,
                     ulong block_size, my_bool compression,
-                    my_bool force, my_bool display, my_bool copy_frm);
+                    my_bool force, my_bool display, my_bool copy_frm,
+                    S3_INFO *s3_info, uint threads);
 int aria_copy_from_s3(ms3_st *s3_client, const char *aws_bucket,
                       const char *path,const char *database,
-                      my_bool compression, my_bool force, my_bool display);
+                      my_bool compression, my_bool force, my_bool display,
+                      S3_INFO *s3_info, uint threads);
 int aria_delete_from_s3(ms3_st *s3_client, const char *aws_bucket,
                         const char *database, const char *table,
                         my_bool display);
@@ -135,6 +140,24 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
                       PAGECACHE_IO_HOOK_ARGS *args,
                       struct st_pagecache_file *file,
                       S3_BLOCK *block);
+
+/* Read ahead of data blocks during table scans */
+typedef struct st_s3_read_ahead S3_READ_AHEAD;
+S3_READ_AHEAD *s3_read_ahead_start(struct st_maria_handler *info,
+                                   uint blocks);
+void s3_read_ahead_reset(S3_READ_AHEAD *read_ahead);
+void s3_read_ahead_end(S3_READ_AHEAD *read_ahead);
+
+/* Copy of S3 blocks on local disk */
+extern char *s3_block_cache_dir;
+extern ulonglong s3_block_cache_size;
+void s3_block_cache_init(void);
+void s3_block_cache_end(void);
+void s3_block_cache_resize(ulonglong size);
+void s3_block_cache_delete_table(const char *bucket, const char *database,
+                                 const char *table);
+
+extern ulonglong s3_block_cache_hits, s3_read_ahead_hits;
 C_MODE_END
 #else
 
@@ -0,0 +1,218 @@
+/* Copyright (c) 2022, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+
+/**
+  @file this unit tests a partitioned page cache and compares its speed
+  with the one of a page cache which is not partitioned.
+
+  Every thread writes the pages of a file of its own and reads them back
+  several times, like the sessions of a server writing and reading their
+  internal temporary tables. All the pages fit in the cache, so the time
+  spent is mostly the time spent in the page cache and waiting for its
+  locks. The times of the runs are printed with diag().
+*/
+
+#include <tap.h>
+#include <my_sys.h>
+#include <m_string.h>
+#include "test_file.h"
+
+#define PCACHE_SIZE (TEST_PAGE_SIZE*1024*8)
+
+static uint number_of_threads= 8;
+static uint number_of_pages= 256;
+static uint number_of_rounds= 100;
+
+static char *test_dirname;
+static PAGECACHE pagecache;
+
+struct thread_param
+{
+  uint num;
+  pthread_t tid;
+  char file_name[FN_REFLEN];
+  PAGECACHE_FILE file;
+  my_bool ok;
+};
+
+
+static uchar page_byte(uint num, pgcache_page_no_t page)
+{
+  return (uchar) (num * 31 + page);
+}
+
+
+static void *test_thread(void *arg)
+{
+  struct thread_param *param= (struct thread_param*) arg;
+  uchar buff[TEST_PAGE_SIZE];
+  pgcache_page_no_t page;
+  uint round, i;
+  my_thread_init();
+
+  for (page= 0; page < number_of_pages; page++)
+  {
+    bfill(buff, TEST_PAGE_SIZE, page_byte(param->num, page));
+    if (pagecache_write(&pagecache, &param->file, page, 3, buff,
+                        PAGECACHE_PLAIN_PAGE,
+                        PAGECACHE_LOCK_LEFT_UNLOCKED,
+                        PAGECACHE_PIN_LEFT_UNPINNED,
+                        PAGECACHE_WRITE_DELAY,
+                        0, LSN_IMPOSSIBLE))
+      goto err;
+  }
+  for (round= 0; round < number_of_rounds; round++)
+  {
+    for (page= 0; page < number_of_pages; page++)
+    {
+      uchar c= page_byte(param->num, page);
+      if (!pagecache_read(&pagecache, &param->file, page, 3, buff,
+                          PAGECACHE_PLAIN_PAGE,
+                          PAGECACHE_LOCK_LEFT_UNLOCKED, NULL))
+        goto err;
+      for (i= 0; i < TEST_PAGE_SIZE; i++)
+      {
+        if (buff[i] != c)
+        {
+          diag("Thread %u page %lu char #%u '%u' != '%u'", param->num,
+               (ulong) page, i, (uint) buff[i], (uint) c);
+          goto err;
+        }
+      }
+    }
+  }
+  param->ok= TRUE;
+  my_thread_end();
+  return 0;
+err:
+  param->ok= FALSE;
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+  @brief Runs the threads on a page cache with the given partitions
+
+  @return 0 if all the threads read back what they wrote
+*/
+
+static int run_test(uint partitions)
+{
+  struct thread_param *params;
+  ulonglong start;
+  uint i;
+  int error= 0;
+
+  if (!init_partitioned_pagecache(&pagecache, partitions, PCACHE_SIZE, 0, 0,
+                                  TEST_PAGE_SIZE, 0, 0))
+  {
+    diag("Got error: init_partitioned_pagecache() (errno: %d)", errno);
+    return 1;
+  }
+  params= (struct thread_param*) calloc(number_of_threads,
+                                        sizeof(*params));
+  for (i= 0; i < number_of_threads; i++)
+  {
+    char name[32];
+    params[i].num= i;
+    my_snprintf(name, sizeof(name), "page_cache_test_file_%u", i);
+    fn_format(params[i].file_name, name, test_dirname, "", MYF(0));
+    if ((params[i].file.file= my_open(params[i].file_name,
+                                      O_CREAT | O_TRUNC | O_RDWR,
+                                      MYF(0))) == -1)
+    {
+      diag("Got error during file creation from open() (errno: %d)",
+           errno);
+      exit(1);
+    }
+    pagecache_file_set_null_hooks(&params[i].file);
+  }
+
+  start= my_interval_timer();
+  for (i= 0; i < number_of_threads; i++)
+  {
+    if (pthread_create(&params[i].tid, NULL, test_thread, params + i))
+    {
+      diag("Got error from pthread_create (errno: %d)", errno);
+      exit(1);
+    }
+  }
+  for (i= 0; i < number_of_threads; i++)
+  {
+    pthread_join(params[i].tid, NULL);
+    if (!params[i].ok)
+      error= 1;
+  }
+  diag("partitions: %u  threads: %u  page reads: %u  time: %.3f s",
+       partitions, number_of_threads,
+       number_of_threads * number_of_pages * number_of_rounds,
+       (my_interval_timer() - start) / 1e9);
+
+  for (i= 0; i < number_of_threads; i++)
+  {
+    if (flush_pagecache_blocks(&pagecache, &params[i].file,
+                               FLUSH_RELEASE))
+      error= 1;
+    my_close(params[i].file.file, MYF(0));
+    my_delete(params[i].file_name, MYF(0));
+  }
+  end_pagecache(&pagecache, 1);
+  free(params);
+  return error;
+}
+
+
+static char *create_tmpdir(const char *progname)
+{
+  static char test_dirname[FN_REFLEN];
+  char tmp_name[FN_REFLEN];
+  size_t length;
+
+  /* Create a temporary directory of name TMP-'executable', but without the -t extension */
+  fn_format(tmp_name, progname, "", "", MY_REPLACE_DIR | MY_REPLACE_EXT);
+  length= strlen(tmp_name);
+  if (length > 2 && tmp_name[length-2] == '-' && tmp_name[length-1] == 't')
+    tmp_name[length-2]= 0;
+  strxmov(test_dirname, "TMP-", tmp_name, NullS);
+
+  /*
+    Don't give an error if we can't create dir, as it may already exist from a previously aborted
+    run
+  */
+  (void) my_mkdir(test_dirname, 0777, MYF(0));
+  return test_dirname;
+}
+
+
+int main(int argc __attribute__((unused)),
+         char **argv __attribute__((unused)))
+{
+  MY_INIT(argv[0]);
+
+  plan(2);
+  test_dirname= create_tmpdir(argv[0]);
+
+  ok(!run_test(1), "page cache which is not partitioned");
+  ok(!run_test(number_of_threads), "page cache with %u partitions",
+     number_of_threads);
+
+  rmdir(test_dirname);
+  my_end(0);
+  return exit_status();
+}
+
+#include "../ma_check_standalone.h"
@@ -0,0 +1,83 @@
+/* Copyright (C) 2022 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/*
+  bfind(str, str_length, find, find_length)
+
+  Returns a pointer to the first occurrence of the byte string "find"
+  in the byte string "str", or NULL if there is none.
+  An empty "find" is found at the very beginning of "str".
+
+  Candidate positions are those where both the first and the last byte
+  of "find" match. With SSE2 they are filtered 16 positions at a time,
+  so only the candidates are compared with memcmp(). Otherwise memchr()
+  is used to jump to the next occurrence of the first byte.
+*/
+
+#include "strings_def.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const uchar *bfind(const uchar *str, size_t str_length,
+                   const uchar *find, size_t find_length)
+{
+  const uchar *last, *cur;
+  uchar first_byte, last_byte;
+
+  if (find_length > str_length)
+    return NULL;
+  if (!find_length)
+    return str;
+
+  first_byte= find[0];
+  last_byte= find[find_length - 1];
+  /* The last position where an occurrence can start */
+  last= str + (str_length - find_length);
+  cur= str;
+
+#ifdef __SSE2__
+  {
+    const __m128i vfirst= _mm_set1_epi8((char) first_byte);
+    const __m128i vlast= _mm_set1_epi8((char) last_byte);
+    for ( ; cur + 16 <= last + 1; cur+= 16)
+    {
+      __m128i b1= _mm_loadu_si128((const __m128i *) cur);
+      __m128i b2= _mm_loadu_si128((const __m128i *) (cur + find_length - 1));
+      uint mask= (uint) _mm_movemask_epi8(_mm_and_si128(
+                                            _mm_cmpeq_epi8(b1, vfirst),
+                                            _mm_cmpeq_epi8(b2, vlast)));
+      while (mask)
+      {
+        uint pos= (uint) __builtin_ctz(mask);
+        if (!memcmp(cur + pos + 1, find + 1, find_length - 1))
+          return cur + pos;
+        mask&= mask - 1;
+      }
+    }
+  }
+#endif
+
+  while (cur <= last &&
+         (cur= (const uchar *) memchr(cur, first_byte, last - cur + 1)))
+  {
+    if (cur[find_length - 1] == last_byte &&
+        !memcmp(cur + 1, find + 1, find_length - 1))
+      return cur;
+    cur++;
+  }
+  return NULL;
+}
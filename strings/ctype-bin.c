@@ -453,7 +453,7 @@ uint my_instr_bin(CHARSET_INFO *cs __attribute__((unused)),
 		  const char *s, size_t s_length,
 		  my_match_t *match, uint nmatch)
 {
-  register const uchar *str, *search, *end, *search_end;
+  const uchar *str;
 
   if (s_length <= b_length)
   {
@@ -468,40 +468,22 @@ uint my_instr_bin(CHARSET_INFO *cs __attribute__((unused)),
       return 1;		/* Empty string is always found */
     }
 
-    str= (const uchar*) b;
-    search= (const uchar*) s;
-    end= (const uchar*) b+b_length-s_length+1;
-    search_end= (const uchar*) s + s_length;
-
-skip:
-    while (str != end)
+    if ((str= bfind((const uchar*) b, b_length, (const uchar*) s, s_length)))
     {
-      if ( (*str++) == (*search))
+      if (nmatch > 0)
       {
-	register const uchar *i,*j;
-
-	i= str;
-	j= search+1;
-
-	while (j != search_end)
-	  if ((*i++) != (*j++))
-            goto skip;
-
-        if (nmatch > 0)
-	{
-	  match[0].beg= 0;
-	  match[0].end= (uint) (str- (const uchar*)b-1);
-	  match[0].mb_len= match[0].end;
-
-	  if (nmatch > 1)
-	  {
-	    match[1].beg= match[0].end;
-	    match[1].end= (uint)(match[0].end+s_length);
-	    match[1].mb_len= match[1].end-match[1].beg;
-	  }
-	}
-	return 2;
+        match[0].beg= 0;
+        match[0].end= (uint) (str - (const uchar*) b);
+        match[0].mb_len= match[0].end;
+
+        if (nmatch > 1)
+        {
+          match[1].beg= match[0].end;
+          match[1].end= (uint)(match[0].end+s_length);
+          match[1].mb_len= match[1].end-match[1].beg;
+        }
       }
+      return 2;
     }
   }
   return 0;
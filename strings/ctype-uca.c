@@ -33834,6 +33834,33 @@ static void my_uca_handler_map(struct charset_info_st *cs,
 }
 
 
+/*
+  Return the length of the longest common prefix of two strings
+  which consists of ASCII characters only.
+
+  In a collation without contractions the weights of a character
+  do not depend on its neighbours, so two strings can be compared
+  starting right after such a prefix. Eight bytes are compared at
+  a time while both strings are equal and pure ASCII.
+*/
+static inline size_t
+my_uca_common_ascii_prefix_length(const uchar *s, const uchar *t, size_t len)
+{
+  size_t i= 0;
+  for ( ; i + 8 <= len; i+= 8)
+  {
+    ulonglong a, b;
+    memcpy(&a, s + i, 8);
+    memcpy(&b, t + i, 8);
+    if (a != b || (a & 0x8080808080808080ULL))
+      break;
+  }
+  for ( ; i < len && s[i] == t[i] && s[i] < 0x80; i++)
+  { }
+  return i;
+}
+
+
 /*
   Define generic collation handlers for multi-level collations with tailoring:
 
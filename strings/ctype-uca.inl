@@ -96,6 +96,16 @@ MY_FUNCTION_NAME(strnncoll_onelevel)(CHARSET_INFO *cs,
   int s_res;
   int t_res;
   
+#if MY_UCA_ASCII_OPTIMIZE && !MY_UCA_COMPILE_CONTRACTIONS
+  {
+    size_t prefix= my_uca_common_ascii_prefix_length(s, t, MY_MIN(slen, tlen));
+    s+= prefix;
+    slen-= prefix;
+    t+= prefix;
+    tlen-= prefix;
+  }
+#endif
+
   my_uca_scanner_init_any(&sscanner, cs, level, s, slen);
   my_uca_scanner_init_any(&tscanner, cs, level, t, tlen);
   
@@ -201,6 +211,16 @@ MY_FUNCTION_NAME(strnncollsp_onelevel)(CHARSET_INFO *cs,
   my_uca_scanner sscanner, tscanner;
   int s_res, t_res;
 
+#if MY_UCA_ASCII_OPTIMIZE && !MY_UCA_COMPILE_CONTRACTIONS
+  {
+    size_t prefix= my_uca_common_ascii_prefix_length(s, t, MY_MIN(slen, tlen));
+    s+= prefix;
+    slen-= prefix;
+    t+= prefix;
+    tlen-= prefix;
+  }
+#endif
+
   my_uca_scanner_init_any(&sscanner, cs, level, s, slen);
   my_uca_scanner_init_any(&tscanner, cs, level, t, tlen);
 
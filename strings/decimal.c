@@ -1159,6 +1159,81 @@ int decimal2ulonglong(const decimal_t *from, ulonglong *to)
   return E_DEC_OK;
 }
 
+/*
+  Convert a decimal to an integer scaled by 10^scale,
+  e.g. 1.25 becomes 1250 for scale=3.
+
+  Only values which have at most "scale" fractional digits and
+  at most 18 digits in total (intg + scale) are converted, so the
+  result is always exact and its absolute value is less than 10^18.
+
+  RETURN VALUE
+    E_DEC_OK/E_DEC_TRUNCATED/E_DEC_OVERFLOW
+*/
+
+int decimal2scaled_longlong(const decimal_t *from, int scale, longlong *to)
+{
+  dec1 *buf=from->buf;
+  longlong x=0;
+  int intg, frac;
+
+  if (from->frac > scale)
+    return E_DEC_TRUNCATED;
+  if (from->intg + scale > 18)
+    return E_DEC_OVERFLOW;
+
+  for (intg=from->intg; intg > 0; intg-=DIG_PER_DEC1)
+    x=x*DIG_BASE + *buf++;
+  for (frac=from->frac; frac > 0; frac-=DIG_PER_DEC1)
+  {
+    if (frac >= DIG_PER_DEC1)
+      x=x*DIG_BASE + *buf++;
+    else
+      x=x*powers10[frac] + *buf++ / powers10[DIG_PER_DEC1 - frac];
+  }
+  for (frac=scale - from->frac; frac > 0; frac-=DIG_PER_DEC1)
+    x*=powers10[MY_MIN(frac, DIG_PER_DEC1)];
+
+  *to=from->sign ? -x : x;
+  return E_DEC_OK;
+}
+
+/*
+  Convert an integer scaled by 10^scale (0 <= scale <= 18) to a decimal
+  with exactly "scale" fractional digits, the reverse of
+  decimal2scaled_longlong().
+*/
+
+int scaled_longlong2decimal(longlong from, int scale, decimal_t *to)
+{
+  ulonglong x, divisor=1, frac_part;
+  int i, error;
+  dec1 *buf;
+
+  DBUG_ASSERT(scale >= 0 && scale <= 2 * DIG_PER_DEC1);
+  for (i=0; i < scale; i++)
+    divisor*=10;
+  x= from < 0 ? -(ulonglong) from : (ulonglong) from;
+  frac_part= x % divisor;
+
+  if ((error=ull2dec(x / divisor, to)) != E_DEC_OK ||
+      ROUND_UP(to->intg) + ROUND_UP(scale) > to->len)
+    return E_DEC_OVERFLOW;
+
+  to->sign= from < 0;
+  to->frac= scale;
+  buf= to->buf + ROUND_UP(to->intg);
+  if (scale > DIG_PER_DEC1)
+  {
+    *buf++= (dec1) (frac_part / powers10[scale - DIG_PER_DEC1]);
+    *buf= (dec1) (frac_part % powers10[scale - DIG_PER_DEC1]) *
+          powers10[2 * DIG_PER_DEC1 - scale];
+  }
+  else if (scale > 0)
+    *buf= (dec1) frac_part * powers10[DIG_PER_DEC1 - scale];
+  return E_DEC_OK;
+}
+
 int decimal2longlong(const decimal_t *from, longlong *to)
 {
   dec1 *buf=from->buf;
@@ -17,6 +17,9 @@
 #include <string.h>
 #include <m_ctype.h>
 #include "json_lib.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 /*
   JSON escaping lets user specify UTF16 codes of characters.
@@ -366,11 +369,85 @@ int json_read_string_const_chr(json_string_t *js)
 }
 
 
+/*
+  Tells if in the character set every byte below 0x80 is an ASCII
+  character on its own and never is a part of a multibyte character.
+  That is so for the 8-bit ASCII-based charsets and for utf8mb3/utf8mb4.
+  Plain ASCII characters in such strings can be skipped byte by byte,
+  without calling the mb_wc() conversion function.
+*/
+static my_bool json_ascii_transparent(CHARSET_INFO *cs)
+{
+  return cs->mbminlen == 1 && !(cs->state & MY_CS_NONASCII) &&
+         (cs->mbmaxlen == 1 || (cs->state & MY_CS_UNICODE));
+}
+
+
+/*
+  Returns the length of the leading part of [str, end) that consists of
+  the ASCII characters that can appear in a string constant as they are.
+  The scan stops on the quotation mark, the backslash, control characters
+  and on any byte above 0x7F, which all are left to the caller.
+
+  Long strings are scanned 16 bytes at a time with SSE2, or 8 bytes
+  at a time in a general purpose register where SSE2 is not available.
+*/
+static size_t json_plain_ascii_length(const uchar *str, const uchar *end)
+{
+  const uchar *beg= str;
+#ifdef __SSE2__
+  const __m128i quote= _mm_set1_epi8('"');
+  const __m128i bksl= _mm_set1_epi8('\\');
+  const __m128i space= _mm_set1_epi8(' ');
+
+  for (; end - str >= 16; str+= 16)
+  {
+    __m128i v= _mm_loadu_si128((const __m128i *) str);
+    /* Bytes above 0x7F are negative, so one signed compare catches both. */
+    __m128i stop= _mm_or_si128(_mm_cmplt_epi8(v, space),
+                               _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                            _mm_cmpeq_epi8(v, bksl)));
+    if (_mm_movemask_epi8(stop))
+      break;
+  }
+#else
+  const ulonglong ones= 0x0101010101010101ULL;
+  const ulonglong highs= 0x8080808080808080ULL;
+
+  for (; end - str >= 8; str+= 8)
+  {
+    ulonglong v, q, b;
+    memcpy(&v, str, 8);
+    q= v ^ (ones * '"');
+    b= v ^ (ones * '\\');
+    /*
+      The high bit of a byte gets set in the result if the byte is
+      above 0x7F, below 0x20, or equal to zero after the XOR.
+    */
+    if ((v | (v - ones * ' ') |
+         ((q - ones) & ~q) | ((b - ones) & ~b)) & highs)
+      break;
+  }
+#endif
+  for (; str < end; str++)
+  {
+    if (*str < ' ' || *str >= 128 || *str == '"' || *str == '\\')
+      break;
+  }
+  return (size_t) (str - beg);
+}
+
+
 static int skip_str_constant(json_engine_t *j)
 {
   int t, c_len;
+  my_bool ascii_transparent= json_ascii_transparent(j->s.cs);
+
   for (;;)
   {
+    if (ascii_transparent)
+      j->s.c_str+= json_plain_ascii_length(j->s.c_str, j->s.str_end);
+
     if ((c_len= json_next_char(&j->s)) > 0)
     {
       j->s.c_str+= c_len;
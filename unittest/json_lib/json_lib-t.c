@@ -171,16 +171,58 @@ test_search()
 }
 
 
+static int scan_string_constant(CHARSET_INFO *cs, const char *text)
+{
+  json_engine_t je;
+  char js[128];
+  size_t len= my_snprintf(js, sizeof(js), "[1, \"%s\", 2]", text);
+
+  json_scan_start(&je, cs, (const uchar *) js, (const uchar *) js + len);
+  while (json_scan_next(&je) == 0) {}
+  return je.s.error;
+}
+
+
+/*
+  Test the string constants long enough to be skipped
+  in blocks rather than character by character.
+*/
+static void
+test_string_constants()
+{
+  CHARSET_INFO *utf8mb4= &my_charset_utf8mb4_general_ci;
+  const char *plain= "The quick brown fox jumps over the lazy dog again";
+
+  ok(scan_string_constant(ci, plain) == 0, "long string");
+  ok(scan_string_constant(ci, "The quick brown fox jumps over "
+                              "\\n\\\"the lazy dog\\u0041 again") == 0,
+     "long string with escapes");
+  ok(scan_string_constant(ci, "The quick brown fox jumps over "
+                              "\x01the lazy dog again") == JE_NOT_JSON_CHR,
+     "control character in a long string");
+  ok(scan_string_constant(utf8mb4, "The quick brown fox jumps over "
+                                   "\xC3\xA9\xF0\x9F\x98\x80 the dog") == 0,
+     "multibyte characters in a long string");
+  ok(scan_string_constant(utf8mb4, "The quick brown fox jumps over "
+                                   "\xFF the lazy dog again") == JE_BAD_CHR,
+     "invalid byte in a long string");
+  ok(scan_string_constant(&my_charset_latin1, "The quick brown fox jumps "
+                                              "over \xE9 the lazy dog") == 0,
+     "8-bit character in a long string");
+}
+
+
 int main()
 {
   ci= &my_charset_utf8mb3_general_ci;
 
-  plan(6);
+  plan(12);
   diag("Testing json_lib functions.");
 
   test_json_parsing();
   test_path_parsing();
   test_search();
+  test_string_constants();
 
   return exit_status();
 }
@@ -90,13 +90,61 @@ test_decimal2string()
   return 0;
 
 }
+
+/*
+  Test conversion between decimals and integers scaled by 10^scale
+*/
+static int
+test_scaled_longlong()
+{
+  static const struct
+  {
+    const char *str;
+    int scale;
+    int error;
+    longlong nr;
+  } param[]=
+  {
+    {"0",                    0, E_DEC_OK,        0},
+    {"0.00",                 2, E_DEC_OK,        0},
+    {"-1.25",                2, E_DEC_OK,        -125},
+    {"1.5",                  3, E_DEC_OK,        1500},
+    {"123456789.123456789",  9, E_DEC_OK,        123456789123456789LL},
+    {"-0.123456789012",     12, E_DEC_OK,        -123456789012LL},
+    {"0.12345678901234567", 17, E_DEC_OK,        12345678901234567LL},
+    {"1.255",                2, E_DEC_TRUNCATED, 0},
+    {"1234567890123456789",  0, E_DEC_OVERFLOW,  0},
+    {"12345678901.5",        8, E_DEC_OVERFLOW,  0}
+  };
+
+  for (uint i= 0; i < array_elements(param); i++)
+  {
+    my_decimal d, d2;
+    const char *end= param[i].str + strlen(param[i].str);
+    longlong nr= 0;
+    string2decimal(param[i].str, &d, (char **) &end);
+    int error= decimal2scaled_longlong(&d, param[i].scale, &nr);
+    ok(error == param[i].error && (error || nr == param[i].nr),
+       "decimal2scaled_longlong(%s, %d)", param[i].str, param[i].scale);
+    if (error)
+      continue;
+    /* The reverse conversion gives the same value with the given scale */
+    ok(scaled_longlong2decimal(nr, param[i].scale, &d2) == E_DEC_OK &&
+       my_decimal_cmp(&d, &d2) == 0 && d2.frac == param[i].scale,
+       "scaled_longlong2decimal(%lld, %d)", nr, param[i].scale);
+  }
+  return 0;
+}
+
+
 int main()
 {
-  plan(15);
+  plan(32);
   diag("Testing my_decimal constructor and assignment operators");
 
   test_copy_and_compare();
   test_decimal2string();
+  test_scaled_longlong();
 
   return exit_status();
 }
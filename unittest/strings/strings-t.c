@@ -450,6 +450,26 @@ static STRNNCOLL_PARAM strcoll_utf8mb4_general_ci[]=
 };
 
 
+/*
+  Long ASCII prefixes, followed by a difference (or by an equality)
+  in a case and accent insensitive UCA collation.
+*/
+static STRNNCOLL_PARAM strcoll_utf8mbx_unicode_ci[]=
+{
+  {CSTR("abcdefghijklmnop"),   CSTR("abcdefghijklmnoq"),    -1},
+  {CSTR("abcdefghijklmnopA"),  CSTR("abcdefghijklmnopb"),   -1},
+  {CSTR("abcdefghijklmnopB"),  CSTR("abcdefghijklmnopa"),    1},
+  {CSTR("abcdefghA"),          CSTR("abcdefgha"),            0},
+  {CSTR("abcdefgh"),           CSTR("abcdefgh   "),          0},
+  {CSTR("abcdefgh"),           CSTR("abcdefgh a"),          -1},
+  {CSTR("abcdefgh\xC3\xA4"),   CSTR("abcdefgha"),            0},/* a-umlaut vs a */
+  {CSTR("abcdefg\xC3\xA4"),    CSTR("abcdefgh"),            -1},/* a-umlaut vs h */
+  {CSTR("abcdefghijklmn\xC3\xA4x"), CSTR("abcdefghijklmnaz"), -1},
+  {CSTR("ABCDEFGHIJKLMNOPQRSTUVWXYZ"), CSTR("abcdefghijklmnopqrstuvwxyz"), 0},
+  {NULL, 0, NULL, 0, 0}
+};
+
+
 static STRNNCOLL_PARAM strcoll_ucs2_common[]=
 {
   {CSTR("\xC0"),     CSTR("\xC1"),        -1},    /* Incomlete MB2 vs incomplete MB2 */
@@ -680,6 +700,24 @@ strcollsp(CHARSET_INFO *cs, const STRNNCOLL_PARAM *param)
 }
 
 
+/*
+  UCA collations need to be initialized before use,
+  so find them by name rather than refer to the static definitions.
+*/
+static int
+strcollsp_by_name(const char *collation, const STRNNCOLL_PARAM *param)
+{
+  CHARSET_INFO *cs= get_charset_by_name(collation, MYF(0));
+  if (!cs)
+  {
+    diag("get_charset_by_name() failed");
+    return 1;
+  }
+  return strcollsp(cs, param);
+}
+
+
+
 static int
 test_strcollsp()
 {
@@ -779,6 +817,11 @@ test_strcollsp()
   failed+= strcollsp(&my_charset_utf8mb4_general_ci,          strcoll_utf8mb4_common);
   failed+= strcollsp(&my_charset_utf8mb4_general_ci,          strcoll_utf8mb4_general_ci);
   failed+= strcollsp(&my_charset_utf8mb4_bin,                 strcoll_utf8mb4_common);
+#endif
+#ifdef HAVE_UCA_COLLATIONS
+  failed+= strcollsp_by_name("utf8mb3_unicode_ci",     strcoll_utf8mbx_unicode_ci);
+  failed+= strcollsp_by_name("utf8mb4_unicode_ci",     strcoll_utf8mbx_unicode_ci);
+  failed+= strcollsp_by_name("utf8mb4_unicode_520_ci", strcoll_utf8mbx_unicode_ci);
 #endif
   return failed;
 }
@@ -1507,13 +1550,64 @@ test_strnncollsp_char()
 }
 
 
+static const uchar *
+bfind_naive(const uchar *str, size_t str_length,
+            const uchar *find, size_t find_length)
+{
+  size_t i;
+  for (i= 0; i + find_length <= str_length; i++)
+  {
+    if (!memcmp(str + i, find, find_length))
+      return str + i;
+  }
+  return NULL;
+}
+
+
+/*
+  Compare bfind() to a naive search for needles of various lengths
+  taken from different positions of a haystack with a small alphabet,
+  so that partial matches are frequent.
+*/
+static int
+test_bfind()
+{
+  int failed= 0;
+  uchar str[100];
+  size_t i, start, length, str_length;
+
+  for (i= 0; i < sizeof(str); i++)
+    str[i]= (uchar) ("abca"[(i * 7 + i / 5) % 4]);
+  str[sizeof(str) - 1]= 'z';
+
+  for (str_length= 0; str_length <= sizeof(str); str_length+= 9)
+  {
+    for (start= 0; start < sizeof(str); start+= 3)
+    {
+      for (length= 0; start + length <= sizeof(str) && length < 40; length++)
+      {
+        const uchar *res= bfind(str, str_length, str + start, length);
+        const uchar *exp= bfind_naive(str, str_length, str + start, length);
+        if (res != exp)
+        {
+          diag("bfind() failed: str_length=%d start=%d length=%d",
+               (int) str_length, (int) start, (int) length);
+          failed++;
+        }
+      }
+    }
+  }
+  return failed;
+}
+
+
 int main(int ac, char **av)
 {
   size_t i, failed= 0;
 
   MY_INIT(av[0]);
 
-  plan(4);
+  plan(5);
   diag("Testing my_like_range_xxx() functions");
   
   for (i= 0; i < array_elements(charset_list); i++)
@@ -1539,6 +1633,10 @@ int main(int ac, char **av)
   failed= test_strnncollsp_char();
   ok(failed == 0, "Testing cs->coll->strnncollsp_char()");
 
+  diag("Testing bfind()");
+  failed= test_bfind();
+  ok(failed == 0, "Testing bfind()");
+
   my_end(0);
 
   return exit_status();